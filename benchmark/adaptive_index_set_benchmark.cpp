@@ -0,0 +1,70 @@
+#include "benchmark.hpp"
+
+#include <enum_set/adaptive_index_set.hpp>
+#include <enum_set/index_set.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t universe = 1 << 16;
+constexpr std::size_t set_count = 256;
+constexpr std::size_t members_per_set = 16;
+
+using dense_set = enum_set::index_set<universe>;
+using adaptive_set = enum_set::adaptive_index_set<universe>;
+
+}  // namespace
+
+int main()
+{
+    const auto numbers = benchmark::random_numbers(set_count * members_per_set, universe);
+    std::vector<dense_set> dense(set_count);
+    std::vector<adaptive_set> adaptive(set_count);
+    for (std::size_t set = 0; set < set_count; ++set)
+    {
+        for (std::size_t member = 0; member < members_per_set; ++member)
+        {
+            dense[set].add(numbers[set * members_per_set + member]);
+            adaptive[set].add(numbers[set * members_per_set + member]);
+        }
+    }
+    const std::size_t operations = set_count - 1;
+
+    benchmark::measure("index_set union of sparse sets", operations, [&]
+    {
+        for (std::size_t set = 1; set < set_count; ++set)
+        {
+            dense_set result = dense[set - 1];
+            result |= dense[set];
+            benchmark::do_not_optimize(result.size());
+        }
+    });
+    benchmark::measure("adaptive_index_set union of sparse sets", operations, [&]
+    {
+        for (std::size_t set = 1; set < set_count; ++set)
+        {
+            const adaptive_set result = adaptive[set - 1] | adaptive[set];
+            benchmark::do_not_optimize(result.size());
+        }
+    });
+    benchmark::measure("index_set intersection of sparse sets", operations, [&]
+    {
+        for (std::size_t set = 1; set < set_count; ++set)
+        {
+            dense_set result = dense[set - 1];
+            result &= dense[set];
+            benchmark::do_not_optimize(result.size());
+        }
+    });
+    benchmark::measure("adaptive_index_set intersection of sparse sets", operations, [&]
+    {
+        for (std::size_t set = 1; set < set_count; ++set)
+        {
+            const adaptive_set result = adaptive[set - 1] & adaptive[set];
+            benchmark::do_not_optimize(result.size());
+        }
+    });
+}
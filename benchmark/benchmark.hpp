@@ -0,0 +1,67 @@
+#ifndef ENUM_SET_BENCHMARK_BENCHMARK_HPP
+#define ENUM_SET_BENCHMARK_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+/// Prevents the compiler from optimizing away the computation of `value`.
+template <typename Type>
+void do_not_optimize(Type const& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile Type sink;
+    sink = value;
+#endif
+}
+
+/// Returns `count` deterministic pseudo random numbers in `[0, bound)` (xorshift).
+inline std::vector<std::uint64_t> random_numbers(std::size_t count, std::uint64_t bound)
+{
+    std::vector<std::uint64_t> result(count);
+    std::uint64_t state = 0x9E3779B97F4A7C15;
+    for (auto& number : result)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        number = state % bound;
+    }
+    return result;
+}
+
+/// Runs `function` (taking no arguments) `repetitions` times and prints the best time per
+/// operation in nanoseconds, given that each run performs `operations` operations.
+/// Returns the printed time per operation.
+template <typename Function>
+double measure(std::string const& name, std::size_t operations, Function function,
+             std::size_t repetitions = 10)
+{
+    using clock = std::chrono::steady_clock;
+    double best = 0.0;
+    for (std::size_t repetition = 0; repetition < repetitions; ++repetition)
+    {
+        const auto start = clock::now();
+        function();
+        const auto stop = clock::now();
+        const double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+        best = (repetition == 0 || elapsed < best) ? elapsed : best;
+    }
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << best / static_cast<double>(operations) << " ns/op\n";
+    return best / static_cast<double>(operations);
+}
+
+}  // namespace benchmark
+
+#endif // ENUM_SET_BENCHMARK_BENCHMARK_HPP
@@ -0,0 +1,102 @@
+#include "benchmark.hpp"
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/codec.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t universe = 4096;
+constexpr std::size_t set_count = 1024;
+
+using mask_type = enum_set::bit_mask<universe>;
+
+/// Returns `set_count` sets of `members` random indices each.
+std::vector<mask_type> random_sets(std::size_t members)
+{
+    const auto numbers = benchmark::random_numbers(set_count * members, universe);
+    std::vector<mask_type> result(set_count);
+    for (std::size_t set = 0; set < set_count; ++set)
+    {
+        for (std::size_t member = 0; member < members; ++member)
+        {
+            result[set].set(numbers[set * members + member]);
+        }
+    }
+    return result;
+}
+
+/// Returns `set_count` sets of `runs` random runs of up to 64 consecutive indices each.
+std::vector<mask_type> clustered_sets(std::size_t runs)
+{
+    const auto numbers = benchmark::random_numbers(2 * set_count * runs, universe);
+    std::vector<mask_type> result(set_count);
+    for (std::size_t set = 0; set < set_count; ++set)
+    {
+        for (std::size_t run = 0; run < runs; ++run)
+        {
+            const std::size_t start = numbers[2 * (set * runs + run)];
+            const std::size_t length = 1 + numbers[2 * (set * runs + run) + 1] % 64;
+            for (std::size_t index = start; index < start + length && index < universe; ++index)
+            {
+                result[set].set(index);
+            }
+        }
+    }
+    return result;
+}
+
+/// Measures encoding and decoding `sets`, and prints the encoded bytes per set and the decoded
+/// bit mask bytes per second.
+void measure_codec(std::string const& name, std::vector<mask_type> const& sets)
+{
+    std::vector<unsigned char> buffer(set_count * enum_set::max_encoded_size<mask_type>());
+    std::size_t encoded = 0;
+    for (auto const& set : sets)
+    {
+        encoded += enum_set::encode(set, buffer.data() + encoded, buffer.size() - encoded);
+    }
+    std::cout << std::left << std::setw(48) << (name + " encoded size")
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << static_cast<double>(encoded) / set_count << " bytes/set (dense "
+              << enum_set::max_encoded_size<mask_type>() << ")\n";
+
+    benchmark::measure(name + " encode", set_count, [&]
+    {
+        std::size_t offset = 0;
+        for (auto const& set : sets)
+        {
+            offset += enum_set::encode(set, buffer.data() + offset, buffer.size() - offset);
+        }
+        benchmark::do_not_optimize(offset);
+    });
+    const double nanoseconds = benchmark::measure(name + " decode", set_count, [&]
+    {
+        std::size_t offset = 0;
+        mask_type result{};
+        while (offset < encoded)
+        {
+            offset += enum_set::decode(buffer.data() + offset, encoded - offset, result);
+            benchmark::do_not_optimize(result);
+        }
+    });
+    std::cout << std::left << std::setw(48) << (name + " decode throughput")
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << static_cast<double>(sizeof(mask_type)) / nanoseconds << " GB/s\n";
+}
+
+}  // namespace
+
+int main()
+{
+    measure_codec("sparse sets (16 ids)", random_sets(16));
+    measure_codec("medium sets (256 ids)", random_sets(256));
+    measure_codec("dense sets (4096 draws)", random_sets(4096));
+    measure_codec("clustered sets (8 runs)", clustered_sets(8));
+}
@@ -0,0 +1,82 @@
+#include "benchmark.hpp"
+
+#include <enum_set/index_set.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using index_set = enum_set::make_index_set<4096>;
+
+constexpr std::size_t set_count = 64;
+
+/// Returns `set_count` sets with `fill` pseudo random elements each.
+std::vector<index_set> random_sets(std::size_t fill)
+{
+    std::vector<index_set> result(set_count);
+    const auto numbers = benchmark::random_numbers(set_count * fill, index_set::capacity());
+    for (std::size_t index = 0; index < numbers.size(); ++index)
+    {
+        result[index / fill].add(static_cast<std::size_t>(numbers[index]));
+    }
+    return result;
+}
+
+void run(std::string const& name, std::size_t fill)
+{
+    const std::vector<index_set> sets = random_sets(fill);
+    std::size_t elements = 0;
+    for (auto const& set : sets)
+    {
+        elements += set.size();
+    }
+    std::vector<std::size_t> values(index_set::capacity());
+    std::vector<std::uint32_t> indices32(index_set::capacity());
+    std::vector<std::uint16_t> indices16(index_set::capacity());
+
+    benchmark::measure(name + " iterator", elements, [&]
+    {
+        for (auto const& set : sets)
+        {
+            std::size_t written = 0;
+            for (std::size_t element : set)
+            {
+                values[written++] = element;
+            }
+            benchmark::do_not_optimize(values.data());
+        }
+    });
+    benchmark::measure(name + " to_values", elements, [&]
+    {
+        for (auto const& set : sets)
+        {
+            benchmark::do_not_optimize(set.to_values(values.data(), values.size()));
+        }
+    });
+    benchmark::measure(name + " to_indices 32-bit", elements, [&]
+    {
+        for (auto const& set : sets)
+        {
+            benchmark::do_not_optimize(set.to_indices(indices32.data(), indices32.size()));
+        }
+    });
+    benchmark::measure(name + " to_indices 16-bit", elements, [&]
+    {
+        for (auto const& set : sets)
+        {
+            benchmark::do_not_optimize(set.to_indices(indices16.data(), indices16.size()));
+        }
+    });
+}
+
+}  // namespace
+
+int main()
+{
+    run("sparse", 64);
+    run("dense", 2048);
+}
@@ -0,0 +1,102 @@
+#include "../benchmark.hpp"
+
+#include <enum_set/magic/magic_enum_ingest.hpp>
+#include <enum_set/magic/magic_enum_names.hpp>
+#include <enum_set/magic/magic_enum_set.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+enum class permission
+{
+    READ,
+    WRITE,
+    EXEC,
+    DELETE,
+    ADMIN,
+    OWNER,
+    GROUP,
+    OTHER
+};
+
+using permission_set = enum_set::make_magic_enum_set<permission>;
+
+constexpr std::size_t row_count = 1 << 18;
+
+/// Prints the throughput of a measurement of `row_count` rows of `size` bytes in total.
+void print_throughput(std::string const& name, std::size_t size, double nanoseconds)
+{
+    std::cout << std::left << std::setw(48) << (name + " throughput")
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+              << static_cast<double>(size) / row_count / nanoseconds << " GB/s\n";
+}
+
+/// Ingests with `std::getline` per row and field, the baseline.
+std::size_t ingest_with_getline(std::string const& text, permission_set* output)
+{
+    std::istringstream stream(text);
+    std::string line;
+    std::string field;
+    std::size_t rows = 0;
+    while (std::getline(stream, line))
+    {
+        std::istringstream fields(line);
+        std::getline(fields, field, ',');
+        std::getline(fields, field, ',');
+        output[rows++] = enum_set::parse<permission_set>(field);
+    }
+    return rows;
+}
+
+}  // namespace
+
+int main()
+{
+    const auto numbers = benchmark::random_numbers(row_count, 1 << 8);
+    std::string text;
+    for (std::size_t row = 0; row < row_count; ++row)
+    {
+        permission_set set{};
+        for (std::size_t bit = 0; bit < 8; ++bit)
+        {
+            if ((numbers[row] >> bit) & 1)
+            {
+                set.add(static_cast<permission>(bit));
+            }
+        }
+        char buffer[enum_set::max_formatted_size<permission_set>()];
+        text += std::to_string(row) + ',';
+        text.append(buffer, enum_set::format_to(buffer, sizeof(buffer), set));
+        text += ",someone\n";
+    }
+    std::vector<permission_set> output(row_count);
+    const auto format = enum_set::csv_format(1);
+
+    const double getline = benchmark::measure("ingest rows with std::getline", row_count, [&]
+    {
+        benchmark::do_not_optimize(ingest_with_getline(text, output.data()));
+    });
+    const double single = benchmark::measure("ingest rows", row_count, [&]
+    {
+        benchmark::do_not_optimize(
+            enum_set::ingest(text.data(), text.size(), format, output.data(), row_count));
+    });
+    const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const double parallel = benchmark::measure("ingest rows in parallel", row_count, [&]
+    {
+        benchmark::do_not_optimize(enum_set::ingest_parallel(
+            text.data(), text.size(), format, output.data(), row_count, threads));
+    });
+    print_throughput("ingest rows with std::getline", text.size(), getline);
+    print_throughput("ingest rows", text.size(), single);
+    print_throughput("ingest rows in parallel", text.size(), parallel);
+}
@@ -0,0 +1,109 @@
+#include "../benchmark.hpp"
+
+#include <enum_set/magic/magic_enum_names.hpp>
+#include <enum_set/magic/magic_enum_set.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+enum class permission
+{
+    READ,
+    WRITE,
+    EXEC,
+    DELETE,
+    ADMIN,
+    OWNER,
+    GROUP,
+    OTHER
+};
+
+using permission_set = enum_set::make_magic_enum_set<permission>;
+
+constexpr std::size_t set_count = 1024;
+
+/// Parses with a `magic_enum::enum_cast` per name, the baseline.
+permission_set parse_with_enum_cast(std::string_view text)
+{
+    permission_set result{};
+    while (!text.empty())
+    {
+        const std::size_t end = text.find('|');
+        if (const auto value = magic_enum::enum_cast<permission>(text.substr(0, end)))
+        {
+            result.add(*value);
+        }
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+    return result;
+}
+
+/// Formats with a `magic_enum::enum_name` per element and string concatenation, the baseline.
+std::string format_with_enum_name(permission_set const& set)
+{
+    std::string result;
+    for (const permission value : set)
+    {
+        if (!result.empty())
+        {
+            result += '|';
+        }
+        result += magic_enum::enum_name(value);
+    }
+    return result;
+}
+
+}  // namespace
+
+int main()
+{
+    const auto numbers = benchmark::random_numbers(set_count, 1 << 8);
+    std::vector<permission_set> sets(set_count);
+    std::vector<std::string> texts(set_count);
+    for (std::size_t set = 0; set < set_count; ++set)
+    {
+        for (std::size_t bit = 0; bit < 8; ++bit)
+        {
+            if ((numbers[set] >> bit) & 1)
+            {
+                sets[set].add(static_cast<permission>(bit));
+            }
+        }
+        texts[set] = format_with_enum_name(sets[set]);
+    }
+
+    benchmark::measure("parse with enum_cast per name", set_count, [&]
+    {
+        for (auto const& text : texts)
+        {
+            benchmark::do_not_optimize(parse_with_enum_cast(text));
+        }
+    });
+    benchmark::measure("parse with perfect hash", set_count, [&]
+    {
+        for (auto const& text : texts)
+        {
+            benchmark::do_not_optimize(enum_set::parse<permission_set>(text));
+        }
+    });
+    benchmark::measure("format with enum_name and std::string", set_count, [&]
+    {
+        for (auto const& set : sets)
+        {
+            benchmark::do_not_optimize(format_with_enum_name(set).size());
+        }
+    });
+    benchmark::measure("format_to from name table", set_count, [&]
+    {
+        char buffer[enum_set::max_formatted_size<permission_set>()];
+        for (auto const& set : sets)
+        {
+            benchmark::do_not_optimize(enum_set::format_to(buffer, sizeof(buffer), set));
+        }
+    });
+}
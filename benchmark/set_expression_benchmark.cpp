@@ -0,0 +1,90 @@
+#include "benchmark.hpp"
+
+#include <enum_set/index_set.hpp>
+#include <enum_set/set_expression.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+
+using index_set = enum_set::make_index_set<4096>;
+
+constexpr std::size_t set_count = 64;
+
+/// Returns `set_count` sets with `fill` pseudo random elements each.
+std::vector<index_set> random_sets(std::size_t fill)
+{
+    std::vector<index_set> result(set_count);
+    const auto numbers = benchmark::random_numbers(set_count * fill, index_set::capacity());
+    for (std::size_t index = 0; index < numbers.size(); ++index)
+    {
+        result[index / fill].add(static_cast<std::size_t>(numbers[index]));
+    }
+    return result;
+}
+
+}  // namespace
+
+int main()
+{
+    const std::vector<index_set> sets = random_sets(1024);
+
+    benchmark::measure("eager (a | b) & ~c / d", set_count, [&]
+    {
+        for (std::size_t index = 0; index + 3 < set_count; ++index)
+        {
+            index_set result = (sets[index] | sets[index + 1]) & ~sets[index + 2] / sets[index + 3];
+            benchmark::do_not_optimize(result);
+        }
+    });
+    benchmark::measure("lazy (a | b) & ~c / d", set_count, [&]
+    {
+        for (std::size_t index = 0; index + 3 < set_count; ++index)
+        {
+            index_set result =
+                (enum_set::lazy(sets[index]) | sets[index + 1]) & ~enum_set::lazy(sets[index + 2])
+              / sets[index + 3];
+            benchmark::do_not_optimize(result);
+        }
+    });
+
+    benchmark::measure("eager size of a & b & c", set_count, [&]
+    {
+        std::size_t sum = 0;
+        for (std::size_t index = 0; index + 2 < set_count; ++index)
+        {
+            sum += (sets[index] & sets[index + 1] & sets[index + 2]).size();
+        }
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::measure("lazy size of a & b & c", set_count, [&]
+    {
+        std::size_t sum = 0;
+        for (std::size_t index = 0; index + 2 < set_count; ++index)
+        {
+            sum += (enum_set::lazy(sets[index]) & sets[index + 1] & sets[index + 2]).size();
+        }
+        benchmark::do_not_optimize(sum);
+    });
+
+    benchmark::measure("eager empty a & b", set_count, [&]
+    {
+        std::size_t sum = 0;
+        for (std::size_t index = 0; index + 1 < set_count; ++index)
+        {
+            sum += (sets[index] & sets[index + 1]).empty();
+        }
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::measure("lazy empty a & b", set_count, [&]
+    {
+        std::size_t sum = 0;
+        for (std::size_t index = 0; index + 1 < set_count; ++index)
+        {
+            sum += (enum_set::lazy(sets[index]) & sets[index + 1]).empty();
+        }
+        benchmark::do_not_optimize(sum);
+    });
+}
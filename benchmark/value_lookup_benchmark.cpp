@@ -0,0 +1,122 @@
+#include "benchmark.hpp"
+
+#include <enum_set/common.hpp>
+#include <enum_set/value_lookup.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr int universe_size = 256;
+constexpr std::size_t probe_count = 1 << 16;
+
+/// Consecutive values, looked up with offset arithmetic.
+struct dense
+{
+    static constexpr int map(int index) { return index; }
+};
+
+/// Every third value, looked up with a direct table.
+struct bounded
+{
+    static constexpr int map(int index) { return 3 * index; }
+};
+
+/// Squares, looked up with a perfect hash.
+struct sparse
+{
+    static constexpr int map(int index) { return index * index; }
+};
+
+/// Multiples of 2^16, gaps far larger than the number of values.
+struct wide
+{
+    static constexpr int map(int index) { return index << 16; }
+};
+
+/// Scattered over all positive integers by a multiplicative hash.
+struct scattered
+{
+    static constexpr int map(int index)
+    {
+        return static_cast<int>((static_cast<unsigned>(index) * 2654435761U) >> 1);
+    }
+};
+
+template <typename Map, typename Sequence>
+struct universe;
+
+template <typename Map, int... Indices>
+struct universe<Map, std::integer_sequence<int, Indices...>>
+{
+    using lookup = enum_set::detail::value_lookup<int, Map::map(Indices)...>;
+
+    static std::size_t linear(int value)
+    {
+        return enum_set::detail::index_of_value<int, Map::map(Indices)...>(value);
+    }
+
+    static std::size_t search(int value)
+    {
+        using strategy = enum_set::detail::value_lookup_strategy<
+            enum_set::detail::lookup_strategy::search, int, Map::map(Indices)...>;
+        return strategy::index(value);
+    }
+
+    static std::size_t lookup_index(int value)
+    {
+        return lookup::index(value);
+    }
+};
+
+template <typename Map>
+void run(std::string const& name)
+{
+    using values = universe<Map, std::make_integer_sequence<int, universe_size>>;
+    std::vector<int> probes;
+    for (auto number : benchmark::random_numbers(probe_count, universe_size))
+    {
+        probes.push_back(Map::map(static_cast<int>(number)));
+    }
+    benchmark::measure(name + " index_of_value", probe_count, [&]
+    {
+        std::size_t sum = 0;
+        for (int probe : probes)
+        {
+            sum += values::linear(probe);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::measure(name + " binary search", probe_count, [&]
+    {
+        std::size_t sum = 0;
+        for (int probe : probes)
+        {
+            sum += values::search(probe);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+    benchmark::measure(name + " value_lookup", probe_count, [&]
+    {
+        std::size_t sum = 0;
+        for (int probe : probes)
+        {
+            sum += values::lookup_index(probe);
+        }
+        benchmark::do_not_optimize(sum);
+    });
+}
+
+}  // namespace
+
+int main()
+{
+    run<dense>("dense");
+    run<bounded>("bounded");
+    run<sparse>("sparse");
+    run<wide>("wide");
+    run<scattered>("scattered");
+}
@@ -0,0 +1,71 @@
+#include "benchmark.hpp"
+
+#include <enum_set/value_set.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr int flag_count = 50;
+constexpr std::size_t message_count = 1 << 12;
+constexpr std::size_t flags_per_message = 50;
+
+enum class flag : int {};
+
+template <typename Sequence>
+struct flag_set_factory;
+
+template <int... Indices>
+struct flag_set_factory<std::integer_sequence<int, Indices...>>
+{
+    using type = enum_set::value_set<flag, static_cast<flag>(Indices)...>;
+};
+
+using flag_set = flag_set_factory<std::make_integer_sequence<int, flag_count>>::type;
+
+}  // namespace
+
+int main()
+{
+    std::vector<flag> flags;
+    for (auto number : benchmark::random_numbers(message_count * flags_per_message, flag_count))
+    {
+        flags.push_back(static_cast<flag>(number));
+    }
+    const std::size_t operations = message_count * flags_per_message;
+
+    benchmark::measure("add each value", operations, [&]
+    {
+        for (std::size_t message = 0; message < message_count; ++message)
+        {
+            flag_set result{};
+            for (std::size_t index = 0; index < flags_per_message; ++index)
+            {
+                result.add(flags[message * flags_per_message + index]);
+            }
+            benchmark::do_not_optimize(result);
+        }
+    });
+    benchmark::measure("from_range", operations, [&]
+    {
+        for (std::size_t message = 0; message < message_count; ++message)
+        {
+            const flag* first = flags.data() + message * flags_per_message;
+            auto result = flag_set::from_range(first, first + flags_per_message);
+            benchmark::do_not_optimize(result);
+        }
+    });
+    benchmark::measure("try_insert", operations, [&]
+    {
+        for (std::size_t message = 0; message < message_count; ++message)
+        {
+            const flag* first = flags.data() + message * flags_per_message;
+            flag_set result{};
+            benchmark::do_not_optimize(result.try_insert(first, first + flags_per_message));
+            benchmark::do_not_optimize(result);
+        }
+    });
+}
@@ -0,0 +1,690 @@
+#ifndef ENUM_SET_ADAPTIVE_INDEX_SET_HPP
+#define ENUM_SET_ADAPTIVE_INDEX_SET_HPP
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Type factory for the smallest unsigned integer type holding the indices `[0, Size)`.
+template <size_t Size>
+using sparse_index_type =
+    std::conditional_t<(Size <= 0x100ULL), uint8_t,
+    std::conditional_t<(Size <= 0x10000ULL), uint16_t,
+    std::conditional_t<(Size <= 0x100000000ULL), uint32_t, uint64_t>>>;
+
+/// Number of elements at which a sorted array of `sparse_index_type` takes as much memory as a
+/// bit mask of `Size` bits, the default threshold of `adaptive_index_set`.
+template <size_t Size>
+constexpr size_t sparse_threshold() noexcept
+{
+    return (Size / (8 * sizeof(sparse_index_type<Size>)) > 0)
+        ? Size / (8 * sizeof(sparse_index_type<Size>))
+        : 1;
+}
+
+/// Finds the first element not less than `value` in the sorted range `[first, last)`.
+/// Probes positions 1, 2, 4, 8, ... before a binary search, so finding an element `k` positions
+/// ahead takes `O(log k)` comparisons. Used to intersect sorted ranges of very different lengths.
+template <typename Index>
+Index const* gallop(Index const* first, Index const* last, size_t value) noexcept
+{
+    const size_t length = static_cast<size_t>(last - first);
+    size_t bound = 1;
+    while (bound < length && first[bound] < value)
+    {
+        bound *= 2;
+    }
+    return std::lower_bound(
+        first + bound / 2, first + std::min(bound + 1, length), value,
+        [](Index element, size_t key) { return element < key; });
+}
+
+}  // namespace detail
+
+/// Represents a set of indices from the universe `[0, Size)` that adapts its representation to
+/// its number of elements, for large universes that are mostly nearly empty.
+/// Up to `Threshold` elements are stored as a sorted array of the smallest unsigned integers
+/// holding the indices, above that as a heap allocated `bit_mask`. The default threshold is the
+/// number of elements at which both take the same memory (e.g. 4096 elements out of 65536).
+/// Set operations pick a kernel by representation: merging (or galloping, if one operand is much
+/// smaller) for two sorted arrays, probing the bit mask for mixed operands, and whole words for
+/// two bit masks. Results are converted to the representation matching their size. Removing
+/// single elements converts a bit mask back to an array only below half the threshold, so that
+/// alternating additions and removals at the threshold do not convert back and forth.
+/// Unlike the other sets, an adaptive index set allocates memory, so it is not `constexpr`.
+/// Iteration and membership follows `index_set`. Providing an invalid index to a runtime method
+/// is handled according to `ENUM_SET_BOUNDS_CHECK`, which by default throws an
+/// `std::out_of_range` exception.
+template <size_t Size, size_t Threshold = detail::sparse_threshold<Size>()>
+class adaptive_index_set
+{
+    static_assert(Size > 0, "adaptive index set size must be strictly positive");
+    static_assert(Threshold > 0, "adaptive index set threshold must be strictly positive");
+public:
+    /// Integer type of the elements of the sorted array representation.
+    using index_type = detail::sparse_index_type<Size>;
+
+    /// Forward declaration of an iterator class.
+    /// See `adaptive_index_set_iterator.hpp` for details.
+    class iterator;
+
+    /// Iterator visiting the elements in reverse order.
+    using reverse_iterator = std::reverse_iterator<iterator>;
+private:
+    using mask_type = bit_mask<Size>;
+
+    /// Ratio of operand sizes above which sorted arrays are galloped over instead of merged.
+    static constexpr size_t gallop_ratio{32};
+
+    /// Sorted elements, used if there is no bit mask.
+    std::vector<index_type> elements;
+
+    /// Bit mask of the elements, or null if the elements are stored in the sorted array.
+    std::unique_ptr<mask_type> bits;
+
+    /// Number of elements of the bit mask, kept to avoid counting on every update.
+    size_t bit_count;
+
+    /// Converts the sorted array representation to a bit mask.
+    void make_dense()
+    {
+        auto mask = std::make_unique<mask_type>();
+        for (const index_type element : elements)
+        {
+            mask->set(element);
+        }
+        bit_count = elements.size();
+        bits = std::move(mask);
+        elements = std::vector<index_type>{};
+    }
+
+    /// Converts the bit mask representation to a sorted array.
+    void make_sparse()
+    {
+        std::vector<index_type> result(bit_count);
+        bits->to_indices(result.data(), result.size());
+        elements = std::move(result);
+        bits.reset();
+        bit_count = 0;
+    }
+
+    /// Converts to the representation matching the current number of elements.
+    void normalize()
+    {
+        if (bits == nullptr && elements.size() > Threshold)
+        {
+            make_dense();
+        }
+        else if (bits != nullptr && bit_count <= Threshold)
+        {
+            make_sparse();
+        }
+    }
+
+    /// Constructs an adaptive index set from a sorted array of elements.
+    static adaptive_index_set from_sparse(std::vector<index_type>&& sorted)
+    {
+        adaptive_index_set result{};
+        result.elements = std::move(sorted);
+        result.normalize();
+        return result;
+    }
+
+    /// Constructs an adaptive index set from a bit mask.
+    static adaptive_index_set from_dense(std::unique_ptr<mask_type>&& mask)
+    {
+        adaptive_index_set result{};
+        result.bit_count = mask->count();
+        result.bits = std::move(mask);
+        result.normalize();
+        return result;
+    }
+
+    /// Returns a copy of the bit mask of a dense adaptive index set.
+    static std::unique_ptr<mask_type> copy_bits(adaptive_index_set const& set)
+    {
+        return std::make_unique<mask_type>(*set.bits);
+    }
+
+    /// Returns the elements of a sparse adaptive index set that are (if `Keep` is `true`) or are
+    /// not (if `Keep` is `false`) contained in a dense adaptive index set.
+    template <bool Keep>
+    static std::vector<index_type>
+    filter(adaptive_index_set const& sparse, adaptive_index_set const& dense)
+    {
+        std::vector<index_type> result;
+        result.reserve(sparse.elements.size());
+        for (const index_type element : sparse.elements)
+        {
+            if (dense.bits->get(element) == Keep)
+            {
+                result.push_back(element);
+            }
+        }
+        return result;
+    }
+
+    /// Returns the elements of a sorted array that are (if `Keep` is `true`) or are not (if
+    /// `Keep` is `false`) contained in a much larger sorted array, galloping over the latter.
+    template <bool Keep>
+    static std::vector<index_type>
+    gallop(std::vector<index_type> const& small, std::vector<index_type> const& large)
+    {
+        std::vector<index_type> result;
+        result.reserve(small.size());
+        index_type const* position = large.data();
+        index_type const* const last = large.data() + large.size();
+        for (const index_type element : small)
+        {
+            position = detail::gallop(position, last, element);
+            if ((position != last && *position == element) == Keep)
+            {
+                result.push_back(element);
+            }
+        }
+        return result;
+    }
+
+    /// Toggles (if `Flip` is `true`) or sets (if `Flip` is `false`) the bits of the elements of a
+    /// sorted array in a bit mask, and returns the number of elements of the bit mask.
+    template <bool Flip>
+    static size_t apply(mask_type& mask, size_t count, std::vector<index_type> const& sorted)
+    {
+        for (const index_type element : sorted)
+        {
+            if (!mask.get(element))
+            {
+                mask.set(element);
+                count += 1;
+            }
+            else if (Flip)
+            {
+                mask.clear(element);
+                count -= 1;
+            }
+        }
+        return count;
+    }
+public:
+    // The usual suspects.
+    adaptive_index_set(adaptive_index_set&&) noexcept            = default;
+    adaptive_index_set& operator=(adaptive_index_set&&) noexcept = default;
+    ~adaptive_index_set() noexcept                               = default;
+
+    /// Copies an adaptive index set, including its bit mask.
+    adaptive_index_set(adaptive_index_set const& another)
+        : elements{another.elements}
+        , bits{another.bits != nullptr ? copy_bits(another) : nullptr}
+        , bit_count{another.bit_count}
+    {
+    }
+
+    /// Copies an adaptive index set, including its bit mask.
+    adaptive_index_set& operator=(adaptive_index_set const& another)
+    {
+        adaptive_index_set copy{another};
+        return *this = std::move(copy);
+    }
+
+    /// Constructs an empty adaptive index set.
+    adaptive_index_set() noexcept
+        : elements{}
+        , bits{}
+        , bit_count{0}
+    {
+    }
+
+    /// Constructs an adaptive index set from a list of indices.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    adaptive_index_set(std::initializer_list<size_t> indices)
+        : adaptive_index_set()
+    {
+        for (const size_t index : indices)
+        {
+            add(index);
+        }
+    }
+
+    /// Returns an iterator to the first element in the adaptive index set.
+    /// The iterator refers to the adaptive index set, see `adaptive_index_set::iterator`.
+    iterator begin() const noexcept
+    {
+        return iterator(*this, 0);
+    }
+
+    /// Returns a sentinel iterator representing the end of this adaptive index set.
+    /// See `begin()` for details.
+    iterator end() const noexcept
+    {
+        return iterator(*this, Size);
+    }
+
+    /// Returns a reverse iterator to the last element in the adaptive index set.
+    /// See `begin()` for details.
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /// Returns a sentinel reverse iterator representing the end of the reversed set.
+    /// See `begin()` for details.
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /// Returns the lowest element in the adaptive index set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t front() const
+    {
+        detail::check_bounds(!empty(), "adaptive_index_set front of empty set");
+        return (bits != nullptr) ? bits->find_first() : elements.front();
+    }
+
+    /// Returns the highest element in the adaptive index set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t back() const
+    {
+        detail::check_bounds(!empty(), "adaptive_index_set back of empty set");
+        return (bits != nullptr) ? bits->find_last() : elements.back();
+    }
+
+    /// Checks if the adaptive index set contains an index known at runtime.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid indices).
+    /// Takes constant time for a bit mask, logarithmic time for a sorted array.
+    bool has(size_t index) const noexcept
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        return (bits != nullptr)
+            ? bits->get(index)
+            : std::binary_search(elements.begin(), elements.end(), index_type(index));
+    }
+
+    /// Adds an index known at runtime to the adaptive index set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void add(size_t index) &
+    {
+        detail::check_bounds(index < Size, "adaptive_index_set add index out of range");
+        try_add(index);
+    }
+
+    /// Removes an index known at runtime from the adaptive index set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void remove(size_t index) &
+    {
+        detail::check_bounds(index < Size, "adaptive_index_set remove index out of range");
+        try_remove(index);
+    }
+
+    /// Adds an index known at runtime, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    bool try_add(size_t index) &
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        if (bits != nullptr)
+        {
+            bit_count += bits->get(index) ? 0 : 1;
+            bits->set(index);
+            return true;
+        }
+        const auto position =
+            std::lower_bound(elements.begin(), elements.end(), index_type(index));
+        if (position == elements.end() || *position != index)
+        {
+            elements.insert(position, index_type(index));
+            normalize();
+        }
+        return true;
+    }
+
+    /// Removes an index known at runtime, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    bool try_remove(size_t index) &
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        if (bits != nullptr)
+        {
+            bit_count -= bits->get(index) ? 1 : 0;
+            bits->clear(index);
+            if (bit_count <= Threshold / 2)
+            {
+                make_sparse();
+            }
+            return true;
+        }
+        const auto position =
+            std::lower_bound(elements.begin(), elements.end(), index_type(index));
+        if (position != elements.end() && *position == index)
+        {
+            elements.erase(position);
+        }
+        return true;
+    }
+
+    /// Writes the elements in increasing order to `output`, at most `capacity` of them, and
+    /// returns the number of elements written. See `bit_mask::to_indices` for details.
+    template <typename Index>
+    size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        if (bits != nullptr)
+        {
+            return bits->to_indices(output, capacity);
+        }
+        const size_t count = std::min(capacity, elements.size());
+        std::copy(elements.begin(), elements.begin() + count, output);
+        return count;
+    }
+
+    /// Returns the total number of possible elements the adaptive index set can hold.
+    static constexpr size_t capacity() noexcept
+    {
+        return Size;
+    }
+
+    /// Returns the number of elements at which the elements are stored in a bit mask.
+    static constexpr size_t threshold() noexcept
+    {
+        return Threshold;
+    }
+
+    /// Returns `true` if the elements are stored in a sorted array, `false` for a bit mask.
+    bool is_sparse() const noexcept
+    {
+        return bits == nullptr;
+    }
+
+    /// Returns the number of elements currently being hold by the adaptive index set.
+    size_t size() const noexcept
+    {
+        return (bits != nullptr) ? bit_count : elements.size();
+    }
+
+    /// Works like `size()`, but returns a signed integer instead.
+    ptrdiff_t count() const noexcept
+    {
+        return static_cast<ptrdiff_t>(size());
+    }
+
+    /// Checks if the adaptive index set is empty.
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /// Erases all elements from the adaptive index set, releasing its memory.
+    void clear() noexcept
+    {
+        elements = std::vector<index_type>{};
+        bits.reset();
+        bit_count = 0;
+    }
+
+    /// Checks for equality between two adaptive index sets, regardless of their representations.
+    friend bool
+    operator== (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        if (first.size() != second.size())
+        {
+            return false;
+        }
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            return *first.bits == *second.bits;
+        }
+        if (first.bits == nullptr && second.bits == nullptr)
+        {
+            return first.elements == second.elements;
+        }
+        return first.bits == nullptr ? (first <= second) : (second <= first);
+    }
+
+    /// Checks for inequality between two adaptive index sets.
+    friend bool
+    operator!= (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+    /// Checks if an adaptive index set is a subset of another.
+    friend bool
+    operator<= (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        if (first.size() > second.size())
+        {
+            return false;
+        }
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            return first.bits->is_subset_of(*second.bits);
+        }
+        if (first.bits == nullptr && second.bits == nullptr)
+        {
+            return std::includes(
+                second.elements.begin(), second.elements.end(),
+                first.elements.begin(), first.elements.end());
+        }
+        return std::all_of(
+            first.begin(), first.end(), [&second](size_t index) { return second.has(index); });
+    }
+
+    /// Checks if an adaptive index set is a superset of another.
+    friend bool
+    operator>= (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        return second <= first;
+    }
+
+    /// Checks if an adaptive index set is a strict subset of another.
+    friend bool
+    operator< (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        return (first.size() < second.size()) && (first <= second);
+    }
+
+    /// Checks if an adaptive index set is a strict superset of another.
+    friend bool
+    operator> (adaptive_index_set const& first, adaptive_index_set const& second) noexcept
+    {
+        return second < first;
+    }
+
+    /// Returns the set union of two adaptive index sets.
+    friend adaptive_index_set
+    operator| (adaptive_index_set const& first, adaptive_index_set const& second)
+    {
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            auto mask = copy_bits(first);
+            *mask |= *second.bits;
+            return from_dense(std::move(mask));
+        }
+        if (first.bits != nullptr || second.bits != nullptr)
+        {
+            adaptive_index_set const& dense = (first.bits != nullptr) ? first : second;
+            adaptive_index_set const& sparse = (first.bits != nullptr) ? second : first;
+            adaptive_index_set result{};
+            result.bits = copy_bits(dense);
+            result.bit_count = apply<false>(*result.bits, dense.bit_count, sparse.elements);
+            return result;
+        }
+        std::vector<index_type> result;
+        result.reserve(first.elements.size() + second.elements.size());
+        std::set_union(
+            first.elements.begin(), first.elements.end(),
+            second.elements.begin(), second.elements.end(),
+            std::back_inserter(result));
+        return from_sparse(std::move(result));
+    }
+
+    /// Returns the set intersection of two adaptive index sets.
+    friend adaptive_index_set
+    operator& (adaptive_index_set const& first, adaptive_index_set const& second)
+    {
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            auto mask = copy_bits(first);
+            *mask &= *second.bits;
+            return from_dense(std::move(mask));
+        }
+        if (first.bits != nullptr)
+        {
+            return from_sparse(filter<true>(second, first));
+        }
+        if (second.bits != nullptr)
+        {
+            return from_sparse(filter<true>(first, second));
+        }
+        auto const& small =
+            (first.elements.size() <= second.elements.size()) ? first.elements : second.elements;
+        auto const& large =
+            (first.elements.size() <= second.elements.size()) ? second.elements : first.elements;
+        if (large.size() >= gallop_ratio * small.size())
+        {
+            return from_sparse(gallop<true>(small, large));
+        }
+        std::vector<index_type> result;
+        result.reserve(small.size());
+        std::set_intersection(
+            small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(result));
+        return from_sparse(std::move(result));
+    }
+
+    /// Returns the set difference between two adaptive index sets.
+    friend adaptive_index_set
+    operator/ (adaptive_index_set const& first, adaptive_index_set const& second)
+    {
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            auto mask = copy_bits(first);
+            *mask /= *second.bits;
+            return from_dense(std::move(mask));
+        }
+        if (first.bits != nullptr)
+        {
+            auto mask = copy_bits(first);
+            for (const index_type element : second.elements)
+            {
+                mask->clear(element);
+            }
+            return from_dense(std::move(mask));
+        }
+        if (second.bits != nullptr)
+        {
+            return from_sparse(filter<false>(first, second));
+        }
+        if (second.elements.size() >= gallop_ratio * first.elements.size())
+        {
+            return from_sparse(gallop<false>(first.elements, second.elements));
+        }
+        std::vector<index_type> result;
+        result.reserve(first.elements.size());
+        std::set_difference(
+            first.elements.begin(), first.elements.end(),
+            second.elements.begin(), second.elements.end(),
+            std::back_inserter(result));
+        return from_sparse(std::move(result));
+    }
+
+    /// Returns the symmetric set difference between two adaptive index sets.
+    friend adaptive_index_set
+    operator^ (adaptive_index_set const& first, adaptive_index_set const& second)
+    {
+        if (first.bits != nullptr && second.bits != nullptr)
+        {
+            auto mask = copy_bits(first);
+            *mask ^= *second.bits;
+            return from_dense(std::move(mask));
+        }
+        if (first.bits != nullptr || second.bits != nullptr)
+        {
+            adaptive_index_set const& dense = (first.bits != nullptr) ? first : second;
+            adaptive_index_set const& sparse = (first.bits != nullptr) ? second : first;
+            adaptive_index_set result{};
+            result.bits = copy_bits(dense);
+            result.bit_count = apply<true>(*result.bits, dense.bit_count, sparse.elements);
+            result.normalize();
+            return result;
+        }
+        std::vector<index_type> result;
+        result.reserve(first.elements.size() + second.elements.size());
+        std::set_symmetric_difference(
+            first.elements.begin(), first.elements.end(),
+            second.elements.begin(), second.elements.end(),
+            std::back_inserter(result));
+        return from_sparse(std::move(result));
+    }
+
+    /// Adds all elements of another adaptive index set to this.
+    adaptive_index_set& operator|= (adaptive_index_set const& another) &
+    {
+        if (bits != nullptr)
+        {
+            if (another.bits != nullptr)
+            {
+                *bits |= *another.bits;
+                bit_count = bits->count();
+            }
+            else
+            {
+                bit_count = apply<false>(*bits, bit_count, another.elements);
+            }
+            return *this;
+        }
+        return *this = (*this | another);
+    }
+
+    /// Restricts the elements of this adaptive index set to those contained in another.
+    adaptive_index_set& operator&= (adaptive_index_set const& another) &
+    {
+        return *this = (*this & another);
+    }
+
+    /// Removes all elements in this adaptive index set that are contained in another.
+    adaptive_index_set& operator/= (adaptive_index_set const& another) &
+    {
+        return *this = (*this / another);
+    }
+
+    /// Keeps the elements contained in exactly one of this and another adaptive index set.
+    adaptive_index_set& operator^= (adaptive_index_set const& another) &
+    {
+        return *this = (*this ^ another);
+    }
+
+}; // class adaptive_index_set
+
+template <size_t Size, size_t Threshold>
+constexpr size_t adaptive_index_set<Size, Threshold>::gallop_ratio;
+
+}  // namespace enum_set
+
+#include <enum_set/adaptive_index_set_iterator.hpp>
+
+#endif // ENUM_SET_ADAPTIVE_INDEX_SET_HPP
@@ -0,0 +1,160 @@
+#ifndef ENUM_SET_ADAPTIVE_INDEX_SET_ITERATOR_HPP
+#define ENUM_SET_ADAPTIVE_INDEX_SET_ITERATOR_HPP
+
+#include <enum_set/adaptive_index_set.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace enum_set
+{
+
+/// Represents a read only bidirectional iterator to the elements of an adaptive index set.
+/// Like `index_set::iterator`, the iterator refers to the adaptive index set it was created from,
+/// so it is invalidated when the set is destroyed or modified.
+/// Walks the sorted array, or skips empty words of the bit mask, depending on the representation.
+template <size_t Size, size_t Threshold>
+class adaptive_index_set<Size, Threshold>::iterator
+{
+private:
+    /// Adaptive index set being iterated over.
+    adaptive_index_set const* container;
+
+    /// Current element, or the capacity of the set for the end iterator.
+    size_t index;
+
+    /// Position of the current element in the sorted array representation.
+    size_t position;
+
+    /// Moves to the element at `offset` in the sorted array representation, or to the end.
+    void move_to(size_t offset) noexcept
+    {
+        position = offset;
+        index = (position < container->elements.size()) ? container->elements[position] : Size;
+    }
+public:
+    // Adapt to STL iterator interface.
+    // Elements are returned by value, hence there is no pointer type.
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using value_type        = size_t;
+    using pointer           = void;
+    using reference         = size_t;
+
+    // The usual suspects.
+    iterator(iterator const&) noexcept            = default;
+    iterator(iterator&&) noexcept                 = default;
+    iterator& operator=(iterator const&) noexcept = default;
+    iterator& operator=(iterator&&) noexcept      = default;
+    ~iterator() noexcept                          = default;
+
+    /// Constructs an adaptive index set iterator pointing to the first element greater or equal
+    /// to an offset, or the end of sequence sentinel iterator if there is no such element.
+    iterator(adaptive_index_set const& set, size_t offset) noexcept
+        : container{&set}
+        , index{Size}
+        , position{0}
+    {
+        if (container->bits != nullptr)
+        {
+            index = container->bits->find_next(offset);
+        }
+        else
+        {
+            move_to(static_cast<size_t>(
+                std::lower_bound(
+                    container->elements.begin(), container->elements.end(), offset,
+                    [](index_type element, size_t key) { return element < key; })
+              - container->elements.begin()));
+        }
+    }
+
+    /// Returns the element pointed to by this iterator.
+    /// Dereferencing the end iterator is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t operator*() const
+    {
+        detail::check_bounds(index < Size, "adaptive_index_set iterator dereference out of range");
+        return index;
+    }
+
+    /// Increments this iterator.
+    /// If there are no more elements left in the iteratee, the iterator becomes equal to end.
+    /// Incrementing end has no effects.
+    /// Returns a reference to this iterator.
+    iterator& operator++() noexcept
+    {
+        if (index < Size)
+        {
+            if (container->bits != nullptr)
+            {
+                index = container->bits->find_next(index + 1);
+            }
+            else
+            {
+                move_to(position + 1);
+            }
+        }
+        return *this;
+    }
+
+    /// Increments this iterator, see `operator++()` for details.
+    /// Returns a copy of this iterator from before the increment.
+    iterator operator++(int) noexcept
+    {
+        iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    /// Decrements this iterator.
+    /// Decrementing end makes the iterator point to the last element, if any.
+    /// Decrementing an iterator pointing to the first element has no effects.
+    /// Returns a reference to this iterator.
+    iterator& operator--() noexcept
+    {
+        if (container->bits != nullptr)
+        {
+            const size_t previous = container->bits->find_prev(index);
+            index = (previous < Size) ? previous : index;
+        }
+        else if (position > 0)
+        {
+            move_to(position - 1);
+        }
+        return *this;
+    }
+
+    /// Decrements this iterator, see `operator--()` for details.
+    /// Returns a copy of this iterator from before the decrement.
+    iterator operator--(int) noexcept
+    {
+        iterator next = *this;
+        --(*this);
+        return next;
+    }
+
+    /// Checks for equality between two iterators.
+    /// Returns `true` if both points to the same element, otherwise `false`.
+    /// Comparing iterators from different sets is only meaningful against `end()`.
+    friend bool
+    operator==(iterator const& first, iterator const& second) noexcept
+    {
+        return first.index == second.index;
+    }
+
+    /// Checks if two iterators are different.
+    /// See `operator==` for details.
+    friend bool
+    operator!=(iterator const& first, iterator const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+}; // class adaptive_index_set::iterator
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_ADAPTIVE_INDEX_SET_ITERATOR_HPP
@@ -1,8 +1,11 @@
 #ifndef ENUM_SET_BIT_MASK_HPP
 #define ENUM_SET_BIT_MASK_HPP
 
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
 #include <enum_set/common.hpp>
 #include <enum_set/standard_types.hpp>
+#include <enum_set/word_kernels.hpp>
 
 #include <type_traits>
 #include <utility>
@@ -32,176 +35,183 @@ struct array
     }
 };
 
-/// Declaration of the underlying storage of bytes as an array of `ByteCount` 8-bit integers.
-template <size_t ByteCount>
-using byte_storage = array<uint8_t, ByteCount>;
-
-/// Implmentation helper for `operator==` below.
-template <size_t ByteCount, size_t... Indices>
-constexpr bool
-equals_impl(byte_storage<ByteCount> const& lhs,
-            byte_storage<ByteCount> const& rhs,
-            std::index_sequence<Indices...>) noexcept
-{
-    static_assert(all((Indices < ByteCount)...), "Byte storage out of bounds access");
-    return all((lhs[Indices] == rhs[Indices])...);
-}
-
-/// Constexpr equality operator for byte_storages (not necessary in C++20).
-template <size_t ByteCount>
-constexpr bool
-operator==(byte_storage<ByteCount> const& lhs,
-           byte_storage<ByteCount> const& rhs) noexcept
-{
-    return equals_impl(lhs, rhs, std::make_index_sequence<ByteCount>());
-}
-
-/// Type factory for building the storage type holding `BitCount` bits.
+/// Type factory for the unsigned integer type used as a storage word for `BitCount` bits.
+/// If all bits fit into a single word, the smallest exact width integer is used,
+/// otherwise the bits are spread over several native 64-bit words.
 template <size_t BitCount>
-struct bit_storage_factory
+struct word_factory
 {
     static_assert(BitCount > 0, "Number of bits must be a strictly positive number");
-    using type = byte_storage<1 + (BitCount - 1)/8>;
+    using type =
+        std::conditional_t<(BitCount <=  8), uint8_t,
+        std::conditional_t<(BitCount <= 16), uint16_t,
+        std::conditional_t<(BitCount <= 32), uint32_t,
+                                             uint64_t>>>;
 };
 
-/// Declaration of the underlying storage of `BitCount` bits.
-/// The actual number of bytes are calculcated from the number of bits.
+/// Declaration of the storage word type for `BitCount` bits.
 template <size_t BitCount>
-using bit_storage = typename bit_storage_factory<BitCount>::type;
+using word_type = typename word_factory<BitCount>::type;
 
-/// Creates a byte with bits set according to the arguments `b0, b1, ..., b7`.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7) noexcept
+/// Type trait for the number of bits in a storage `Word`.
+template <typename Word>
+struct word_size
 {
-    return (b0 ? (1 << 0) : 0)
-         | (b1 ? (1 << 1) : 0)
-         | (b2 ? (1 << 2) : 0)
-         | (b3 ? (1 << 3) : 0)
-         | (b4 ? (1 << 4) : 0)
-         | (b5 ? (1 << 5) : 0)
-         | (b6 ? (1 << 6) : 0)
-         | (b7 ? (1 << 7) : 0);
-}
+    static_assert(std::is_unsigned<Word>::value, "Storage words must be unsigned integers");
+    static constexpr size_t value{8 * sizeof(Word)};
+};
 
-/// Overload of `make_byte` for 7 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6) noexcept
+/// Type factory for the underlying storage of `WordCount` words.
+/// A single word is stored as a plain unsigned integer, so that small bit masks are passed in
+/// registers and compile to plain integer operations, several words are stored in an array.
+template <typename Word, size_t WordCount>
+struct word_storage_factory
 {
-    return make_byte(b0, b1, b2, b3, b4, b5, b6, false);
-}
+    using type = array<Word, WordCount>;
+};
 
-/// Overload of `make_byte` for 6 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5) noexcept
+/// Specialization of `word_storage_factory` for a single word.
+template <typename Word>
+struct word_storage_factory<Word, 1>
 {
-    return make_byte(b0, b1, b2, b3, b4, b5, false, false);
-}
+    using type = Word;
+};
 
-/// Overload of `make_byte` for 5 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2, bool b3, bool b4) noexcept
-{
-    return make_byte(b0, b1, b2, b3, b4, false, false, false);
-}
+/// Declaration of the underlying storage of `WordCount` words.
+template <typename Word, size_t WordCount>
+using word_storage = typename word_storage_factory<Word, WordCount>::type;
 
-/// Overload of `make_byte` for 4 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2, bool b3) noexcept
+/// Returns a pointer to the first word of a word storage holding several words.
+template <typename Word, size_t WordCount>
+constexpr Word* word_data(array<Word, WordCount>& storage) noexcept
 {
-    return make_byte(b0, b1, b2, b3, false, false, false, false);
+    return storage.values;
 }
 
-/// Overload of `make_byte` for 3 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1, bool b2) noexcept
+/// Returns a pointer to the first word of a word storage holding several words.
+template <typename Word, size_t WordCount>
+constexpr Word const* word_data(array<Word, WordCount> const& storage) noexcept
 {
-    return make_byte(b0, b1, b2, false, false, false, false, false);
+    return storage.values;
 }
 
-/// Overload of `make_byte` for 2 bits.
-constexpr uint8_t
-make_byte(bool b0, bool b1) noexcept
+/// Returns a pointer to the word of a word storage holding a single word.
+template <typename Word, typename = std::enable_if_t<std::is_unsigned<Word>::value>>
+constexpr Word* word_data(Word& storage) noexcept
 {
-    return make_byte(b0, b1, false, false, false, false, false, false);
+    return &storage;
 }
 
-/// Overload of `make_byte` for 1 bit.
-constexpr uint8_t
-make_byte(bool b0) noexcept
+/// Returns a pointer to the word of a word storage holding a single word.
+template <typename Word, typename = std::enable_if_t<std::is_unsigned<Word>::value>>
+constexpr Word const* word_data(Word const& storage) noexcept
 {
-    return make_byte(b0, false, false, false, false, false, false, false);
+    return &storage;
 }
 
-/// Factory for constructing a byte at a byte index and booleans specifying which bits to set.
-/// Walks through consecutive chunks of 8 bits until the chunk at the byte index is found.
-/// Once the chunk is found, the appropriate bits will be set and the byte is returned.
-template <size_t ByteIndex>
-struct byte_factory
+/// Constexpr equality operator for word storages of several words (not necessary in C++20).
+template <typename Word, size_t WordCount>
+constexpr bool
+operator==(array<Word, WordCount> const& lhs,
+           array<Word, WordCount> const& rhs) noexcept
 {
-    template <typename... Bools>
-    static constexpr uint8_t
-    make(bool, bool, bool, bool, bool, bool, bool, bool, Bools... bits) noexcept
+    for (size_t index = 0; index < WordCount; ++index)
     {
-        return byte_factory<ByteIndex - 1>::make(bits...);
+        if (lhs[index] != rhs[index])
+        {
+            return false;
+        }
     }
-};
+    return true;
+}
 
-/// Specialization of `byte_factory` for byte index 0 (that is, the chunk of bits has been found).
-template <>
-struct byte_factory<0>
+/// Type factory for building the storage type holding `BitCount` bits.
+template <size_t BitCount>
+struct bit_storage_factory
 {
-    /// Base case when there are atleast 8 bits left.
-    /// Construct a byte from the first 8 bits and discard the rest.
-    template <typename... Bools>
-    static constexpr uint8_t
-    make(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7, Bools...) noexcept
-    {
-        return make_byte(b0, b1, b2, b3, b4, b5, b6, b7);
-    }
-
-    /// Base case when there are less than 8 bits left.
-    /// Construct a byte from the available bits and leave the rest unset.
-    static constexpr uint8_t
-    make(bool b0 = false,
-         bool b1 = false,
-         bool b2 = false,
-         bool b3 = false,
-         bool b4 = false,
-         bool b5 = false,
-         bool b6 = false) noexcept
-    {
-        return make_byte(b0, b1, b2, b3, b4, b5, b6, false);
-    }
+    using word = word_type<BitCount>;
+    static constexpr size_t word_count{1 + (BitCount - 1)/word_size<word>::value};
+    using type = word_storage<word, word_count>;
 };
 
-/// Creates a byte storage from a set of booleans specifying which bits to set.
-/// The number of `Bools...` must not require more bytes than there are available `ByteIndices...`.
-/// See `byte_factory::make` for details on how each byte is set.
-template <size_t... ByteIndices, typename... Bools>
-constexpr byte_storage<sizeof...(ByteIndices)>
-make_bytes(std::index_sequence<ByteIndices...>, Bools... bits) noexcept
-{
-    return {byte_factory<ByteIndices>::make(bits...)...};
-}
+/// Declaration of the underlying storage of `BitCount` bits.
+/// The actual number of words are calculcated from the number of bits.
+template <size_t BitCount>
+using bit_storage = typename bit_storage_factory<BitCount>::type;
 
 /// Creates a bit storage from a set of booleans specifying which bits to be set.
+/// Bit `i` of the storage ends up at bit `i % W` of word `i / W`, where `W` is the word size.
 template <typename... Bools>
 constexpr bit_storage<sizeof...(Bools)>
 make_bit_storage(Bools... bits) noexcept
 {
-    constexpr size_t byte_count = 1 + (sizeof...(Bools) - 1)/8;
-    constexpr auto indices = std::make_index_sequence<byte_count>();
-    return make_bytes(indices, bits...);
+    using word = word_type<sizeof...(Bools)>;
+    constexpr size_t bits_per_word = word_size<word>::value;
+    const bool values[] = {bits...};
+    bit_storage<sizeof...(Bools)> storage{};
+    for (size_t index = 0; index < sizeof...(Bools); ++index)
+    {
+        if (values[index])
+        {
+            word_data(storage)[index / bits_per_word] |=
+                static_cast<word>(word{1} << (index % bits_per_word));
+        }
+    }
+    return storage;
 }
 
 }  // namespace detail
 
 /// Representation of a contiguous array of `Size` bits.
+/// The bits are stored in words of type `word_type`, where bit `i` of the mask is bit
+/// `i % word_size` of word `i / word_size`. Bits beyond `Size` in the last word are always zero.
 template <size_t Size>
 class bit_mask final
 {
+public:
+    /// Unsigned integer type of the words holding the bits.
+    using word_type = detail::word_type<Size>;
+
+    /// Number of bits per storage word.
+    static constexpr size_t word_size = detail::word_size<word_type>::value;
+
+    /// Number of storage words.
+    static constexpr size_t word_count = detail::bit_storage_factory<Size>::word_count;
+
+    /// Returns a word with all bits of the last storage word that are within `Size` set.
+    /// Used to keep the unused tail bits zero after operations that may set them.
+    static constexpr word_type tail_mask() noexcept
+    {
+        return (Size % word_size == 0)
+            ? static_cast<word_type>(~word_type{0})
+            : static_cast<word_type>((word_type{1} << (Size % word_size)) - 1);
+    }
 private:
     detail::bit_storage<Size> storage;
+
+    /// Returns the index of the word holding the bit at `index`.
+    static constexpr size_t word_index(size_t index) noexcept
+    {
+        return index / word_size;
+    }
+
+    /// Returns a word with only the bit at `index` (modulo the word size) set.
+    static constexpr word_type word_bit(size_t index) noexcept
+    {
+        return static_cast<word_type>(word_type{1} << (index % word_size));
+    }
+
+    /// Returns a pointer to the storage words.
+    constexpr word_type* words() noexcept
+    {
+        return detail::word_data(storage);
+    }
+
+    /// Returns a pointer to the storage words.
+    constexpr word_type const* words() const noexcept
+    {
+        return detail::word_data(storage);
+    }
 public:
     // The usual suspects.
     constexpr bit_mask(bit_mask const&) noexcept            = default;
@@ -235,7 +245,8 @@ public:
     /// Constructs a bit mask from a set of `indices...` specifying which bits to set.
     /// The `Indices...` must be implicitly convertible to `size_t`,
     /// and none should be a `bool` (that is reserved for `bit_mask(Bools...)` constructor).
-    /// Specifying any invalid index throws an `std::out_of_range` exception.
+    /// Specifying any invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
     template <
         typename... Indices,
         bool Enable = ! detail::any(std::is_same<Indices, bool>::value...),
@@ -257,17 +268,13 @@ public:
     }
 
     /// Test of a bit at a specified index.
-    /// The index must be less than the bit mask size, otherwise an exception is thrown.
+    /// The index must be less than the bit mask size, otherwise the access is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
     /// Returns `true` if the bit at index is set, otherwise `false`.
     constexpr bool get(size_t index) const
     {
-        if (index >= Size)
-        {
-            throw std::out_of_range("Bit mask get index out of bounds");
-        }
-        const uint8_t bit = (1 << (index % 8));
-        const uint8_t byte = storage[index / 8];
-        return ((byte & bit) == 0) ? false : true;
+        detail::check_bounds(index < Size, "Bit mask get index out of bounds");
+        return (words()[word_index(index)] & word_bit(index)) != 0;
     }
 
     /// Safe test of a bit at a specified compile time index.
@@ -281,16 +288,11 @@ public:
     }
 
     /// Sets the bit at a specified index.
-    /// The index must be less than the bit mask size, otherwise an exception is thrown.
+    /// The index must be less than the bit mask size, see `get(size_t)` for details.
     constexpr void set(size_t index) &
     {
-        if (index >= Size)
-        {
-            throw std::out_of_range("Bit mask set index out of bounds");
-        }
-        const uint8_t bit = index % 8;
-        uint8_t& byte = storage[index / 8];
-        byte |= (1 << bit);
+        detail::check_bounds(index < Size, "Bit mask set index out of bounds");
+        words()[word_index(index)] |= word_bit(index);
     }
 
     /// Safe setting of a bit at a specified index.
@@ -303,16 +305,11 @@ public:
     }
 
     /// Clears the bit at a specified index.
-    /// The index must be less than the bit mask size, otherwise an exception is thrown.
+    /// The index must be less than the bit mask size, see `get(size_t)` for details.
     constexpr void clear(size_t index) &
     {
-        if (index >= Size)
-        {
-            throw std::out_of_range("Bit mask clear index out of bounds");
-        }
-        const uint8_t bit = index % 8;
-        uint8_t& byte = storage[index / 8];
-        byte &= ~(1 << bit);
+        detail::check_bounds(index < Size, "Bit mask clear index out of bounds");
+        words()[word_index(index)] &= static_cast<word_type>(~word_bit(index));
     }
 
     /// Safe clearing of a bit at a specified index.
@@ -324,11 +321,343 @@ public:
         clear(Index);
     }
 
+    /// Test of a bit at a specified index without bounds checking policy.
+    /// Stores the bit at index in `bit` and returns `true` if the index is less than the
+    /// bit mask size, otherwise leaves `bit` untouched and returns `false`.
+    constexpr bool try_get(size_t index, bool& bit) const noexcept
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        bit = (words()[word_index(index)] & word_bit(index)) != 0;
+        return true;
+    }
+
+    /// Sets the bit at a specified index without bounds checking policy.
+    /// Returns `true` if the index is less than the bit mask size, otherwise `false`.
+    constexpr bool try_set(size_t index) & noexcept
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        words()[word_index(index)] |= word_bit(index);
+        return true;
+    }
+
+    /// Clears the bit at a specified index without bounds checking policy.
+    /// Returns `true` if the index is less than the bit mask size, otherwise `false`.
+    constexpr bool try_clear(size_t index) & noexcept
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+        words()[word_index(index)] &= static_cast<word_type>(~word_bit(index));
+        return true;
+    }
+
+    /// Sets the bits at the indices `index_of(element)` of all elements in `[first, last)`,
+    /// without bounds checking policy.
+    /// Returns `true` if all indices are less than the bit mask size, otherwise `false` and the
+    /// bit mask is left unchanged.
+    /// The indices are validated once after the loop instead of on each element, so that the
+    /// loop is free of branches and compilers can vectorize it.
+    template <typename Iterator, typename IndexOf>
+    constexpr bool try_set_all(Iterator first, Iterator last, IndexOf index_of) &
+    {
+        size_t largest = 0;
+        if (word_count == 1)
+        {
+            // Accumulate in a register, indices out of range contribute no bits.
+            word_type bits = 0;
+            for (; first != last; ++first)
+            {
+                const size_t index = index_of(*first);
+                bits |= static_cast<word_type>(
+                    static_cast<word_type>(index < Size) << (index % word_size));
+                largest = (largest < index) ? index : largest;
+            }
+            words()[0] |= (largest < Size) ? bits : word_type{0};
+            return largest < Size;
+        }
+        // Indices out of range may set stray bits in the copy, which is then discarded.
+        bit_mask result = *this;
+        for (; first != last; ++first)
+        {
+            const size_t index = index_of(*first);
+            result.words()[word_index(index) % word_count] |= word_bit(index);
+            largest = (largest < index) ? index : largest;
+        }
+        if (largest >= Size)
+        {
+            return false;
+        }
+        *this = result;
+        return true;
+    }
+
+    /// Returns the storage word at `index`,
+    /// holding bits `[index * word_size, (index + 1) * word_size)`.
+    /// The index must be less than `word_count`.
+    constexpr word_type word(size_t index) const noexcept
+    {
+        return words()[index];
+    }
+
+    /// Replaces the storage word at `index` with `bits`, see `word(size_t)` for details.
+    /// Bits of the last word beyond the size of the bit mask are ignored.
+    /// The index must be less than `word_count`.
+    constexpr void set_word(size_t index, word_type bits) & noexcept
+    {
+        words()[index] = (index + 1 == word_count)
+            ? static_cast<word_type>(bits & tail_mask())
+            : bits;
+    }
+
+    /// Finds the first set bit at index greater or equal to an `offset`.
+    /// Skips over whole words at a time and locates the bit with count trailing zeros.
+    /// Returns the index of the bit if found, otherwise returns `size()`.
+    constexpr size_t find_next(size_t offset) const noexcept
+    {
+        if (offset >= Size)
+        {
+            return Size;
+        }
+        size_t index = word_index(offset);
+        word_type bits = words()[index] & detail::mask_from<word_type>(offset % word_size);
+        while (bits == 0)
+        {
+            if (++index == word_count)
+            {
+                return Size;
+            }
+            bits = words()[index];
+        }
+        return index * word_size + detail::count_trailing_zeros(bits);
+    }
+
+    /// Finds the first set bit.
+    /// Returns the index of the bit if found, otherwise returns `size()`.
+    constexpr size_t find_first() const noexcept
+    {
+        return find_next(0);
+    }
+
+    /// Finds the last set bit at index strictly less than an `offset`.
+    /// Skips over whole words at a time and locates the bit with count leading zeros.
+    /// Returns the index of the bit if found, otherwise returns `size()`.
+    constexpr size_t find_prev(size_t offset) const noexcept
+    {
+        if (offset == 0)
+        {
+            return Size;
+        }
+        const size_t last = (offset > Size ? Size : offset) - 1;
+        size_t index = word_index(last);
+        word_type bits = words()[index] & detail::mask_to<word_type>(last % word_size);
+        while (bits == 0)
+        {
+            if (index == 0)
+            {
+                return Size;
+            }
+            bits = words()[--index];
+        }
+        return index * word_size + (word_size - 1 - detail::count_leading_zeros(bits));
+    }
+
+    /// Finds the last set bit.
+    /// Returns the index of the bit if found, otherwise returns `size()`.
+    constexpr size_t find_last() const noexcept
+    {
+        return find_prev(Size);
+    }
+
+    /// Writes the indices of the set bits in increasing order to `output`, at most `capacity`
+    /// of them, and returns the number of indices written.
+    /// Entries of `output` after the returned count (but before `capacity`) may be overwritten,
+    /// since indices are written a whole byte or word of the bit mask at a time.
+    /// Uses AVX-512 `vpcompress` for 32-bit indices (and 16-bit indices with VBMI2) if available,
+    /// otherwise a byte lookup table, see `detail::word_kernels::extract`.
+    template <typename Index>
+    constexpr size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        return detail::word_kernels::extract(words(), word_count, output, capacity);
+    }
+
+    /// Returns the number of set bits.
+    constexpr size_t count() const noexcept
+    {
+        return detail::word_kernels::popcount(words(), word_count);
+    }
+
+    /// Returns the number of set bits at index strictly less than `index`.
+    /// Indices beyond the size of the bit mask count all set bits.
+    constexpr size_t rank(size_t index) const noexcept
+    {
+        if (index >= Size)
+        {
+            return count();
+        }
+        size_t result = 0;
+        const size_t last = word_index(index);
+        for (size_t offset = 0; offset < last; ++offset)
+        {
+            result += detail::popcount(words()[offset]);
+        }
+        const word_type below = static_cast<word_type>(
+            ~detail::mask_from<word_type>(index % word_size));
+        return result + detail::popcount(static_cast<word_type>(words()[last] & below));
+    }
+
+    /// Returns the index of the `k`:th (zero based) set bit.
+    /// Skips whole words using popcount, see `detail::select_in_word` for the search within a word.
+    /// Returns `size()` if there are `k` or fewer set bits.
+    constexpr size_t select(size_t k) const noexcept
+    {
+        for (size_t index = 0; index < word_count; ++index)
+        {
+            const size_t bits = detail::popcount(words()[index]);
+            if (k < bits)
+            {
+                return index * word_size + detail::select_in_word(words()[index], k);
+            }
+            k -= bits;
+        }
+        return Size;
+    }
+
+    /// Returns `true` if any bit is set, otherwise `false`.
+    constexpr bool any() const noexcept
+    {
+        for (size_t index = 0; index < word_count; ++index)
+        {
+            if (words()[index] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns `true` if no bit is set, otherwise `false`.
+    constexpr bool none() const noexcept
+    {
+        return !any();
+    }
+
+    /// Returns `true` if all bits are set, otherwise `false`.
+    constexpr bool all() const noexcept
+    {
+        return *this == ~bit_mask{};
+    }
+
+    /// Returns `true` if any bit is set in both this and another bit mask, otherwise `false`.
+    constexpr bool intersects(bit_mask const& another) const noexcept
+    {
+        for (size_t index = 0; index < word_count; ++index)
+        {
+            if ((words()[index] & another.words()[index]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns `true` if every bit set in this bit mask is also set in another, otherwise `false`.
+    constexpr bool is_subset_of(bit_mask const& another) const noexcept
+    {
+        return detail::word_kernels::subset(words(), another.words(), word_count);
+    }
+
+    /// Inverts all bits in place, leaving the unused tail bits of the last word cleared.
+    /// Returns a reference to this bit mask.
+    constexpr bit_mask& flip() & noexcept
+    {
+        for (size_t index = 0; index < word_count; ++index)
+        {
+            words()[index] = static_cast<word_type>(~words()[index]);
+        }
+        words()[word_count - 1] &= tail_mask();
+        return *this;
+    }
+
+    /// Sets all bits that are set in another bit mask (bitwise or).
+    /// Returns a reference to this bit mask.
+    constexpr bit_mask& operator|=(bit_mask const& another) & noexcept
+    {
+        detail::word_kernels::bitwise_or(words(), another.words(), word_count);
+        return *this;
+    }
+
+    /// Clears all bits that are not set in another bit mask (bitwise and).
+    /// Returns a reference to this bit mask.
+    constexpr bit_mask& operator&=(bit_mask const& another) & noexcept
+    {
+        detail::word_kernels::bitwise_and(words(), another.words(), word_count);
+        return *this;
+    }
+
+    /// Toggles all bits that are set in another bit mask (bitwise exclusive or).
+    /// Returns a reference to this bit mask.
+    constexpr bit_mask& operator^=(bit_mask const& another) & noexcept
+    {
+        detail::word_kernels::bitwise_xor(words(), another.words(), word_count);
+        return *this;
+    }
+
+    /// Clears all bits that are set in another bit mask (bitwise and-not).
+    /// Returns a reference to this bit mask.
+    constexpr bit_mask& operator/=(bit_mask const& another) & noexcept
+    {
+        detail::word_kernels::bitwise_and_not(words(), another.words(), word_count);
+        return *this;
+    }
+
+    /// Returns a copy of a bit mask with all bits inverted.
+    /// See `flip()` for details.
+    constexpr bit_mask operator~() const noexcept
+    {
+        bit_mask result = *this;
+        return result.flip();
+    }
+
+    /// Returns the bitwise or of two bit masks.
+    friend constexpr bit_mask operator|(bit_mask const& lhs, bit_mask const& rhs) noexcept
+    {
+        bit_mask result = lhs;
+        return result |= rhs;
+    }
+
+    /// Returns the bitwise and of two bit masks.
+    friend constexpr bit_mask operator&(bit_mask const& lhs, bit_mask const& rhs) noexcept
+    {
+        bit_mask result = lhs;
+        return result &= rhs;
+    }
+
+    /// Returns the bitwise exclusive or of two bit masks.
+    friend constexpr bit_mask operator^(bit_mask const& lhs, bit_mask const& rhs) noexcept
+    {
+        bit_mask result = lhs;
+        return result ^= rhs;
+    }
+
+    /// Returns the bits set in the first bit mask but not in the second (bitwise and-not).
+    friend constexpr bit_mask operator/(bit_mask const& lhs, bit_mask const& rhs) noexcept
+    {
+        bit_mask result = lhs;
+        return result /= rhs;
+    }
+
     /// Compares two bit masks.
     /// Returns `true` of all bits are equal, otherwise `false`.
     friend constexpr bool operator==(bit_mask const& lhs, bit_mask const& rhs) noexcept
     {
-        return detail::operator==(lhs.storage, rhs.storage);
+        return detail::word_kernels::equal(lhs.words(), rhs.words(), word_count);
     }
 
     /// Compares two bit masks for inequality.
@@ -340,6 +669,12 @@ public:
 
 }; // class bit_mask
 
+template <size_t Size>
+constexpr size_t bit_mask<Size>::word_size;
+
+template <size_t Size>
+constexpr size_t bit_mask<Size>::word_count;
+
 }  // namespace enum_set
 
 #endif // ENUM_SET_BIT_MASK_HPP
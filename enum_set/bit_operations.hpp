@@ -0,0 +1,178 @@
+#ifndef ENUM_SET_BIT_OPERATIONS_HPP
+#define ENUM_SET_BIT_OPERATIONS_HPP
+
+#include <enum_set/standard_types.hpp>
+
+#include <type_traits>
+
+/// Compilers providing constexpr bit manipulation builtins (`__builtin_popcountll` et. al.).
+/// Other compilers use portable constexpr fallbacks that avoid loops over individual bits.
+/// Can be predefined to 0 to force the portable fallbacks.
+#ifndef ENUM_SET_HAS_BIT_BUILTINS
+#if defined(__GNUC__) || defined(__clang__)
+#define ENUM_SET_HAS_BIT_BUILTINS 1
+#else
+#define ENUM_SET_HAS_BIT_BUILTINS 0
+#endif
+#endif
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Returns the number of set bits in an unsigned `word`.
+template <typename Word>
+constexpr size_t popcount(Word word) noexcept
+{
+    static_assert(std::is_unsigned<Word>::value, "popcount requires an unsigned word");
+    static_assert(sizeof(Word) <= sizeof(uint64_t), "popcount requires at most 64-bit words");
+#if ENUM_SET_HAS_BIT_BUILTINS
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    uint64_t x = word;
+    x = x - ((x >> 1) & 0x5555555555555555u);
+    x = (x & 0x3333333333333333u) + ((x >> 2) & 0x3333333333333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+    return static_cast<size_t>((x * 0x0101010101010101u) >> 56);
+#endif
+}
+
+/// Returns the number of trailing zero bits in an unsigned `word`,
+/// that is, the index of the lowest set bit.
+/// Returns the number of bits in `Word` if `word` is zero.
+template <typename Word>
+constexpr size_t count_trailing_zeros(Word word) noexcept
+{
+    static_assert(std::is_unsigned<Word>::value, "count_trailing_zeros requires an unsigned word");
+    static_assert(sizeof(Word) <= sizeof(uint64_t),
+                  "count_trailing_zeros requires at most 64-bit words");
+    if (word == 0)
+    {
+        return 8 * sizeof(Word);
+    }
+#if ENUM_SET_HAS_BIT_BUILTINS
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    const uint64_t x = word;
+    return popcount((x & (~x + 1)) - 1);
+#endif
+}
+
+/// Returns the number of leading zero bits in an unsigned `word`,
+/// counted from the highest bit of `Word`.
+/// Returns the number of bits in `Word` if `word` is zero.
+template <typename Word>
+constexpr size_t count_leading_zeros(Word word) noexcept
+{
+    static_assert(std::is_unsigned<Word>::value, "count_leading_zeros requires an unsigned word");
+    static_assert(sizeof(Word) <= sizeof(uint64_t),
+                  "count_leading_zeros requires at most 64-bit words");
+    if (word == 0)
+    {
+        return 8 * sizeof(Word);
+    }
+#if ENUM_SET_HAS_BIT_BUILTINS
+    return static_cast<size_t>(__builtin_clzll(word)) - 8 * (sizeof(uint64_t) - sizeof(Word));
+#else
+    uint64_t x = word;
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    x |= x >> 32;
+    return 8 * sizeof(Word) - popcount(x);
+#endif
+}
+
+/// Returns a `Word` with all bits at index `bit` and above set.
+/// The `bit` must be less than the number of bits in `Word`.
+template <typename Word>
+constexpr Word mask_from(size_t bit) noexcept
+{
+    return static_cast<Word>(static_cast<Word>(~Word{0}) << bit);
+}
+
+/// Returns a `Word` with all bits at index `bit` and below set.
+/// The `bit` must be less than the number of bits in `Word`.
+template <typename Word>
+constexpr Word mask_to(size_t bit) noexcept
+{
+    return static_cast<Word>(static_cast<Word>(~Word{0}) >> (8 * sizeof(Word) - 1 - bit));
+}
+
+/// Returns `word` with its lowest set bit cleared.
+template <typename Word>
+constexpr Word clear_lowest(Word word) noexcept
+{
+    return static_cast<Word>(word & (word - 1));
+}
+
+/// Lookup table holding, for each byte value, the positions of its set bits in increasing order.
+/// Entry `positions[byte][k]` is the index of the `k`:th set bit of `byte`.
+/// Entries beyond the number of set bits in `byte` are 8.
+/// Entry `counts[byte]` is the number of set bits of `byte`.
+struct byte_select_table
+{
+    uint8_t positions[256][8];
+    uint8_t counts[256];
+};
+
+/// Creates the `byte_select_table` at compile time.
+constexpr byte_select_table make_byte_select_table() noexcept
+{
+    byte_select_table table{};
+    for (size_t byte = 0; byte < 256; ++byte)
+    {
+        size_t count = 0;
+        for (size_t bit = 0; bit < 8; ++bit)
+        {
+            if ((byte >> bit) & 1)
+            {
+                table.positions[byte][count++] = static_cast<uint8_t>(bit);
+            }
+        }
+        table.counts[byte] = static_cast<uint8_t>(count);
+        while (count < 8)
+        {
+            table.positions[byte][count++] = 8;
+        }
+    }
+    return table;
+}
+
+/// Holder of the `byte_select_table`.
+/// A class template is used so that there is a single table shared across translation units.
+template <typename = void>
+struct byte_select
+{
+    static constexpr byte_select_table table = make_byte_select_table();
+};
+
+template <typename T>
+constexpr byte_select_table byte_select<T>::table;
+
+/// Returns the index of the `k`:th (zero based) set bit in an unsigned `word`.
+/// Skips whole bytes using popcount and looks up the bit within a byte in a `byte_select_table`.
+/// Returns the number of bits in `Word` if `word` has `k` or fewer set bits.
+template <typename Word>
+constexpr size_t select_in_word(Word word, size_t k) noexcept
+{
+    for (size_t byte_index = 0; byte_index < sizeof(Word); ++byte_index)
+    {
+        const uint8_t byte = static_cast<uint8_t>(word >> (8 * byte_index));
+        const size_t bits = popcount(byte);
+        if (k < bits)
+        {
+            return 8 * byte_index + byte_select<>::table.positions[byte][k];
+        }
+        k -= bits;
+    }
+    return 8 * sizeof(Word);
+}
+
+}  // namespace detail
+}  // namespace enum_set
+
+#endif // ENUM_SET_BIT_OPERATIONS_HPP
@@ -0,0 +1,125 @@
+#ifndef ENUM_SET_BOUNDS_CHECK_HPP
+#define ENUM_SET_BOUNDS_CHECK_HPP
+
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+/// Bounds checking modes, see `ENUM_SET_BOUNDS_CHECK` below.
+#define ENUM_SET_BOUNDS_CHECK_THROW 0
+#define ENUM_SET_BOUNDS_CHECK_ASSERT 1
+#define ENUM_SET_BOUNDS_CHECK_UNCHECKED 2
+
+/// Detects if exceptions are enabled.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define ENUM_SET_HAS_EXCEPTIONS 1
+#else
+#define ENUM_SET_HAS_EXCEPTIONS 0
+#endif
+
+/// Selects what happens when an index or value is out of bounds in the runtime accessors of
+/// `bit_mask` and the sets built on top of it (`get`, `set`, `clear`, the runtime constructors,
+/// dereferencing the end iterator, etc.).
+/// - `ENUM_SET_BOUNDS_CHECK_THROW` throws an `std::out_of_range` exception (the default).
+/// - `ENUM_SET_BOUNDS_CHECK_ASSERT` asserts, so the check vanishes if `NDEBUG` is defined.
+/// - `ENUM_SET_BOUNDS_CHECK_UNCHECKED` does not check, an out of bounds access is undefined.
+/// If exceptions are disabled, the default is `ENUM_SET_BOUNDS_CHECK_ASSERT`, and
+/// `ENUM_SET_BOUNDS_CHECK_THROW` is an error.
+/// The mode must be the same in all translation units of a program.
+/// Use the `try_` accessors to check bounds regardless of the mode.
+#ifndef ENUM_SET_BOUNDS_CHECK
+#if ENUM_SET_HAS_EXCEPTIONS
+#define ENUM_SET_BOUNDS_CHECK ENUM_SET_BOUNDS_CHECK_THROW
+#else
+#define ENUM_SET_BOUNDS_CHECK ENUM_SET_BOUNDS_CHECK_ASSERT
+#endif
+#endif
+
+#if ENUM_SET_BOUNDS_CHECK == ENUM_SET_BOUNDS_CHECK_THROW && !ENUM_SET_HAS_EXCEPTIONS
+#error "ENUM_SET_BOUNDS_CHECK_THROW requires exceptions, use ASSERT or UNCHECKED without them"
+#endif
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Bounds checking modes, mirroring the `ENUM_SET_BOUNDS_CHECK_` macros.
+enum class bounds_check
+{
+    throws    = ENUM_SET_BOUNDS_CHECK_THROW,
+    asserts   = ENUM_SET_BOUNDS_CHECK_ASSERT,
+    unchecked = ENUM_SET_BOUNDS_CHECK_UNCHECKED
+};
+
+/// Policy reacting on a failed bounds check according to a bounds checking `Mode`.
+/// The `check` method is called with the outcome of a bounds check and a message describing it.
+template <bounds_check Mode>
+struct bounds_checker;
+
+#if ENUM_SET_HAS_EXCEPTIONS
+/// Throws an `std::out_of_range` exception if a bounds check fails.
+template <>
+struct bounds_checker<bounds_check::throws>
+{
+    static constexpr void check(bool valid, char const* message)
+    {
+        if (!valid)
+        {
+            throw std::out_of_range(message);
+        }
+    }
+};
+#endif
+
+/// Asserts that a bounds check succeeds.
+template <>
+struct bounds_checker<bounds_check::asserts>
+{
+    static constexpr void check(bool valid, char const* message) noexcept
+    {
+        (void) message;
+        assert(valid && "enum_set index out of bounds");
+        (void) valid;
+    }
+};
+
+/// Ignores bounds checks.
+template <>
+struct bounds_checker<bounds_check::unchecked>
+{
+    static constexpr void check(bool, char const*) noexcept
+    {
+    }
+};
+
+/// Throws an `Exception` constructed from `arguments`, or aborts if exceptions are disabled.
+/// Used for errors other than bounds checks (e.g. failing system calls). Code raising them
+/// offers non-throwing alternatives reporting the errors instead, for builds without exceptions.
+#if ENUM_SET_HAS_EXCEPTIONS
+template <typename Exception, typename... Arguments>
+[[noreturn]] inline void throw_exception(Arguments&&... arguments)
+{
+    throw Exception(std::forward<Arguments>(arguments)...);
+}
+#else
+template <typename Exception, typename... Arguments>
+[[noreturn]] inline void throw_exception(Arguments&&...) noexcept
+{
+    std::abort();
+}
+#endif
+
+/// Checks bounds according to the `ENUM_SET_BOUNDS_CHECK` mode.
+/// `valid` should be `true` if an access is within bounds, `message` describes the access.
+constexpr void check_bounds(bool valid, char const* message)
+    noexcept(ENUM_SET_BOUNDS_CHECK != ENUM_SET_BOUNDS_CHECK_THROW)
+{
+    bounds_checker<static_cast<bounds_check>(ENUM_SET_BOUNDS_CHECK)>::check(valid, message);
+}
+
+}  // namespace detail
+}  // namespace enum_set
+
+#endif // ENUM_SET_BOUNDS_CHECK_HPP
@@ -0,0 +1,508 @@
+#ifndef ENUM_SET_CODEC_HPP
+#define ENUM_SET_CODEC_HPP
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/type_set.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+/// Hosts storing integers least significant byte first, where the dense encoding is a copy of
+/// the storage words of a bit mask. Other hosts assemble the words a byte at a time.
+/// Can be predefined to 0 to force the portable byte assembly.
+#ifndef ENUM_SET_LITTLE_ENDIAN
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#define ENUM_SET_LITTLE_ENDIAN 1
+#else
+#define ENUM_SET_LITTLE_ENDIAN 0
+#endif
+#endif
+
+namespace enum_set
+{
+
+/// Encodings of a set written by `encode`, stored in the first byte of the encoded set.
+enum class set_encoding : uint8_t
+{
+    /// The bit mask, bit `i % 8` of byte `i / 8` set if index `i` is an element.
+    dense = 0,
+    /// The number of elements, followed by the gaps between consecutive elements, as varints.
+    delta = 1,
+    /// The number of runs of consecutive elements, followed by the gap before and the length
+    /// minus one of each run, as varints.
+    runs = 2
+};
+
+namespace detail
+{
+
+/// Returns the bit mask of a set of values.
+template <typename... Ts>
+constexpr bit_mask<sizeof...(Ts)> const& codec_mask(type_set<Ts...> const& set) noexcept
+{
+    return mask_access::mask(set);
+}
+
+/// Returns a bit mask, see `codec_mask` for sets of values.
+template <size_t Size>
+constexpr bit_mask<Size> const& codec_mask(bit_mask<Size> const& mask) noexcept
+{
+    return mask;
+}
+
+/// Replaces a set of values by the elements of a bit mask.
+template <typename Set, size_t Size>
+void codec_assign(Set& set, bit_mask<Size> const& mask) noexcept
+{
+    set = mask_access::make<Set>(mask);
+}
+
+/// Replaces a bit mask, see `codec_assign` for sets of values.
+template <size_t Size>
+void codec_assign(bit_mask<Size>& target, bit_mask<Size> const& mask) noexcept
+{
+    target = mask;
+}
+
+/// Declaration of the bit mask type encoded for a `Set`, a `bit_mask` or a set of values.
+template <typename Set>
+using codec_mask_t = std::decay_t<decltype(codec_mask(std::declval<Set const&>()))>;
+
+/// Number of bits of a bit mask type.
+template <typename Mask>
+struct codec_mask_size;
+
+template <size_t Size>
+struct codec_mask_size<bit_mask<Size>> : std::integral_constant<size_t, Size>
+{
+};
+
+/// Returns the number of bytes of the LEB128 varint of `value`, seven bits per byte.
+constexpr size_t varint_size(uint64_t value) noexcept
+{
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7)
+    {
+        ++size;
+    }
+    return size;
+}
+
+/// Stores the varint of `value` at `output`, and advances `output` past it.
+inline void store_varint(uint64_t value, unsigned char*& output) noexcept
+{
+    for (; value >= 0x80; value >>= 7)
+    {
+        *output++ = static_cast<unsigned char>(value | 0x80);
+    }
+    *output++ = static_cast<unsigned char>(value);
+}
+
+/// Loads a varint from `input` into `value`, and advances `input` past it.
+/// Returns `false`, leaving `input` unspecified, if the varint is longer than 10 bytes
+/// or reaches `end`.
+inline bool load_varint(unsigned char const*& input, unsigned char const* end, uint64_t& value)
+    noexcept
+{
+    value = 0;
+    for (size_t shift = 0; input != end && shift < 64; shift += 7)
+    {
+        const unsigned char byte = *input++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Calls `visitor(index)` for the index of every set bit of a bit mask, in increasing order,
+/// a word at a time.
+template <size_t Size, typename Visitor>
+void for_each_index(bit_mask<Size> const& mask, Visitor&& visitor)
+{
+    using mask_type = bit_mask<Size>;
+    using word_type = typename mask_type::word_type;
+    for (size_t index = 0; index < mask_type::word_count; ++index)
+    {
+        for (word_type bits = mask.word(index); bits != 0; bits = clear_lowest(bits))
+        {
+            visitor(index * mask_type::word_size + count_trailing_zeros(bits));
+        }
+    }
+}
+
+/// Calls `visitor(start, end)` for every run `[start, end)` of consecutive set bits of a bit
+/// mask, in increasing order. The first and last bits of the runs are found a word at a time,
+/// comparing each word with itself shifted by one bit.
+template <size_t Size, typename Visitor>
+void for_each_run(bit_mask<Size> const& mask, Visitor&& visitor)
+{
+    using mask_type = bit_mask<Size>;
+    using word_type = typename mask_type::word_type;
+    constexpr size_t word_size = mask_type::word_size;
+    word_type carry = 0;
+    size_t start = 0;
+    bool open = false;
+    for (size_t index = 0; index < mask_type::word_count; ++index)
+    {
+        const word_type bits = mask.word(index);
+        const word_type next = (index + 1 < mask_type::word_count)
+            ? static_cast<word_type>(mask.word(index + 1) & 1)
+            : word_type{0};
+        word_type firsts = static_cast<word_type>(
+            bits & static_cast<word_type>(~static_cast<word_type>((bits << 1) | carry)));
+        word_type lasts = static_cast<word_type>(
+            bits & static_cast<word_type>(
+                ~static_cast<word_type>((bits >> 1) | (next << (word_size - 1)))));
+        carry = static_cast<word_type>(bits >> (word_size - 1));
+        while (open ? lasts != 0 : firsts != 0)
+        {
+            if (open)
+            {
+                visitor(start, index * word_size + count_trailing_zeros(lasts) + 1);
+                lasts = clear_lowest(lasts);
+            }
+            else
+            {
+                start = index * word_size + count_trailing_zeros(firsts);
+                firsts = clear_lowest(firsts);
+            }
+            open = !open;
+        }
+    }
+}
+
+/// Returns the number of runs of consecutive set bits of a bit mask, one popcount per word.
+template <size_t Size>
+size_t run_count(bit_mask<Size> const& mask) noexcept
+{
+    using mask_type = bit_mask<Size>;
+    using word_type = typename mask_type::word_type;
+    size_t result = 0;
+    word_type carry = 0;
+    for (size_t index = 0; index < mask_type::word_count; ++index)
+    {
+        const word_type bits = mask.word(index);
+        result += popcount(static_cast<word_type>(
+            bits & static_cast<word_type>(~static_cast<word_type>((bits << 1) | carry))));
+        carry = static_cast<word_type>(bits >> (mask_type::word_size - 1));
+    }
+    return result;
+}
+
+/// Number of bytes of each encoding of a bit mask, see `measure_encodings`.
+struct encoding_sizes
+{
+    size_t dense;
+    size_t delta;
+    size_t runs;
+};
+
+/// Measures the number of bytes of each encoding of a bit mask, including the encoding byte.
+/// The cardinality and the number of runs are counted a word at a time first, and give a lower
+/// bound on the sparse encodings. The exact size of a sparse encoding is only computed, visiting
+/// its elements or runs, if that bound is below the dense size, otherwise it is left at the upper
+/// bound `SIZE_MAX`.
+template <size_t Size>
+encoding_sizes measure_encodings(bit_mask<Size> const& mask) noexcept
+{
+    const size_t dense = 1 + (Size + 7) / 8;
+    encoding_sizes result{dense, SIZE_MAX, SIZE_MAX};
+    const size_t elements = mask.count();
+    if (1 + varint_size(elements) + elements < dense)
+    {
+        size_t size = 1 + varint_size(elements);
+        size_t previous = 0;
+        for_each_index(mask, [&size, &previous](size_t index)
+        {
+            size += varint_size(index - previous);
+            previous = index + 1;
+        });
+        result.delta = size;
+    }
+    const size_t runs = run_count(mask);
+    if (1 + varint_size(runs) + 2 * runs < dense)
+    {
+        size_t size = 1 + varint_size(runs);
+        size_t previous = 0;
+        for_each_run(mask, [&size, &previous](size_t start, size_t end)
+        {
+            size += varint_size(start - previous) + varint_size(end - start - 1);
+            previous = end;
+        });
+        result.runs = size;
+    }
+    return result;
+}
+
+/// Returns the smallest encoding of `sizes`, preferring the fastest to decode on ties.
+inline set_encoding smallest_encoding(encoding_sizes const& sizes) noexcept
+{
+    if (sizes.dense <= sizes.runs && sizes.dense <= sizes.delta)
+    {
+        return set_encoding::dense;
+    }
+    return sizes.runs <= sizes.delta ? set_encoding::runs : set_encoding::delta;
+}
+
+/// Sets the bits `[start, end)` of `words`, whole words at a time.
+/// The range must not be empty.
+template <typename Word, size_t WordSize>
+void fill_bits(Word* words, size_t start, size_t end) noexcept
+{
+    const size_t first = start / WordSize;
+    const size_t last = (end - 1) / WordSize;
+    const Word head = mask_from<Word>(start % WordSize);
+    const Word tail = mask_to<Word>((end - 1) % WordSize);
+    if (first == last)
+    {
+        words[first] = static_cast<Word>(words[first] | (head & tail));
+        return;
+    }
+    words[first] = static_cast<Word>(words[first] | head);
+    for (size_t index = first + 1; index < last; ++index)
+    {
+        words[index] = static_cast<Word>(~Word{0});
+    }
+    words[last] = static_cast<Word>(words[last] | tail);
+}
+
+}  // namespace detail
+
+/// Returns an upper bound on the number of bytes written by `encode` for a `Set`, which is a
+/// `bit_mask` or a set of values (e.g. `make_index_set<Size>`).
+template <typename Set>
+constexpr size_t max_encoded_size() noexcept
+{
+    return 1 + (detail::codec_mask_size<detail::codec_mask_t<Set>>::value + 7) / 8;
+}
+
+/// Returns the encoding `encode` picks for a set, the smallest of the dense bit mask, the
+/// varint delta list of its elements and the run length encoding of its runs of consecutive
+/// elements, see `set_encoding`.
+template <typename Set>
+set_encoding choose_encoding(Set const& set) noexcept
+{
+    return detail::smallest_encoding(detail::measure_encodings(detail::codec_mask(set)));
+}
+
+/// Returns the number of bytes `encode` writes for a set, at most `max_encoded_size<Set>()`.
+template <typename Set>
+size_t encoded_size(Set const& set) noexcept
+{
+    const auto sizes = detail::measure_encodings(detail::codec_mask(set));
+    switch (detail::smallest_encoding(sizes))
+    {
+        case set_encoding::delta: return sizes.delta;
+        case set_encoding::runs:  return sizes.runs;
+        default:                  return sizes.dense;
+    }
+}
+
+/// Writes a set, a `bit_mask` or a set of values, to `output` in the smallest of its encodings
+/// (see `choose_encoding`), and returns the number of bytes written.
+/// The encoding of a set does not carry its universe, use it for sets that are known to share
+/// it (see `set_layout` for a self describing layout).
+/// The `output` must hold at least `capacity` bytes, a `capacity` smaller than the encoded size
+/// (see `encoded_size`, and `max_encoded_size` to size a buffer up front) is handled according to
+/// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+template <typename Set>
+size_t encode(Set const& set, unsigned char* output, size_t capacity)
+{
+    using mask_type = detail::codec_mask_t<Set>;
+    using word_type = typename mask_type::word_type;
+    auto const& mask = detail::codec_mask(set);
+    const auto sizes = detail::measure_encodings(mask);
+    const set_encoding encoding = detail::smallest_encoding(sizes);
+    unsigned char* position = output;
+    switch (encoding)
+    {
+        case set_encoding::delta:
+        {
+            detail::check_bounds(capacity >= sizes.delta, "encode output buffer too small");
+            *position++ = static_cast<unsigned char>(encoding);
+            detail::store_varint(mask.count(), position);
+            size_t previous = 0;
+            detail::for_each_index(mask, [&position, &previous](size_t index)
+            {
+                detail::store_varint(index - previous, position);
+                previous = index + 1;
+            });
+            break;
+        }
+        case set_encoding::runs:
+        {
+            detail::check_bounds(capacity >= sizes.runs, "encode output buffer too small");
+            *position++ = static_cast<unsigned char>(encoding);
+            detail::store_varint(detail::run_count(mask), position);
+            size_t previous = 0;
+            detail::for_each_run(mask, [&position, &previous](size_t start, size_t end)
+            {
+                detail::store_varint(start - previous, position);
+                detail::store_varint(end - start - 1, position);
+                previous = end;
+            });
+            break;
+        }
+        default:
+        {
+            detail::check_bounds(capacity >= sizes.dense, "encode output buffer too small");
+            *position++ = static_cast<unsigned char>(encoding);
+            constexpr size_t byte_count = (detail::codec_mask_size<mask_type>::value + 7) / 8;
+#if ENUM_SET_LITTLE_ENDIAN
+            for (size_t index = 0; index < mask_type::word_count; ++index)
+            {
+                const word_type word = mask.word(index);
+                const size_t offset = index * sizeof(word_type);
+                std::memcpy(position + offset, &word,
+                            std::min(sizeof(word_type), byte_count - offset));
+            }
+#else
+            for (size_t byte = 0; byte < byte_count; ++byte)
+            {
+                const word_type word = mask.word(byte / sizeof(word_type));
+                position[byte] =
+                    static_cast<unsigned char>(word >> (8 * (byte % sizeof(word_type))));
+            }
+#endif
+            position += byte_count;
+            break;
+        }
+    }
+    return static_cast<size_t>(position - output);
+}
+
+/// Reads a set encoded by `encode` from `size` bytes at `input` into `set`, a `bit_mask` or a
+/// set of values of the same universe as the encoded set, and returns the number of bytes read.
+/// Consecutive sets can be decoded from a buffer by advancing `input` by the returned size.
+/// Returns zero, leaving `set` unchanged, if the bytes are truncated or malformed, or hold an
+/// element outside of the universe, regardless of `ENUM_SET_BOUNDS_CHECK`.
+/// The elements are written straight into the storage words: the dense encoding a byte at a
+/// time, the delta encoding a bit at a time and the run length encoding a word at a time.
+template <typename Set>
+size_t try_decode(unsigned char const* input, size_t size, Set& set) noexcept
+{
+    using mask_type = detail::codec_mask_t<Set>;
+    using word_type = typename mask_type::word_type;
+    constexpr size_t universe = detail::codec_mask_size<mask_type>::value;
+    constexpr size_t word_size = mask_type::word_size;
+    unsigned char const* position = input;
+    unsigned char const* const end = input + size;
+    word_type words[mask_type::word_count] = {};
+    if (size == 0)
+    {
+        return 0;
+    }
+    switch (static_cast<set_encoding>(*position++))
+    {
+        case set_encoding::dense:
+        {
+            if (size < 1 + (universe + 7) / 8)
+            {
+                return 0;
+            }
+            constexpr size_t byte_count = (universe + 7) / 8;
+#if ENUM_SET_LITTLE_ENDIAN
+            std::memcpy(words, position, byte_count);
+#else
+            constexpr size_t full_words = byte_count / sizeof(word_type);
+            for (size_t index = 0; index < full_words; ++index)
+            {
+                word_type bits = 0;
+                for (size_t byte = 0; byte < sizeof(word_type); ++byte)
+                {
+                    bits = static_cast<word_type>(bits | static_cast<word_type>(
+                        static_cast<word_type>(position[index * sizeof(word_type) + byte])
+                            << (8 * byte)));
+                }
+                words[index] = bits;
+            }
+            for (size_t byte = full_words * sizeof(word_type); byte < byte_count; ++byte)
+            {
+                words[full_words] = static_cast<word_type>(words[full_words]
+                  | static_cast<word_type>(static_cast<word_type>(position[byte])
+                        << (8 * (byte % sizeof(word_type)))));
+            }
+#endif
+            position += byte_count;
+            break;
+        }
+        case set_encoding::delta:
+        {
+            uint64_t count = 0;
+            if (!detail::load_varint(position, end, count) || count > universe)
+            {
+                return 0;
+            }
+            size_t next = 0;
+            for (uint64_t element = 0; element < count; ++element)
+            {
+                uint64_t gap = 0;
+                if (!detail::load_varint(position, end, gap) || gap >= universe - next)
+                {
+                    return 0;
+                }
+                const size_t index = next + static_cast<size_t>(gap);
+                words[index / word_size] = static_cast<word_type>(words[index / word_size]
+                  | static_cast<word_type>(word_type{1} << (index % word_size)));
+                next = index + 1;
+            }
+            break;
+        }
+        case set_encoding::runs:
+        {
+            uint64_t count = 0;
+            if (!detail::load_varint(position, end, count) || count > (universe + 1) / 2)
+            {
+                return 0;
+            }
+            size_t next = 0;
+            for (uint64_t run = 0; run < count; ++run)
+            {
+                uint64_t gap = 0;
+                uint64_t length = 0;
+                if (!detail::load_varint(position, end, gap) || gap >= universe - next
+                 || !detail::load_varint(position, end, length)
+                 || length >= universe - next - gap)
+                {
+                    return 0;
+                }
+                const size_t start = next + static_cast<size_t>(gap);
+                next = start + static_cast<size_t>(length) + 1;
+                detail::fill_bits<word_type, word_size>(words, start, next);
+            }
+            break;
+        }
+        default:
+            return 0;
+    }
+    mask_type mask{};
+    for (size_t index = 0; index < mask_type::word_count; ++index)
+    {
+        mask.set_word(index, words[index]);
+    }
+    detail::codec_assign(set, mask);
+    return static_cast<size_t>(position - input);
+}
+
+/// Reads a set encoded by `encode`, see `try_decode`.
+/// Bytes that cannot be decoded are handled according to `ENUM_SET_BOUNDS_CHECK`,
+/// which by default throws an `std::out_of_range` exception.
+template <typename Set>
+size_t decode(unsigned char const* input, size_t size, Set& set)
+{
+    const size_t read = try_decode(input, size, set);
+    detail::check_bounds(read != 0, "decode malformed input");
+    return read;
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_CODEC_HPP
@@ -0,0 +1,504 @@
+#ifndef ENUM_SET_COLUMNAR_HPP
+#define ENUM_SET_COLUMNAR_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/dynamic_index_set.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/value_set_view.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Magic number starting every block of a columnar file, the bytes `ESCOLUMN` read least
+/// significant byte first.
+constexpr uint64_t columnar_magic = 0x4E4D554C4F435345ULL;
+
+/// Flag of a columnar block that carries a bitmap per value after its rows.
+constexpr uint64_t columnar_has_bitmaps = 1;
+
+/// Returns `size` rounded up to a multiple of eight bytes.
+constexpr size_t columnar_padded(size_t size) noexcept
+{
+    return (size + 7) / 8 * 8;
+}
+
+}  // namespace detail
+
+/// Describes the stable binary layout of a columnar file holding a sequence of sets of values,
+/// written by `columnar_writer` and read by `columnar_reader`.
+/// A file is a sequence of blocks, each being
+/// - a header of `header_size` bytes, made of eight byte integers, least significant byte first:
+///   the magic number `ESCOLUMN`, the `fingerprint` of the universe (see `set_layout`), the
+///   number of rows, the flags, and the number of rows containing each value of the universe,
+/// - the rows, `row_size` bytes each, every row being the elements of a set as in `set_layout`,
+///   padded with zeros to a multiple of eight bytes,
+/// - if the bitmaps flag is set, one bitmap per value of the universe, in the order of the
+///   universe, with bit `r % 8` of byte `r / 8` set if row `r` of the block contains the value,
+///   padded with zeros to a multiple of eight bytes.
+/// Every section starts at a multiple of eight bytes from the start of its block.
+/// The bitmaps duplicate the rows, in exchange a single value can be projected by reading only
+/// its own bitmap.
+template <typename Set>
+struct columnar_layout
+{
+    /// Layout of a single set, see `set_layout`.
+    using element_layout = set_layout<Set>;
+
+    /// Set type that is materialized from the rows.
+    using set_type = typename element_layout::set_type;
+
+    /// Type of the values of the sets.
+    using value_type = typename element_layout::value_type;
+
+    /// Number of possible elements of each set.
+    static constexpr size_t capacity{element_layout::capacity};
+
+    /// Number of bytes of a row.
+    static constexpr size_t row_size{(capacity + 7) / 8};
+
+    /// Number of bytes of a block header.
+    static constexpr size_t header_size{8 * (4 + capacity)};
+
+    /// Returns the number of bytes of the rows of a block of `row_count` rows.
+    static constexpr size_t rows_size(size_t row_count) noexcept
+    {
+        return detail::columnar_padded(row_count * row_size);
+    }
+
+    /// Returns the number of bytes of the bitmap of a single value of a block of `row_count` rows.
+    static constexpr size_t bitmap_size(size_t row_count) noexcept
+    {
+        return detail::columnar_padded((row_count + 7) / 8);
+    }
+
+    /// Returns the number of bytes of a block of `row_count` rows, with or without bitmaps.
+    static constexpr size_t block_size(size_t row_count, bool bitmaps) noexcept
+    {
+        return header_size + rows_size(row_count)
+             + (bitmaps ? capacity * bitmap_size(row_count) : 0);
+    }
+};
+
+template <typename Set>
+constexpr size_t columnar_layout<Set>::capacity;
+
+template <typename Set>
+constexpr size_t columnar_layout<Set>::row_size;
+
+template <typename Set>
+constexpr size_t columnar_layout<Set>::header_size;
+
+/// Writes a sequence of sets of values to a stream in the columnar layout (see `columnar_layout`).
+/// Rows are buffered until a block of `block_rows` rows is complete, only the pending block is
+/// held in memory, so arbitrarily long sequences can be written. The last incomplete block is
+/// written by `flush()`, or on destruction (where errors are ignored). Stream failures throw an
+/// `std::ios_base::failure` (aborting if exceptions are disabled), or are reported by the return
+/// value of `try_write()` and `try_flush()`.
+/// `Set` is the `value_set` (or type set of values) of the rows.
+template <typename Set>
+class columnar_writer
+{
+public:
+    using layout = columnar_layout<Set>;
+
+    /// Default number of rows of a block.
+    static constexpr size_t default_block_rows{65536};
+private:
+    /// Stream the blocks are written to.
+    std::ostream* output;
+
+    /// Number of rows of a complete block.
+    size_t block_rows;
+
+    /// Whether the blocks carry a bitmap per value.
+    bool bitmaps;
+
+    /// Number of rows written to the stream.
+    size_t flushed_rows;
+
+    /// Elements of the rows of the pending block.
+    std::vector<unsigned char> rows;
+
+    /// Returns the number of rows of the pending block.
+    size_t pending_rows() const noexcept
+    {
+        return layout::row_size == 0 ? 0 : rows.size() / layout::row_size;
+    }
+public:
+    /// Constructs a writer to `output`, writing blocks of `block_rows` rows, carrying a bitmap
+    /// per value if `bitmaps` is `true`.
+    /// A `block_rows` of zero is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    explicit columnar_writer(
+        std::ostream& output, bool bitmaps = true, size_t block_rows = default_block_rows)
+        : output{&output}
+        , block_rows{block_rows}
+        , bitmaps{bitmaps}
+        , flushed_rows{0}
+        , rows{}
+    {
+        detail::check_bounds(block_rows != 0, "columnar_writer blocks must hold rows");
+    }
+
+    // The usual suspects.
+    columnar_writer(columnar_writer const&)            = delete;
+    columnar_writer& operator=(columnar_writer const&) = delete;
+    columnar_writer(columnar_writer&&) noexcept        = default;
+
+    /// Writes the pending block, ignoring errors.
+    ~columnar_writer() noexcept
+    {
+#if ENUM_SET_HAS_EXCEPTIONS
+        // The stream may be set to throw, which must not escape the destructor.
+        try
+        {
+            try_flush();
+        }
+        catch (...)
+        {
+        }
+#else
+        try_flush();
+#endif
+    }
+
+    /// Appends a set as the next row, and writes the block if it is complete.
+    /// Returns `false` if the stream fails, otherwise `true`.
+    bool try_write(Set const& set)
+    {
+        const size_t offset = rows.size();
+        rows.resize(offset + layout::row_size);
+        detail::store_elements(set, rows.data() + offset);
+        return pending_rows() < block_rows || try_flush();
+    }
+
+    /// Appends a set as the next row, and writes the block if it is complete.
+    /// Throws `std::ios_base::failure` if the stream fails.
+    void write(Set const& set)
+    {
+        if (!try_write(set))
+        {
+            detail::throw_exception<std::ios_base::failure>(
+                "columnar_writer failed to write a block");
+        }
+    }
+
+    /// Writes the pending rows as a block, does nothing if there are none.
+    /// Throws `std::ios_base::failure` if the stream fails.
+    void flush()
+    {
+        if (!try_flush())
+        {
+            detail::throw_exception<std::ios_base::failure>(
+                "columnar_writer failed to write a block");
+        }
+    }
+
+    /// Writes the pending rows as a block, does nothing if there are none.
+    /// Returns `false` if the stream fails, keeping the rows pending, otherwise `true`.
+    bool try_flush()
+    {
+        const size_t row_count = pending_rows();
+        if (row_count == 0)
+        {
+            return true;
+        }
+        const size_t rows_offset = layout::header_size;
+        const size_t bitmaps_offset = rows_offset + layout::rows_size(row_count);
+        const size_t bitmap_size = layout::bitmap_size(row_count);
+        std::vector<unsigned char> block(layout::block_size(row_count, bitmaps), 0);
+        std::vector<size_t> counts(layout::capacity, 0);
+        for (size_t row = 0; row < row_count; ++row)
+        {
+            for (size_t byte = 0; byte < layout::row_size; ++byte)
+            {
+                for (uint8_t bits = rows[row * layout::row_size + byte]; bits != 0;
+                     bits = detail::clear_lowest(bits))
+                {
+                    const size_t index = 8 * byte + detail::count_trailing_zeros(bits);
+                    ++counts[index];
+                    if (bitmaps)
+                    {
+                        block[bitmaps_offset + index * bitmap_size + row / 8] |=
+                            static_cast<unsigned char>(1U << (row % 8));
+                    }
+                }
+            }
+        }
+        detail::store_little_endian(detail::columnar_magic, block.data());
+        detail::store_little_endian(layout::element_layout::fingerprint, block.data() + 8);
+        detail::store_little_endian(row_count, block.data() + 16);
+        detail::store_little_endian(bitmaps ? detail::columnar_has_bitmaps : 0, block.data() + 24);
+        for (size_t index = 0; index < layout::capacity; ++index)
+        {
+            detail::store_little_endian(counts[index], block.data() + 32 + 8 * index);
+        }
+        std::copy(rows.begin(), rows.end(), block.begin() + rows_offset);
+        output->write(reinterpret_cast<char const*>(block.data()),
+                      static_cast<std::streamsize>(block.size()));
+        if (!*output)
+        {
+            return false;
+        }
+        flushed_rows += row_count;
+        rows.clear();
+        return true;
+    }
+
+    /// Returns the number of rows written so far, including the pending ones.
+    size_t size() const noexcept
+    {
+        return flushed_rows + pending_rows();
+    }
+
+}; // class columnar_writer
+
+template <typename Set>
+constexpr size_t columnar_writer<Set>::default_block_rows;
+
+/// Read only access to a sequence of sets of values in the columnar layout (see
+/// `columnar_layout`), reading the rows in place from the bytes, e.g. from a file mapped into
+/// memory. Only the block headers are read on construction, they are checked for a magic number,
+/// the fingerprint of the universe of `Set`, and sizes fitting the bytes; bytes that are rejected
+/// are handled according to `ENUM_SET_BOUNDS_CHECK`, which by default throws an
+/// `std::out_of_range` exception.
+/// Projecting a single value (`count`, `column`, `visit_rows`) reads only the block headers and
+/// the bitmaps of that value in blocks that have them, and a single byte per row otherwise.
+/// The reader refers to the bytes, so it must not outlive them.
+template <typename Set>
+class columnar_reader
+{
+public:
+    using layout = columnar_layout<Set>;
+
+    /// Set type that is materialized from the rows.
+    using set_type = typename layout::set_type;
+
+    /// Type of the values of the sets.
+    using value_type = typename layout::value_type;
+private:
+    /// Location of a block in the bytes.
+    struct block
+    {
+        /// Start of the block header.
+        unsigned char const* data;
+        /// Index of the first row of the block in the whole sequence.
+        size_t first_row;
+        /// Number of rows of the block.
+        size_t row_count;
+        /// Whether the block carries a bitmap per value.
+        bool bitmaps;
+    };
+
+    /// Blocks of the sequence, in order.
+    std::vector<block> blocks;
+
+    /// Number of rows of all blocks.
+    size_t row_count;
+
+    /// Returns the block containing `row`, which must be less than `size()`.
+    block const& block_of(size_t row) const noexcept
+    {
+        return *(std::upper_bound(blocks.begin(), blocks.end(), row,
+            [](size_t target, block const& candidate)
+            {
+                return target < candidate.first_row;
+            }) - 1);
+    }
+
+    /// Returns the elements of row `row` of block `source`.
+    static unsigned char const* row_data(block const& source, size_t row) noexcept
+    {
+        return source.data + layout::header_size + row * layout::row_size;
+    }
+
+    /// Returns the bitmap of the value at `index` of block `source`, which must have bitmaps.
+    static unsigned char const* bitmap_data(block const& source, size_t index) noexcept
+    {
+        return source.data + layout::header_size + layout::rows_size(source.row_count)
+             + index * layout::bitmap_size(source.row_count);
+    }
+
+    /// Calls `visitor` with the index of every row of block `source` containing the value at
+    /// `index`, in increasing order.
+    template <typename Visitor>
+    static void visit_block(block const& source, size_t index, Visitor& visitor)
+    {
+        if (source.bitmaps)
+        {
+            unsigned char const* bitmap = bitmap_data(source, index);
+            const size_t bytes = (source.row_count + 7) / 8;
+            for (size_t byte = 0; byte < bytes; ++byte)
+            {
+                // Mask the padding bits past the last row, which only a damaged block sets.
+                const size_t rows = (byte + 1 < bytes) ? 8 : source.row_count - 8 * byte;
+                const auto mask = static_cast<uint8_t>(0xFFU >> (8 - rows));
+                for (auto bits = static_cast<uint8_t>(bitmap[byte] & mask); bits != 0;
+                     bits = detail::clear_lowest(bits))
+                {
+                    visitor(source.first_row + 8 * byte + detail::count_trailing_zeros(bits));
+                }
+            }
+        }
+        else
+        {
+            for (size_t row = 0; row < source.row_count; ++row)
+            {
+                if (((row_data(source, row)[index / 8] >> (index % 8)) & 1) != 0)
+                {
+                    visitor(source.first_row + row);
+                }
+            }
+        }
+    }
+public:
+    /// Constructs a reader of `size` bytes at `data`, reading the block headers.
+    columnar_reader(unsigned char const* data, size_t size)
+        : blocks{}
+        , row_count{0}
+    {
+        size_t offset = 0;
+        while (offset < size)
+        {
+            unsigned char const* header = data + offset;
+            detail::check_bounds(size - offset >= layout::header_size,
+                "columnar_reader truncated block header");
+            detail::check_bounds(detail::load_little_endian(header) == detail::columnar_magic,
+                "columnar_reader magic number mismatch");
+            detail::check_bounds(
+                detail::load_little_endian(header + 8) == layout::element_layout::fingerprint,
+                "columnar_reader fingerprint mismatch");
+            const uint64_t rows = detail::load_little_endian(header + 16);
+            const bool bitmaps =
+                (detail::load_little_endian(header + 24) & detail::columnar_has_bitmaps) != 0;
+            detail::check_bounds(
+                rows <= (size - offset) / (layout::row_size == 0 ? 1 : layout::row_size)
+             && layout::block_size(static_cast<size_t>(rows), bitmaps) <= size - offset,
+                "columnar_reader truncated block");
+            blocks.push_back({header, row_count, static_cast<size_t>(rows), bitmaps});
+            row_count += static_cast<size_t>(rows);
+            offset += layout::block_size(static_cast<size_t>(rows), bitmaps);
+        }
+    }
+
+    // The usual suspects.
+    columnar_reader(columnar_reader const&)            = default;
+    columnar_reader(columnar_reader&&) noexcept        = default;
+    columnar_reader& operator=(columnar_reader const&) = default;
+    columnar_reader& operator=(columnar_reader&&)      = default;
+    ~columnar_reader() noexcept                        = default;
+
+    /// Returns the number of rows.
+    size_t size() const noexcept
+    {
+        return row_count;
+    }
+
+    /// Checks if there are no rows.
+    bool empty() const noexcept
+    {
+        return row_count == 0;
+    }
+
+    /// Returns the number of blocks.
+    size_t block_count() const noexcept
+    {
+        return blocks.size();
+    }
+
+    /// Returns a copy of the set at row `index`.
+    /// An `index` greater or equal to `size()` is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    set_type row(size_t index) const
+    {
+        detail::check_bounds(index < row_count, "columnar_reader row out of range");
+        block const& source = block_of(index);
+        return detail::load_elements<Set>(row_data(source, index - source.first_row));
+    }
+
+    /// Checks if the set at `row` contains a value known at runtime.
+    /// Returns `false` for rows greater or equal to `size()` and for invalid values.
+    bool has(size_t row, value_type value) const noexcept
+    {
+        const size_t index = layout::element_layout::index(value);
+        if (row >= row_count || index >= layout::capacity)
+        {
+            return false;
+        }
+        block const& source = block_of(row);
+        return ((row_data(source, row - source.first_row)[index / 8] >> (index % 8)) & 1) != 0;
+    }
+
+    /// Returns the number of rows containing a value known at runtime, from the block headers.
+    /// Returns zero for invalid values.
+    size_t count(value_type value) const noexcept
+    {
+        const size_t index = layout::element_layout::index(value);
+        size_t result = 0;
+        for (size_t current = 0; index < layout::capacity && current < blocks.size(); ++current)
+        {
+            result += static_cast<size_t>(
+                detail::load_little_endian(blocks[current].data + 32 + 8 * index));
+        }
+        return result;
+    }
+
+    /// Returns the number of rows containing the value `Value`, see `count(value)`.
+    template <value_type Value>
+    size_t count() const noexcept
+    {
+        return count(Value);
+    }
+
+    /// Calls `visitor` with the index of every row containing a value known at runtime,
+    /// in increasing order. Does nothing for invalid values.
+    template <typename Visitor>
+    void visit_rows(value_type value, Visitor&& visitor) const
+    {
+        const size_t index = layout::element_layout::index(value);
+        for (size_t current = 0; index < layout::capacity && current < blocks.size(); ++current)
+        {
+            visit_block(blocks[current], index, visitor);
+        }
+    }
+
+    /// Calls `visitor` with the index of every row containing the value `Value`,
+    /// see `visit_rows(value, visitor)`.
+    template <value_type Value, typename Visitor>
+    void visit_rows(Visitor&& visitor) const
+    {
+        visit_rows(Value, std::forward<Visitor>(visitor));
+    }
+
+    /// Returns the column of a value known at runtime, the set of the indices of the rows
+    /// containing it, with a capacity of `size()`. Returns an empty set for invalid values.
+    dynamic_index_set column(value_type value) const
+    {
+        dynamic_index_set result(row_count);
+        visit_rows(value, [&result](size_t row)
+        {
+            result.add(row);
+        });
+        return result;
+    }
+
+    /// Returns the column of the value `Value`, see `column(value)`.
+    template <value_type Value>
+    dynamic_index_set column() const
+    {
+        return column(Value);
+    }
+
+}; // class columnar_reader
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_COLUMNAR_HPP
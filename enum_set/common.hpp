@@ -1,9 +1,9 @@
 #ifndef ENUM_SET_COMMON_HPP
 #define ENUM_SET_COMMON_HPP
 
+#include <enum_set/bounds_check.hpp>
 #include <enum_set/standard_types.hpp>
 
-#include <stdexcept>
 #include <type_traits>
 
 namespace enum_set
@@ -93,21 +93,34 @@ constexpr size_t index_of_value(Type value) noexcept
     return 1 + index_of_value<Type, Rest...>(value);
 }
 
+/// Compile time table of a list of `Values...`, giving constant time access to a value by index.
+/// There is one table for each distinct list of values, shared across translation units.
+template <typename Type, Type... Values>
+struct value_table
+{
+    static constexpr Type values[sizeof...(Values)] = {Values...};
+};
+
+template <typename Type, Type... Values>
+constexpr Type value_table<Type, Values...>::values[sizeof...(Values)];
+
 /// Base case for `get_value` below when the list of values is empty.
-/// Calling this indicates a programming error and throws an exception.
+/// Calling this indicates a programming error and is handled according to `ENUM_SET_BOUNDS_CHECK`.
 template <typename Type>
 constexpr Type get_value(size_t)
 {
-    throw std::out_of_range("value_set get_value out of range");
+    check_bounds(false, "value_set get_value out of range");
+    return Type{};
 }
 
 /// Gets the value at `index` in the compile time list of values `[First, Rest...]`.
-/// If the `index` is out of bounds, an exception is thrown.
-/// Complexity is linear in the length of the list of values.
+/// If the `index` is out of bounds, see `ENUM_SET_BOUNDS_CHECK` for what happens.
+/// Complexity is constant, the value is read from the `value_table` of the values.
 template <typename Type, Type First, Type... Rest>
 constexpr Type get_value(size_t index)
 {
-    return (index == 0) ? First : get_value<Type, Rest...>(index - 1);
+    check_bounds(index < 1 + sizeof...(Rest), "value_set get_value out of range");
+    return value_table<Type, First, Rest...>::values[index];
 }
 
 }  // namespace detail
@@ -0,0 +1,256 @@
+#ifndef ENUM_SET_COPY_ON_WRITE_HPP
+#define ENUM_SET_COPY_ON_WRITE_HPP
+
+#include <enum_set/standard_types.hpp>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace enum_set
+{
+
+/// Number of times the sets of a `copy_on_write` type were shared and cloned.
+struct copy_on_write_counters
+{
+    /// Number of copies that only shared the storage of another set.
+    size_t shares;
+    /// Number of times the storage was cloned because a shared set was modified.
+    size_t clones;
+};
+
+/// Wraps a large set (e.g. an `index_set` or a `bit_mask` of many kilobytes) in shared storage,
+/// so that copying it only increments a reference count. The storage is cloned when a set that
+/// shares its storage with another copy is modified, either through `mutate()` or the in place
+/// operators. Use it to hand read mostly sets between stages of a pipeline or to keep snapshots.
+/// The `counters()` tell how many copies were shared and how many storages were cloned.
+/// Different copies can be read and modified from different threads, like a `std::shared_ptr`,
+/// but a single copy must not be modified concurrently with any other access to it.
+/// A moved from `copy_on_write` has no storage, and can only be assigned to or destroyed.
+template <typename Set>
+class copy_on_write
+{
+private:
+    /// Shared storage of the set.
+    std::shared_ptr<Set> storage;
+
+    /// Counters of all `copy_on_write<Set>`, see `copy_on_write_counters`.
+    static std::atomic<size_t> share_count;
+    static std::atomic<size_t> clone_count;
+
+    /// Constructs a copy on write set from storage.
+    explicit copy_on_write(std::shared_ptr<Set>&& shared) noexcept
+        : storage{std::move(shared)}
+    {
+    }
+public:
+    /// Constructs an empty (default constructed) set.
+    copy_on_write()
+        : storage{std::make_shared<Set>()}
+    {
+    }
+
+    /// Constructs a copy on write set holding a copy of a set.
+    explicit copy_on_write(Set const& set)
+        : storage{std::make_shared<Set>(set)}
+    {
+    }
+
+    /// Copies a set by sharing its storage.
+    copy_on_write(copy_on_write const& another) noexcept
+        : storage{another.storage}
+    {
+        share_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Copies a set by sharing its storage.
+    copy_on_write& operator=(copy_on_write const& another) noexcept
+    {
+        if (storage != another.storage)
+        {
+            storage = another.storage;
+            share_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    // The usual suspects.
+    copy_on_write(copy_on_write&&) noexcept            = default;
+    copy_on_write& operator=(copy_on_write&&) noexcept = default;
+    ~copy_on_write() noexcept                          = default;
+
+    /// Returns the set for reading.
+    /// The reference is invalidated by the next modification of this copy.
+    Set const& get() const noexcept
+    {
+        return *storage;
+    }
+
+    /// Returns the set for reading, see `get()`.
+    Set const& operator*() const noexcept
+    {
+        return *storage;
+    }
+
+    /// Accesses the members of the set for reading, see `get()`.
+    Set const* operator->() const noexcept
+    {
+        return storage.get();
+    }
+
+    /// Returns the set for modification, cloning the storage first if it is shared.
+    /// The reference is invalidated by the next copy of this copy on write set.
+    Set& mutate()
+    {
+        if (storage.use_count() > 1)
+        {
+            storage = std::make_shared<Set>(*storage);
+            clone_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return *storage;
+    }
+
+    /// Returns `true` if the storage is shared with another copy, otherwise `false`.
+    bool is_shared() const noexcept
+    {
+        return storage.use_count() > 1;
+    }
+
+    /// Returns `true` if both copy on write sets share the same storage, otherwise `false`.
+    bool shares_with(copy_on_write const& another) const noexcept
+    {
+        return storage == another.storage;
+    }
+
+    /// Returns the counters of all copy on write sets of type `Set`.
+    static copy_on_write_counters counters() noexcept
+    {
+        return {
+            share_count.load(std::memory_order_relaxed),
+            clone_count.load(std::memory_order_relaxed)
+        };
+    }
+
+    /// Resets the counters of all copy on write sets of type `Set`.
+    static void reset_counters() noexcept
+    {
+        share_count.store(0, std::memory_order_relaxed);
+        clone_count.store(0, std::memory_order_relaxed);
+    }
+
+    /// Adds all elements of another set to this.
+    /// Does not clone if both share the same storage, since the union with itself is a no-op.
+    copy_on_write& operator|= (copy_on_write const& another)
+    {
+        if (!shares_with(another))
+        {
+            mutate() |= another.get();
+        }
+        return *this;
+    }
+
+    /// Restricts the elements of this set to those contained in another.
+    /// Does not clone if both share the same storage, since the intersection with itself is a
+    /// no-op.
+    copy_on_write& operator&= (copy_on_write const& another)
+    {
+        if (!shares_with(another))
+        {
+            mutate() &= another.get();
+        }
+        return *this;
+    }
+
+    /// Removes all elements in this set that are contained in another.
+    /// Replaces the storage by an empty set if both share the same storage.
+    copy_on_write& operator/= (copy_on_write const& another)
+    {
+        if (shares_with(another))
+        {
+            storage = std::make_shared<Set>();
+        }
+        else
+        {
+            mutate() /= another.get();
+        }
+        return *this;
+    }
+
+    /// Keeps the elements contained in exactly one of this and another set.
+    /// Replaces the storage by an empty set if both share the same storage.
+    copy_on_write& operator^= (copy_on_write const& another)
+    {
+        if (shares_with(another))
+        {
+            storage = std::make_shared<Set>();
+        }
+        else
+        {
+            mutate() ^= another.get();
+        }
+        return *this;
+    }
+
+    /// Returns the set union of two copy on write sets, in new storage.
+    friend copy_on_write operator| (copy_on_write const& first, copy_on_write const& second)
+    {
+        auto result = std::make_shared<Set>(first.get());
+        *result |= second.get();
+        return copy_on_write(std::move(result));
+    }
+
+    /// Returns the set intersection of two copy on write sets, in new storage.
+    friend copy_on_write operator& (copy_on_write const& first, copy_on_write const& second)
+    {
+        auto result = std::make_shared<Set>(first.get());
+        *result &= second.get();
+        return copy_on_write(std::move(result));
+    }
+
+    /// Returns the set difference between two copy on write sets, in new storage.
+    friend copy_on_write operator/ (copy_on_write const& first, copy_on_write const& second)
+    {
+        auto result = std::make_shared<Set>(first.get());
+        *result /= second.get();
+        return copy_on_write(std::move(result));
+    }
+
+    /// Returns the symmetric set difference between two copy on write sets, in new storage.
+    friend copy_on_write operator^ (copy_on_write const& first, copy_on_write const& second)
+    {
+        auto result = std::make_shared<Set>(first.get());
+        *result ^= second.get();
+        return copy_on_write(std::move(result));
+    }
+
+    /// Checks for equality between two copy on write sets.
+    /// Returns immediately if both share the same storage.
+    friend bool operator== (copy_on_write const& first, copy_on_write const& second)
+    {
+        return first.shares_with(second) || first.get() == second.get();
+    }
+
+    /// Checks for inequality between two copy on write sets.
+    friend bool operator!= (copy_on_write const& first, copy_on_write const& second)
+    {
+        return !(first == second);
+    }
+
+}; // class copy_on_write
+
+template <typename Set>
+std::atomic<size_t> copy_on_write<Set>::share_count{0};
+
+template <typename Set>
+std::atomic<size_t> copy_on_write<Set>::clone_count{0};
+
+/// Creates a copy on write set from a set.
+template <typename Set>
+copy_on_write<Set> make_copy_on_write(Set const& set)
+{
+    return copy_on_write<Set>(set);
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_COPY_ON_WRITE_HPP
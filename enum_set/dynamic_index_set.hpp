@@ -0,0 +1,548 @@
+#ifndef ENUM_SET_DYNAMIC_INDEX_SET_HPP
+#define ENUM_SET_DYNAMIC_INDEX_SET_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/word_kernels.hpp>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+
+namespace enum_set
+{
+
+/// Represents a set of indices from the universe `[0, capacity())`, where the capacity is given
+/// at runtime (e.g. read from configuration) instead of at compile time like `index_set`.
+/// Capacities up to `inline_capacity` bits are stored inline, larger capacities in a heap
+/// allocated array of words, allocated once on construction.
+/// Moving never allocates, and neither do the in place operators (e.g. `|=`) or copy assignment
+/// between sets of equal capacity. The binary operators (e.g. `|`) allocate the result if it
+/// does not fit inline, so prefer the in place operators for large capacities.
+/// Set operations and comparisons between sets of different capacities, and providing an invalid
+/// index to a runtime method, are handled according to `ENUM_SET_BOUNDS_CHECK`, which by default
+/// throws an `std::out_of_range` exception.
+class dynamic_index_set
+{
+public:
+    /// Storage word type.
+    using word_type = uint64_t;
+
+    /// Number of bits in a storage word.
+    static constexpr size_t word_size{64};
+
+    /// Largest capacity stored inline, without allocating.
+    static constexpr size_t inline_capacity{128};
+
+    /// Forward declaration of an iterator class.
+    /// See `dynamic_index_set_iterator.hpp` for details.
+    class iterator;
+
+    /// Iterator visiting the elements in reverse order.
+    using reverse_iterator = std::reverse_iterator<iterator>;
+private:
+    /// Number of storage words stored inline.
+    static constexpr size_t inline_words{inline_capacity / word_size};
+
+    /// Number of possible elements.
+    size_t universe;
+
+    /// Words stored inline if the capacity is at most `inline_capacity`, otherwise on the heap.
+    union
+    {
+        word_type buffer[inline_words];
+        word_type* heap;
+    };
+
+    /// Returns `true` if the words are stored inline.
+    bool is_inline_storage() const noexcept
+    {
+        return universe <= inline_capacity;
+    }
+
+    /// Returns the number of storage words.
+    size_t word_count() const noexcept
+    {
+        return (universe + word_size - 1) / word_size;
+    }
+
+    /// Returns the storage words.
+    word_type* words() noexcept
+    {
+        return is_inline_storage() ? buffer : heap;
+    }
+
+    /// Returns the storage words.
+    word_type const* words() const noexcept
+    {
+        return is_inline_storage() ? buffer : heap;
+    }
+
+    /// Returns the bits of the last word that represent elements.
+    word_type tail_mask() const noexcept
+    {
+        return (universe % word_size == 0)
+            ? static_cast<word_type>(~word_type{0})
+            : detail::mask_to<word_type>(universe % word_size - 1);
+    }
+
+    /// Releases heap storage, if any, and makes this an empty set of capacity zero.
+    void release() noexcept
+    {
+        if (!is_inline_storage())
+        {
+            delete[] heap;
+        }
+        universe = 0;
+        buffer[0] = 0;
+        buffer[1] = 0;
+    }
+
+    /// Takes over the storage of another set, leaving it empty with capacity zero.
+    void steal(dynamic_index_set& another) noexcept
+    {
+        universe = another.universe;
+        if (is_inline_storage())
+        {
+            buffer[0] = another.buffer[0];
+            buffer[1] = another.buffer[1];
+        }
+        else
+        {
+            heap = another.heap;
+        }
+        another.universe = 0;
+        another.buffer[0] = 0;
+        another.buffer[1] = 0;
+    }
+
+    /// Checks that another set has the same capacity as this.
+    void check_capacity(dynamic_index_set const& another) const
+    {
+        detail::check_bounds(
+            universe == another.universe, "dynamic_index_set capacities do not match");
+    }
+
+    /// Finds the first element greater or equal to an `offset`, returns the capacity if none.
+    size_t find_next(size_t offset) const noexcept
+    {
+        if (offset >= universe)
+        {
+            return universe;
+        }
+        size_t index = offset / word_size;
+        word_type bits = words()[index] & detail::mask_from<word_type>(offset % word_size);
+        while (bits == 0)
+        {
+            if (++index == word_count())
+            {
+                return universe;
+            }
+            bits = words()[index];
+        }
+        return index * word_size + detail::count_trailing_zeros(bits);
+    }
+
+    /// Finds the last element strictly less than an `offset`, returns the capacity if none.
+    size_t find_prev(size_t offset) const noexcept
+    {
+        if (offset == 0 || universe == 0)
+        {
+            return universe;
+        }
+        const size_t last = std::min(offset, universe) - 1;
+        size_t index = last / word_size;
+        word_type bits = words()[index] & detail::mask_to<word_type>(last % word_size);
+        while (bits == 0)
+        {
+            if (index == 0)
+            {
+                return universe;
+            }
+            bits = words()[--index];
+        }
+        return index * word_size + (word_size - 1 - detail::count_leading_zeros(bits));
+    }
+public:
+    /// Constructs an empty set of capacity zero.
+    dynamic_index_set() noexcept
+        : universe{0}
+        , buffer{0, 0}
+    {
+    }
+
+    /// Constructs an empty set of indices from `[0, capacity)`.
+    /// Allocates if the capacity is larger than `inline_capacity`.
+    explicit dynamic_index_set(size_t capacity)
+        : universe{0}
+        , buffer{0, 0}
+    {
+        if (capacity > inline_capacity)
+        {
+            heap = new word_type[(capacity + word_size - 1) / word_size]();
+        }
+        universe = capacity;
+    }
+
+    /// Constructs a set of indices from `[0, capacity)` holding a list of indices.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    dynamic_index_set(size_t capacity, std::initializer_list<size_t> indices)
+        : dynamic_index_set(capacity)
+    {
+        for (const size_t index : indices)
+        {
+            add(index);
+        }
+    }
+
+    /// Copies a set, allocating if its capacity is larger than `inline_capacity`.
+    dynamic_index_set(dynamic_index_set const& another)
+        : dynamic_index_set(another.universe)
+    {
+        std::copy(another.words(), another.words() + word_count(), words());
+    }
+
+    /// Moves a set without allocating, leaving it empty with capacity zero.
+    dynamic_index_set(dynamic_index_set&& another) noexcept
+        : universe{0}
+        , buffer{0, 0}
+    {
+        steal(another);
+    }
+
+    /// Copies a set, reusing the storage of this set if the capacities are equal.
+    dynamic_index_set& operator=(dynamic_index_set const& another)
+    {
+        if (this != &another)
+        {
+            if (universe != another.universe)
+            {
+                dynamic_index_set copy(another.universe);
+                release();
+                steal(copy);
+            }
+            std::copy(another.words(), another.words() + word_count(), words());
+        }
+        return *this;
+    }
+
+    /// Moves a set without allocating, leaving it empty with capacity zero.
+    dynamic_index_set& operator=(dynamic_index_set&& another) noexcept
+    {
+        if (this != &another)
+        {
+            release();
+            steal(another);
+        }
+        return *this;
+    }
+
+    /// Releases the heap storage, if any.
+    ~dynamic_index_set() noexcept
+    {
+        release();
+    }
+
+    /// Returns an iterator to the first element in the set.
+    /// The iterator refers to the set, see `dynamic_index_set::iterator` for details.
+    iterator begin() const noexcept;
+
+    /// Returns a sentinel iterator representing the end of this set.
+    /// See `begin()` for details.
+    iterator end() const noexcept;
+
+    /// Returns a reverse iterator to the last element in the set.
+    /// See `begin()` for details.
+    reverse_iterator rbegin() const noexcept;
+
+    /// Returns a sentinel reverse iterator representing the end of the reversed set.
+    /// See `begin()` for details.
+    reverse_iterator rend() const noexcept;
+
+    /// Returns the lowest element in the set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t front() const
+    {
+        const size_t position = find_next(0);
+        detail::check_bounds(position < universe, "dynamic_index_set front of empty set");
+        return position;
+    }
+
+    /// Returns the highest element in the set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t back() const
+    {
+        const size_t position = find_prev(universe);
+        detail::check_bounds(position < universe, "dynamic_index_set back of empty set");
+        return position;
+    }
+
+    /// Returns the number of elements in the set less than `index`.
+    /// Indices beyond the capacity count all elements.
+    size_t rank(size_t index) const noexcept
+    {
+        if (index >= universe)
+        {
+            return size();
+        }
+        const size_t last = index / word_size;
+        return detail::word_kernels::popcount(words(), last)
+             + detail::popcount(static_cast<word_type>(
+                   words()[last] & ~detail::mask_from<word_type>(index % word_size)));
+    }
+
+    /// Returns the `k`:th (zero based) element of the set.
+    /// Providing a `k` greater or equal to the size of the set is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    size_t select(size_t k) const
+    {
+        for (size_t index = 0; index < word_count(); ++index)
+        {
+            const size_t bits = detail::popcount(words()[index]);
+            if (k < bits)
+            {
+                return index * word_size + detail::select_in_word(words()[index], k);
+            }
+            k -= bits;
+        }
+        detail::check_bounds(false, "dynamic_index_set select out of range");
+        return universe;
+    }
+
+    /// Checks if the set contains an index.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid indices).
+    bool has(size_t index) const noexcept
+    {
+        return index < universe
+            && (words()[index / word_size] & (word_type{1} << (index % word_size))) != 0;
+    }
+
+    /// Adds an index to the set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void add(size_t index) &
+    {
+        detail::check_bounds(index < universe, "dynamic_index_set add index out of range");
+        words()[index / word_size] |= word_type{1} << (index % word_size);
+    }
+
+    /// Removes an index from the set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void remove(size_t index) &
+    {
+        detail::check_bounds(index < universe, "dynamic_index_set remove index out of range");
+        words()[index / word_size] &= ~(word_type{1} << (index % word_size));
+    }
+
+    /// Adds an index to the set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    bool try_add(size_t index) & noexcept
+    {
+        if (index >= universe)
+        {
+            return false;
+        }
+        words()[index / word_size] |= word_type{1} << (index % word_size);
+        return true;
+    }
+
+    /// Removes an index from the set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    bool try_remove(size_t index) & noexcept
+    {
+        if (index >= universe)
+        {
+            return false;
+        }
+        words()[index / word_size] &= ~(word_type{1} << (index % word_size));
+        return true;
+    }
+
+    /// Writes the elements in increasing order to `output`, at most `capacity` of them, and
+    /// returns the number of elements written. See `bit_mask::to_indices` for details.
+    template <typename Index>
+    size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        return detail::word_kernels::extract(words(), word_count(), output, capacity);
+    }
+
+    /// Returns the total number of possible elements the set can hold.
+    size_t capacity() const noexcept
+    {
+        return universe;
+    }
+
+    /// Returns `true` if the elements are stored inline, `false` if they are on the heap.
+    bool is_inline() const noexcept
+    {
+        return is_inline_storage();
+    }
+
+    /// Returns the number of elements currently being hold by the set.
+    size_t size() const noexcept
+    {
+        return detail::word_kernels::popcount(words(), word_count());
+    }
+
+    /// Works like `size()`, but returns a signed integer instead.
+    ptrdiff_t count() const noexcept
+    {
+        return static_cast<ptrdiff_t>(size());
+    }
+
+    /// Checks if the set is empty.
+    bool empty() const noexcept
+    {
+        return std::all_of(
+            words(), words() + word_count(), [](word_type word) { return word == 0; });
+    }
+
+    /// Erases all elements from the set, keeping its capacity.
+    void clear() noexcept
+    {
+        std::fill(words(), words() + word_count(), word_type{0});
+    }
+
+    /// Inverts the set in place, within its capacity.
+    /// Returns a reference to this set.
+    dynamic_index_set& flip() & noexcept
+    {
+        for (size_t index = 0; index < word_count(); ++index)
+        {
+            words()[index] = ~words()[index];
+        }
+        if (universe > 0)
+        {
+            words()[word_count() - 1] &= tail_mask();
+        }
+        return *this;
+    }
+
+    /// Returns the set complement of a set, within its capacity.
+    dynamic_index_set operator~ () const
+    {
+        dynamic_index_set result(*this);
+        result.flip();
+        return result;
+    }
+
+    /// Adds all elements of another set of equal capacity to this.
+    dynamic_index_set& operator|= (dynamic_index_set const& another) &
+    {
+        check_capacity(another);
+        detail::word_kernels::bitwise_or(words(), another.words(), word_count());
+        return *this;
+    }
+
+    /// Restricts the elements of this set to those contained in another set of equal capacity.
+    dynamic_index_set& operator&= (dynamic_index_set const& another) &
+    {
+        check_capacity(another);
+        detail::word_kernels::bitwise_and(words(), another.words(), word_count());
+        return *this;
+    }
+
+    /// Removes all elements in this set that are contained in another set of equal capacity.
+    dynamic_index_set& operator/= (dynamic_index_set const& another) &
+    {
+        check_capacity(another);
+        detail::word_kernels::bitwise_and_not(words(), another.words(), word_count());
+        return *this;
+    }
+
+    /// Keeps the elements contained in exactly one of this and another set of equal capacity.
+    dynamic_index_set& operator^= (dynamic_index_set const& another) &
+    {
+        check_capacity(another);
+        detail::word_kernels::bitwise_xor(words(), another.words(), word_count());
+        return *this;
+    }
+
+    /// Returns the set union of two sets of equal capacity.
+    friend dynamic_index_set
+    operator| (dynamic_index_set first, dynamic_index_set const& second)
+    {
+        first |= second;
+        return first;
+    }
+
+    /// Returns the set intersection of two sets of equal capacity.
+    friend dynamic_index_set
+    operator& (dynamic_index_set first, dynamic_index_set const& second)
+    {
+        first &= second;
+        return first;
+    }
+
+    /// Returns the set difference between two sets of equal capacity.
+    friend dynamic_index_set
+    operator/ (dynamic_index_set first, dynamic_index_set const& second)
+    {
+        first /= second;
+        return first;
+    }
+
+    /// Returns the symmetric set difference between two sets of equal capacity.
+    friend dynamic_index_set
+    operator^ (dynamic_index_set first, dynamic_index_set const& second)
+    {
+        first ^= second;
+        return first;
+    }
+
+    /// Checks for equality between two sets of equal capacity.
+    friend bool
+    operator== (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        first.check_capacity(second);
+        return detail::word_kernels::equal(first.words(), second.words(), first.word_count());
+    }
+
+    /// Checks for inequality between two sets of equal capacity.
+    friend bool
+    operator!= (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        return !(first == second);
+    }
+
+    /// Checks if a set is a subset of another set of equal capacity.
+    friend bool
+    operator<= (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        first.check_capacity(second);
+        return detail::word_kernels::subset(first.words(), second.words(), first.word_count());
+    }
+
+    /// Checks if a set is a superset of another set of equal capacity.
+    friend bool
+    operator>= (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        return second <= first;
+    }
+
+    /// Checks if a set is a strict subset of another set of equal capacity.
+    friend bool
+    operator< (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        return (first <= second) && (first != second);
+    }
+
+    /// Checks if a set is a strict superset of another set of equal capacity.
+    friend bool
+    operator> (dynamic_index_set const& first, dynamic_index_set const& second)
+    {
+        return second < first;
+    }
+
+}; // class dynamic_index_set
+
+}  // namespace enum_set
+
+#include <enum_set/dynamic_index_set_iterator.hpp>
+
+#endif // ENUM_SET_DYNAMIC_INDEX_SET_HPP
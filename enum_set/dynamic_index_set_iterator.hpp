@@ -0,0 +1,170 @@
+#ifndef ENUM_SET_DYNAMIC_INDEX_SET_ITERATOR_HPP
+#define ENUM_SET_DYNAMIC_INDEX_SET_ITERATOR_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/dynamic_index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <iterator>
+
+namespace enum_set
+{
+
+/// Represents a read only bidirectional iterator to the elements of a dynamic index set.
+/// Works like `index_set::iterator`, and is likewise invalidated when the set is destroyed
+/// or moved from.
+class dynamic_index_set::iterator
+{
+private:
+    /// Dynamic index set being iterated over.
+    dynamic_index_set const* container;
+
+    /// Current element, or the capacity of the set for the end iterator.
+    size_t index;
+
+    /// Members left in the storage word of the current element, the current element included.
+    word_type word;
+
+    /// Moves to the element at `position`, or to the end if `position` is the capacity.
+    void move_to(size_t position) noexcept
+    {
+        index = position;
+        word = (index < container->universe)
+            ? static_cast<word_type>(
+                  container->words()[index / word_size]
+                & detail::mask_from<word_type>(index % word_size))
+            : word_type{0};
+    }
+public:
+    // Adapt to STL iterator interface.
+    // Elements are returned by value, hence there is no pointer type.
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using value_type        = size_t;
+    using pointer           = void;
+    using reference         = size_t;
+
+    // The usual suspects.
+    iterator(iterator const&) noexcept            = default;
+    iterator(iterator&&) noexcept                 = default;
+    iterator& operator=(iterator const&) noexcept = default;
+    iterator& operator=(iterator&&) noexcept      = default;
+    ~iterator() noexcept                          = default;
+
+    /// Constructs a dynamic index set iterator pointing to the first element greater or equal
+    /// to an offset, or the end of sequence sentinel iterator if there is no such element.
+    iterator(dynamic_index_set const& set, size_t offset) noexcept
+        : container{&set}
+        , index{set.universe}
+        , word{0}
+    {
+        move_to(set.find_next(offset));
+    }
+
+    /// Returns the element pointed to by this iterator.
+    /// Dereferencing the end iterator is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t operator*() const
+    {
+        detail::check_bounds(
+            index < container->universe, "dynamic_index_set iterator dereference out of range");
+        return index;
+    }
+
+    /// Increments this iterator.
+    /// If there are no more elements left in the iteratee, the iterator becomes equal to end.
+    /// Incrementing end has no effects.
+    /// Returns a reference to this iterator.
+    iterator& operator++() noexcept
+    {
+        if (index < container->universe)
+        {
+            const size_t word_index = index / word_size;
+            word = detail::clear_lowest(word);
+            if (word != 0)
+            {
+                index = word_index * word_size + detail::count_trailing_zeros(word);
+            }
+            else
+            {
+                move_to(container->find_next((word_index + 1) * word_size));
+            }
+        }
+        return *this;
+    }
+
+    /// Increments this iterator, see `operator++()` for details.
+    /// Returns a copy of this iterator from before the increment.
+    iterator operator++(int) noexcept
+    {
+        iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    /// Decrements this iterator.
+    /// Decrementing end makes the iterator point to the last element, if any.
+    /// Decrementing an iterator pointing to the first element has no effects.
+    /// Returns a reference to this iterator.
+    iterator& operator--() noexcept
+    {
+        const size_t previous = container->find_prev(index);
+        if (previous < container->universe)
+        {
+            move_to(previous);
+        }
+        return *this;
+    }
+
+    /// Decrements this iterator, see `operator--()` for details.
+    /// Returns a copy of this iterator from before the decrement.
+    iterator operator--(int) noexcept
+    {
+        iterator next = *this;
+        --(*this);
+        return next;
+    }
+
+    /// Checks for equality between two iterators.
+    /// Returns `true` if both points to the same element, otherwise `false`.
+    /// Comparing iterators from different sets is only meaningful against `end()`.
+    friend bool
+    operator==(iterator const& first, iterator const& second) noexcept
+    {
+        return first.index == second.index;
+    }
+
+    /// Checks if two iterators are different.
+    /// See `operator==` for details.
+    friend bool
+    operator!=(iterator const& first, iterator const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+}; // class dynamic_index_set::iterator
+
+inline dynamic_index_set::iterator dynamic_index_set::begin() const noexcept
+{
+    return iterator(*this, 0);
+}
+
+inline dynamic_index_set::iterator dynamic_index_set::end() const noexcept
+{
+    return iterator(*this, universe);
+}
+
+inline dynamic_index_set::reverse_iterator dynamic_index_set::rbegin() const noexcept
+{
+    return reverse_iterator(end());
+}
+
+inline dynamic_index_set::reverse_iterator dynamic_index_set::rend() const noexcept
+{
+    return reverse_iterator(begin());
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_DYNAMIC_INDEX_SET_ITERATOR_HPP
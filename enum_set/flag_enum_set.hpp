@@ -0,0 +1,122 @@
+#ifndef ENUM_SET_FLAG_ENUM_SET_HPP
+#define ENUM_SET_FLAG_ENUM_SET_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/value_lookup.hpp>
+#include <enum_set/value_set.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace enum_set
+{
+
+/// Factory for building a `value_set` for a flag enumeration type `Enum`, whose values are
+/// powers of two, terminated by the `Last` flag.
+/// The enumerations of the `Enum = enum [class] { F_0 = 1, F_1 = 2, ..., F_N = 2^N }` are
+/// assumed to be single flags, so that bit `i` of the set is the flag `2^i`.
+/// Performs the map
+///
+///     [Enum, Last] -> value_set<Enum, F_0, F_1, ..., F_N>
+///
+/// `Enum` must be of enumeration type.
+/// `Last` must be the last flag in the `Enum`.
+template <typename Enum, Enum Last>
+struct flag_enum_set_factory
+{
+    static_assert(std::is_enum<Enum>::value,
+                  "flag_enum_set_factory can only be instantiated with an enumeration type");
+
+    using arithmetic_value_type = std::underlying_type_t<Enum>;
+    using bits_type = std::make_unsigned_t<arithmetic_value_type>;
+
+    static constexpr bits_type last_bits = static_cast<bits_type>(Last);
+
+    static_assert(last_bits != 0 && (last_bits & (last_bits - 1)) == 0,
+                  "The last flag of a flag enumeration must be a power of two");
+
+    template <size_t... Positions>
+    static value_set<
+        Enum,
+        static_cast<Enum>(static_cast<arithmetic_value_type>(bits_type{1} << Positions))...
+    >
+    make_type(std::index_sequence<Positions...>);
+
+    using type = decltype(
+        make_type(std::make_index_sequence<detail::count_trailing_zeros(last_bits) + 1>()));
+};
+
+/// Creates a `value_set` for a flag enumeration type `Enum`, terminated by the `Last` flag.
+/// See `flag_enum_set_factory` for details.
+template <typename Enum, Enum Last>
+using make_flag_enum_set = typename flag_enum_set_factory<Enum, Last>::type;
+
+namespace detail
+{
+
+/// Type trait for the flags of a flag set, see `make_flag_enum_set`.
+template <typename Set>
+struct flag_set_traits;
+
+template <typename Type, Type... Values>
+struct flag_set_traits<value_set<Type, Values...>>
+{
+    static_assert(value_lookup<Type, Values...>::strategy() == lookup_strategy::flags,
+                  "The values of a flag set must be the flags 1, 2, 4, ...");
+
+    /// Integer type of the flags, the underlying type of an enum.
+    using flags_type = typename lookup_key<Type>::type;
+
+    /// Bit mask type of the set, a single word.
+    using mask_type = set_mask_t<value_set<Type, Values...>>;
+};
+
+/// Declaration of the integer type of the flags of a flag set.
+template <typename Set>
+using flags_t = typename flag_set_traits<Set>::flags_type;
+
+}  // namespace detail
+
+/// Returns the flags of the elements of a flag set, that is, the bitwise or of the elements.
+/// Bit `i` of the set is the flag `2^i`, so this reads the bit mask word as it is.
+template <typename Set>
+constexpr detail::flags_t<Set> to_flags(Set const& set) noexcept
+{
+    return static_cast<detail::flags_t<Set>>(detail::mask_access::mask(set).word(0));
+}
+
+/// Stores the set of the flags in `flags` in `set`, regardless of `ENUM_SET_BOUNDS_CHECK`.
+/// Returns `true` if every flag in `flags` is an element of the universe, otherwise `false`
+/// and leaves `set` untouched.
+template <typename Set>
+constexpr bool try_from_flags(detail::flags_t<Set> flags, Set& set) noexcept
+{
+    using mask_type = typename detail::flag_set_traits<Set>::mask_type;
+    const uint64_t bits = static_cast<std::make_unsigned_t<detail::flags_t<Set>>>(flags);
+    mask_type mask{};
+    mask.set_word(0, static_cast<typename mask_type::word_type>(bits));
+    if (mask.word(0) != bits)
+    {
+        return false;
+    }
+    set = detail::mask_access::make<Set>(mask);
+    return true;
+}
+
+/// Returns the set of the flags in `flags`, see `try_from_flags`.
+/// Flags outside the universe are handled according to `ENUM_SET_BOUNDS_CHECK`,
+/// which by default throws an `std::out_of_range` exception.
+template <typename Set>
+constexpr Set from_flags(detail::flags_t<Set> flags)
+{
+    Set result{};
+    detail::check_bounds(try_from_flags(flags, result), "from_flags with flags outside the set");
+    return result;
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_FLAG_ENUM_SET_HPP
@@ -1,9 +1,15 @@
 #ifndef ENUM_SET_INDEX_SET_HPP
 #define ENUM_SET_INDEX_SET_HPP
 
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/common.hpp>
 #include <enum_set/integer_set.hpp>
 #include <enum_set/standard_types.hpp>
 
+#include <iterator>
+#include <type_traits>
+
 namespace enum_set
 {
 
@@ -16,6 +22,445 @@ using index = value<size_t, Index>;
 template <size_t Size>
 using make_index_set = make_integer_set<size_t, Size>;
 
+namespace detail
+{
+
+/// Function object converting an element to an index, see `bit_mask::try_set_all`.
+struct index_identity
+{
+    template <typename Index>
+    constexpr size_t operator()(Index const& index) const noexcept
+    {
+        return static_cast<size_t>(index);
+    }
+};
+
+}  // namespace detail
+
+/// Represents a set of indices from the fixed universe `[0, Size)`.
+/// Offers the same interface as `make_index_set<Size>`, but is built directly on a `bit_mask`
+/// instead of one type per index, so that compile time and memory do not grow with `Size`.
+/// Use it for large universes (e.g. millions of indices), where `make_index_set` does not
+/// compile. The storage is `Size / 8` bytes held inline, so very large index sets should be
+/// allocated on the heap, and combined with the in place operators (e.g. `|=`) rather than the
+/// binary operators, which return a copy.
+/// Providing an invalid index to a runtime method is handled according to
+/// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+template <size_t Size>
+class index_set
+{
+    static_assert(Size > 0, "index set size must be strictly positive");
+private:
+    using mask_type = bit_mask<Size>;
+
+    /// Underlying storage, bit `i` tells whether index `i` is contained in the index set.
+    mask_type mask;
+
+    /// Constructs an index set from a bit mask.
+    constexpr explicit index_set(mask_type const& mask) noexcept
+        : mask{mask}
+    {
+    }
+public:
+    /// Forward declaration of an iterator class.
+    /// See `index_set_iterator.hpp` for details.
+    class iterator;
+
+    /// Iterator visiting the elements in reverse order.
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    // The usual suspects.
+    constexpr index_set(index_set const&) noexcept            = default;
+    constexpr index_set(index_set&&) noexcept                 = default;
+    constexpr index_set& operator=(index_set const&) noexcept = default;
+    constexpr index_set& operator=(index_set&&) noexcept      = default;
+    ~index_set() noexcept                                     = default;
+
+    /// Constructs an empty index set.
+    constexpr index_set() noexcept
+        : mask{}
+    {
+    }
+
+    /// Constructs an index set from a set of indices.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    template <
+        typename... Indices,
+        typename = std::enable_if_t<
+            detail::all((std::is_integral<Indices>::value
+                      && !std::is_same<Indices, bool>::value)...)
+        >
+    >
+    constexpr index_set(Indices... indices)
+        : mask{static_cast<size_t>(indices)...}
+    {
+    }
+
+    /// Returns an iterator to the first element in the index set.
+    /// The iterator refers to the index set, see `index_set::iterator` for details.
+    constexpr iterator begin() const noexcept
+    {
+        return iterator(mask, 0);
+    }
+
+    /// Returns a sentinel iterator representing the end of this index set.
+    /// See `begin()` for details.
+    constexpr iterator end() const noexcept
+    {
+        return iterator(mask, Size);
+    }
+
+    /// Returns a reverse iterator to the last element in the index set.
+    /// See `begin()` for details.
+    constexpr reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /// Returns a sentinel reverse iterator representing the end of the reversed index set.
+    /// See `begin()` for details.
+    constexpr reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /// Returns the lowest element in the index set.
+    /// Calling this on an empty index set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr size_t front() const
+    {
+        const size_t position = mask.find_first();
+        detail::check_bounds(position < Size, "index_set front of empty set");
+        return position;
+    }
+
+    /// Returns the highest element in the index set.
+    /// Calling this on an empty index set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr size_t back() const
+    {
+        const size_t position = mask.find_last();
+        detail::check_bounds(position < Size, "index_set back of empty set");
+        return position;
+    }
+
+    /// Returns the number of elements in the index set less than `Index`.
+    template <size_t Index>
+    constexpr size_t rank() const noexcept
+    {
+        static_assert(Index < Size, "Invalid index for index set");
+        return mask.rank(Index);
+    }
+
+    /// Returns the `k`:th (zero based) element of the index set.
+    /// Providing a `k` greater or equal to the size of the index set is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    constexpr size_t select(size_t k) const
+    {
+        const size_t position = mask.select(k);
+        detail::check_bounds(position < Size, "index_set select out of range");
+        return position;
+    }
+
+    /// Returns the value at `position` in the universe of the index set, which is `position`.
+    /// Providing a position greater or equal to the capacity is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    static constexpr size_t value_at(size_t position)
+    {
+        detail::check_bounds(position < Size, "index_set value_at out of range");
+        return position;
+    }
+
+    /// Returns the zero based index of `Index` in the universe of the index set, which is `Index`.
+    template <size_t Index>
+    static constexpr size_t index() noexcept
+    {
+        return Index;
+    }
+
+    /// Creates a singleton index set containing a single element `Index`.
+    template <size_t Index>
+    static constexpr index_set make() noexcept
+    {
+        static_assert(Index < Size, "Invalid index for index set");
+        index_set result{};
+        result.mask.set(Index);
+        return result;
+    }
+
+    /// Checks if the index set contains the element `Index`.
+    template <size_t Index>
+    constexpr bool has() const noexcept
+    {
+        return mask.template get<Index>();
+    }
+
+    /// Adds the element `Index` to the index set.
+    template <size_t Index>
+    constexpr void add() & noexcept
+    {
+        mask.template set<Index>();
+    }
+
+    /// Removes the element `Index` from the index set.
+    template <size_t Index>
+    constexpr void remove() & noexcept
+    {
+        mask.template clear<Index>();
+    }
+
+    /// Checks if the index set contains an index known at runtime.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid indices).
+    constexpr bool has(size_t index) const noexcept
+    {
+        bool result = false;
+        return mask.try_get(index, result) && result;
+    }
+
+    /// Adds an index known at runtime to the index set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr void add(size_t index) &
+    {
+        mask.set(index);
+    }
+
+    /// Removes an index known at runtime from the index set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr void remove(size_t index) &
+    {
+        mask.clear(index);
+    }
+
+    /// Adds an index known at runtime to the index set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    constexpr bool try_add(size_t index) & noexcept
+    {
+        return mask.try_set(index);
+    }
+
+    /// Removes an index known at runtime from the index set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity, otherwise `false`.
+    constexpr bool try_remove(size_t index) & noexcept
+    {
+        return mask.try_clear(index);
+    }
+
+    /// Constructs an index set from the indices in `[first, last)`.
+    /// See `value_set::from_range` for details.
+    template <typename Iterator>
+    static constexpr index_set from_range(Iterator first, Iterator last)
+    {
+        index_set result{};
+        result.insert(first, last);
+        return result;
+    }
+
+    /// Constructs an index set from the indices in a `range`, see `from_range(first, last)`.
+    template <typename Range>
+    static constexpr index_set from_range(Range const& range)
+    {
+        using std::begin;
+        using std::end;
+        return from_range(begin(range), end(range));
+    }
+
+    /// Adds the indices in `[first, last)` to the index set, validated in one batch.
+    /// See `value_set::insert` for details.
+    template <typename Iterator>
+    constexpr void insert(Iterator first, Iterator last) &
+    {
+        detail::check_bounds(
+            mask.try_set_all(first, last, detail::index_identity{}),
+            "index_set insert invalid index");
+    }
+
+    /// Adds the indices in a `range` to the index set, see `insert(first, last)`.
+    template <typename Range>
+    constexpr void insert(Range const& range) &
+    {
+        using std::begin;
+        using std::end;
+        insert(begin(range), end(range));
+    }
+
+    /// Adds the indices in `[first, last)` to the index set, regardless of
+    /// `ENUM_SET_BOUNDS_CHECK`. See `value_set::try_insert` for details.
+    template <typename Iterator>
+    constexpr Iterator try_insert(Iterator first, Iterator last) &
+    {
+        const detail::index_identity index_of{};
+        if (mask.try_set_all(first, last, index_of))
+        {
+            return last;
+        }
+        while (first != last && index_of(*first) < Size)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    /// Writes the elements in increasing order to `output`, at most `capacity` of them, and
+    /// returns the number of elements written. See `bit_mask::to_indices` for details.
+    template <typename Index>
+    constexpr size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        return mask.to_indices(output, capacity);
+    }
+
+    /// Writes the elements in increasing order to `output`, see `to_indices`.
+    constexpr size_t to_values(size_t* output, size_t capacity) const noexcept
+    {
+        return mask.to_indices(output, capacity);
+    }
+
+    /// Returns the total number of possible elements the index set can hold.
+    static constexpr size_t capacity() noexcept
+    {
+        return Size;
+    }
+
+    /// Returns the number of elements currently being hold by the index set.
+    constexpr size_t size() const noexcept
+    {
+        return mask.count();
+    }
+
+    /// Works like `size()`, but returns a signed integer instead.
+    constexpr ptrdiff_t count() const noexcept
+    {
+        return static_cast<ptrdiff_t>(size());
+    }
+
+    /// Checks if the index set is empty.
+    constexpr bool empty() const noexcept
+    {
+        return mask.none();
+    }
+
+    /// Erases all elements from the index set.
+    constexpr void clear() noexcept
+    {
+        mask = {};
+    }
+
+    /// Returns the set complement of an index set.
+    constexpr index_set
+    operator~ () const noexcept
+    {
+        return index_set(~mask);
+    }
+
+    /// Checks for equality between two index sets.
+    friend constexpr bool
+    operator== (index_set const& first, index_set const& second) noexcept
+    {
+        return first.mask == second.mask;
+    }
+
+    /// Checks for inequality between two index sets.
+    friend constexpr bool
+    operator!= (index_set const& first, index_set const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+    /// Returns the set union of two index sets.
+    friend constexpr index_set
+    operator| (index_set const& first, index_set const& second) noexcept
+    {
+        return index_set(first.mask | second.mask);
+    }
+
+    /// Returns the set intersection of two index sets.
+    friend constexpr index_set
+    operator& (index_set const& first, index_set const& second) noexcept
+    {
+        return index_set(first.mask & second.mask);
+    }
+
+    /// Returns the set difference between two index sets.
+    friend constexpr index_set
+    operator/ (index_set const& first, index_set const& second) noexcept
+    {
+        return index_set(first.mask / second.mask);
+    }
+
+    /// Returns the symmetric set difference between two index sets.
+    friend constexpr index_set
+    operator^ (index_set const& first, index_set const& second) noexcept
+    {
+        return index_set(first.mask ^ second.mask);
+    }
+
+    /// Checks if an index set is a subset of another.
+    friend constexpr bool
+    operator<= (index_set const& first, index_set const& second) noexcept
+    {
+        return first.mask.is_subset_of(second.mask);
+    }
+
+    /// Checks if an index set is a superset of another.
+    friend constexpr bool
+    operator>= (index_set const& first, index_set const& second) noexcept
+    {
+        return second <= first;
+    }
+
+    /// Checks if an index set is a strict subset of another.
+    friend constexpr bool
+    operator< (index_set const& first, index_set const& second) noexcept
+    {
+        return first <= second && first != second;
+    }
+
+    /// Checks if an index set is a strict superset of another.
+    friend constexpr bool
+    operator> (index_set const& first, index_set const& second) noexcept
+    {
+        return second < first;
+    }
+
+    /// Adds all elements of another index set to this, in place.
+    constexpr index_set&
+    operator|= (index_set const& another) & noexcept
+    {
+        mask |= another.mask;
+        return *this;
+    }
+
+    /// Restricts the elements of this index set to those contained in another, in place.
+    constexpr index_set&
+    operator&= (index_set const& another) & noexcept
+    {
+        mask &= another.mask;
+        return *this;
+    }
+
+    /// Removes all elements in this index set that are contained in another, in place.
+    constexpr index_set&
+    operator/= (index_set const& another) & noexcept
+    {
+        mask /= another.mask;
+        return *this;
+    }
+
+    /// Keeps the elements contained in exactly one of this and another index set, in place.
+    constexpr index_set&
+    operator^= (index_set const& another) & noexcept
+    {
+        mask ^= another.mask;
+        return *this;
+    }
+
+}; // class index_set
+
 }  // namespace enum_set
 
+#include <enum_set/index_set_iterator.hpp>
+#include <enum_set/index_set_visitor.hpp>
+
 #endif // ENUM_SET_INDEX_SET_HPP
@@ -0,0 +1,157 @@
+#ifndef ENUM_SET_INDEX_SET_ITERATOR_HPP
+#define ENUM_SET_INDEX_SET_ITERATOR_HPP
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <iterator>
+
+namespace enum_set
+{
+
+/// Represents a read only bidirectional iterator to the elements of an index set.
+/// Like `value_set::iterator`, the iterator refers to the index set it was created from instead
+/// of holding a snapshot, since the storage of a large index set is too big to copy.
+/// Hence the iterator is invalidated when the index set is destroyed, and it observes
+/// modifications made to the index set (except to the storage word of the current element).
+/// Incrementing and decrementing works like `value_set::iterator`, skipping empty words.
+template <size_t Size>
+class index_set<Size>::iterator
+{
+private:
+    using word_type = typename mask_type::word_type;
+
+    /// Members of the index set being iterated over.
+    mask_type const* mask;
+
+    /// Current element, or the capacity of the index set for the end iterator.
+    size_t index;
+
+    /// Members left in the storage word of the current element, the current element included.
+    word_type word;
+
+    /// Moves to the element at `position`, or to the end if `position` is the capacity.
+    constexpr void move_to(size_t position) noexcept
+    {
+        index = position;
+        word = (index < Size)
+            ? static_cast<word_type>(
+                  mask->word(index / mask_type::word_size)
+                & detail::mask_from<word_type>(index % mask_type::word_size))
+            : word_type{0};
+    }
+public:
+    // Adapt to STL iterator interface.
+    // Elements are returned by value, hence there is no pointer type.
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using value_type        = size_t;
+    using pointer           = void;
+    using reference         = size_t;
+
+    // The usual suspects.
+    constexpr iterator(iterator const&) noexcept            = default;
+    constexpr iterator(iterator&&) noexcept                 = default;
+    constexpr iterator& operator=(iterator const&) noexcept = default;
+    constexpr iterator& operator=(iterator&&) noexcept      = default;
+    ~iterator() noexcept                                    = default;
+
+    /// Constructs an index set iterator from the bit mask of the index set to iterate over and an
+    /// offset into it. The iterator will initially point to the first element greater or equal to
+    /// the offset, or become the end of sequence sentinel iterator if there is no such element.
+    constexpr iterator(mask_type const& container, size_t offset) noexcept
+        : mask{&container}
+        , index{Size}
+        , word{0}
+    {
+        move_to(container.find_next(offset));
+    }
+
+    /// Returns the element pointed to by this iterator.
+    /// Dereferencing the end iterator is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr size_t operator*() const
+    {
+        detail::check_bounds(index < Size, "index_set iterator dereference out of range");
+        return index;
+    }
+
+    /// Increments this iterator.
+    /// If there are no more elements left in the iteratee, the iterator becomes equal to end.
+    /// Incrementing end has no effects.
+    /// Returns a reference to this iterator.
+    constexpr iterator& operator++() noexcept
+    {
+        if (index < Size)
+        {
+            const size_t word_index = index / mask_type::word_size;
+            word = detail::clear_lowest(word);
+            if (word != 0)
+            {
+                index = word_index * mask_type::word_size + detail::count_trailing_zeros(word);
+            }
+            else
+            {
+                move_to(mask->find_next((word_index + 1) * mask_type::word_size));
+            }
+        }
+        return *this;
+    }
+
+    /// Increments this iterator, see `operator++()` for details.
+    /// Returns a copy of this iterator from before the increment.
+    constexpr iterator operator++(int) noexcept
+    {
+        iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    /// Decrements this iterator.
+    /// Decrementing end makes the iterator point to the last element, if any.
+    /// Decrementing an iterator pointing to the first element has no effects.
+    /// Returns a reference to this iterator.
+    constexpr iterator& operator--() noexcept
+    {
+        const size_t previous = mask->find_prev(index);
+        if (previous < Size)
+        {
+            move_to(previous);
+        }
+        return *this;
+    }
+
+    /// Decrements this iterator, see `operator--()` for details.
+    /// Returns a copy of this iterator from before the decrement.
+    constexpr iterator operator--(int) noexcept
+    {
+        iterator next = *this;
+        --(*this);
+        return next;
+    }
+
+    /// Checks for equality between two iterators.
+    /// Returns `true` if both points to the same element, otherwise `false`.
+    /// Comparing iterators from different index sets is only meaningful against `end()`.
+    friend constexpr bool
+    operator==(iterator const& first, iterator const& second) noexcept
+    {
+        return first.index == second.index;
+    }
+
+    /// Checks if two iterators are different.
+    /// See `operator==` for details.
+    friend constexpr bool
+    operator!=(iterator const& first, iterator const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+}; // class index_set::iterator
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_INDEX_SET_ITERATOR_HPP
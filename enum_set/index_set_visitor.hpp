@@ -0,0 +1,23 @@
+#ifndef ENUM_SET_INDEX_SET_VISITOR_HPP
+#define ENUM_SET_INDEX_SET_VISITOR_HPP
+
+#include <enum_set/index_set.hpp>
+
+namespace enum_set
+{
+
+/// Visits all indices in an index set in increasing order using a `Visitor`.
+/// Since the indices of an index set are not types, the `Visitor` needs to implement
+/// `? operator()(size_t)` instead of the `template <Value> ? operator()()` of `value_set`.
+template <class Visitor, size_t Size>
+constexpr void visit(Visitor&& visitor, index_set<Size> const& indices)
+{
+    for (size_t index : indices)
+    {
+        visitor(index);
+    }
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_INDEX_SET_VISITOR_HPP
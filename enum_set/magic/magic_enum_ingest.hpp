@@ -0,0 +1,449 @@
+#ifndef ENUM_SET_MAGIC_ENUM_INGEST_HPP
+#define ENUM_SET_MAGIC_ENUM_INGEST_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/magic/magic_enum_names.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/word_kernels.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <system_error>
+
+#include <unistd.h>
+#endif
+
+namespace enum_set
+{
+
+/// Layout of the text rows read by `ingest`: one row per line, ended by `\n` (a `\r` before it
+/// is ignored), made of fields separated by `field_separator`, where field `column` (counting
+/// from zero) holds names separated by `name_separator` (see `try_parse`).
+/// Fields are not quoted, so separators cannot appear within a field.
+struct ingest_format
+{
+    /// Character separating the fields of a row, e.g. `,` for CSV or `\t` for TSV.
+    char field_separator;
+    /// Index of the field holding the names.
+    size_t column;
+    /// Character separating the names within the field.
+    char name_separator;
+};
+
+/// Returns the format of CSV rows with names in field `column`.
+constexpr ingest_format csv_format(size_t column, char name_separator = '|') noexcept
+{
+    return {',', column, name_separator};
+}
+
+/// Returns the format of TSV rows with names in field `column`.
+constexpr ingest_format tsv_format(size_t column, char name_separator = '|') noexcept
+{
+    return {'\t', column, name_separator};
+}
+
+/// Outcome of `ingest`.
+enum class ingest_status
+{
+    /// All complete rows were ingested.
+    done,
+    /// The output is full, and rows remain.
+    output_full,
+    /// A row has too few fields or an unknown name.
+    malformed_row
+};
+
+/// Result of `ingest`.
+struct ingest_result
+{
+    /// Number of bytes of the rows that were ingested (including skipped empty rows), which is
+    /// the offset of the first row that was not.
+    size_t consumed;
+    /// Number of sets written to the output, one per non empty row.
+    size_t rows;
+    /// Why ingesting stopped.
+    ingest_status status;
+};
+
+namespace detail
+{
+
+/// Returns a pointer to the first character in `[first, last)` equal to `a` or `b`, or `last`
+/// if there is none. Compares 16 characters at a time with SSE2 where available
+/// (see `ENUM_SET_SIMD_WIDTH`), and the remaining ones a character at a time.
+inline char const* find_either(char const* first, char const* last, char a, char b) noexcept
+{
+#if ENUM_SET_SIMD_WIDTH >= 128
+    const __m128i first_pattern = _mm_set1_epi8(a);
+    const __m128i second_pattern = _mm_set1_epi8(b);
+    for (; last - first >= 16; first += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        const unsigned bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(chunk, first_pattern), _mm_cmpeq_epi8(chunk, second_pattern))));
+        if (bits != 0)
+        {
+            return first + count_trailing_zeros(bits);
+        }
+    }
+#endif
+    while (first != last && *first != a && *first != b)
+    {
+        ++first;
+    }
+    return first;
+}
+
+/// Returns a pointer to the first `\n` in `[first, last)`, or `last` if there is none.
+inline char const* find_line_end(char const* first, char const* last) noexcept
+{
+    if (first == last)
+    {
+        return last;
+    }
+    const void* found = std::memchr(first, '\n', static_cast<size_t>(last - first));
+    return found != nullptr ? static_cast<char const*>(found) : last;
+}
+
+/// Returns the number of non empty rows in `[first, last)`, see `ingest_format`.
+/// A last row without `\n` is counted.
+inline size_t count_rows(char const* first, char const* last) noexcept
+{
+    size_t result = 0;
+    while (first != last)
+    {
+        char const* const line_end = find_line_end(first, last);
+        const bool carriage_return = line_end - first == 1 && *first == '\r';
+        result += (line_end != first && !carriage_return) ? 1 : 0;
+        first = line_end == last ? last : line_end + 1;
+    }
+    return result;
+}
+
+/// Joins threads on destruction, so that no thread outlives the data it works on, also when
+/// starting a later thread fails.
+struct thread_joiner
+{
+    std::vector<std::thread>& threads;
+
+    ~thread_joiner()
+    {
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+}  // namespace detail
+
+/// Parses the rows of `size` bytes at `data` in the given `format`, writing the set of names of
+/// each non empty row to `output`, which holds at most `capacity` sets.
+/// A last row that is not ended by `\n` is only ingested if `last` is `true`, otherwise it is
+/// left for the next call, with the bytes following it (e.g. the next chunk of a file).
+/// Stops at the first malformed row, see `ingest_status`; the result tells where, so that the
+/// caller can resume after the row.
+/// Finds the fields with `detail::find_either` and the names with the perfect hash of `parse`,
+/// and does not allocate.
+template <typename Set>
+ingest_result ingest(char const* data, size_t size, ingest_format const& format,
+                     Set* output, size_t capacity, bool last = true) noexcept
+{
+    char const* position = data;
+    char const* const end = data + size;
+    size_t rows = 0;
+    while (position != end)
+    {
+        char const* field_begin = position;
+        char const* field_end = detail::find_either(position, end, format.field_separator, '\n');
+        size_t field = 0;
+        while (field < format.column && field_end != end && *field_end != '\n')
+        {
+            field_begin = field_end + 1;
+            field_end = detail::find_either(field_begin, end, format.field_separator, '\n');
+            ++field;
+        }
+        char const* const line_end = (field_end == end || *field_end == '\n')
+            ? field_end
+            : detail::find_line_end(field_end, end);
+        if (line_end == end && !last)
+        {
+            break;
+        }
+        char const* row_end = line_end;
+        if (row_end != position && row_end[-1] == '\r')
+        {
+            --row_end;
+            field_end = field_end > row_end ? row_end : field_end;
+        }
+        if (row_end != position)
+        {
+            if (field < format.column)
+            {
+                return {static_cast<size_t>(position - data), rows, ingest_status::malformed_row};
+            }
+            if (rows == capacity)
+            {
+                return {static_cast<size_t>(position - data), rows, ingest_status::output_full};
+            }
+            const std::string_view names(field_begin, static_cast<size_t>(field_end - field_begin));
+            if (!try_parse(names, output[rows], format.name_separator))
+            {
+                return {static_cast<size_t>(position - data), rows, ingest_status::malformed_row};
+            }
+            ++rows;
+        }
+        position = line_end == end ? end : line_end + 1;
+    }
+    return {static_cast<size_t>(position - data), rows, ingest_status::done};
+}
+
+/// Ingests the rows of `size` bytes at `data` (e.g. a memory mapped file) with `ingest`, on
+/// `threads` threads. The bytes are split in parts of about the same size at row boundaries,
+/// the rows of each part are counted to find where its sets start in `output`, and the parts
+/// are ingested concurrently. The result is the one of ingesting all bytes at once: on a
+/// malformed row or a full output, the sets of the rows before it are written, and the rows
+/// after it are not counted (their sets may be written though).
+/// Allocates a handful of bytes per thread, none per row. Requires linking a thread library
+/// (e.g. `Threads::Threads` in CMake).
+template <typename Set>
+ingest_result ingest_parallel(char const* data, size_t size, ingest_format const& format,
+                              Set* output, size_t capacity, size_t threads)
+{
+    const size_t parts = threads == 0 ? 1 : threads;
+    std::vector<size_t> bounds(parts + 1, size);
+    std::vector<size_t> offsets(parts + 1, 0);
+    std::vector<ingest_result> results(parts, ingest_result{0, 0, ingest_status::done});
+    bounds[0] = 0;
+    for (size_t part = 1; part < parts; ++part)
+    {
+        const size_t start = std::max(bounds[part - 1], size / parts * part);
+        char const* const line_end = detail::find_line_end(data + start, data + size);
+        bounds[part] = line_end == data + size ? size : static_cast<size_t>(line_end - data) + 1;
+    }
+    for (size_t part = 0; part < parts; ++part)
+    {
+        offsets[part + 1] = offsets[part]
+            + detail::count_rows(data + bounds[part], data + bounds[part + 1]);
+    }
+    auto work = [&](size_t part)
+    {
+        const size_t offset = std::min(offsets[part], capacity);
+        results[part] = ingest(data + bounds[part], bounds[part + 1] - bounds[part], format,
+                               output + offset, capacity - offset);
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    {
+        const detail::thread_joiner joiner{workers};
+        for (size_t part = 1; part < parts; ++part)
+        {
+            workers.emplace_back(work, part);
+        }
+        work(0);
+    }
+    for (size_t part = 0; part < parts; ++part)
+    {
+        if (results[part].status != ingest_status::done)
+        {
+            return {bounds[part] + results[part].consumed, offsets[part] + results[part].rows,
+                    results[part].status};
+        }
+    }
+    return {size, offsets[parts], ingest_status::done};
+}
+
+/// Number of bytes returned by the source of an `ingest_stream` if reading fails.
+constexpr size_t ingest_read_error = ~size_t{0};
+
+/// Ingests rows read from a `Source` in chunks, into a buffer provided by the caller, without
+/// allocating. The `Source` is a function object `size_t(char* buffer, size_t size)` reading at
+/// most `size` bytes into `buffer` (where `size` is never zero), returning the number of bytes
+/// read, zero at the end of the input and `ingest_read_error` if reading fails (see
+/// `file_source`).
+/// The buffer must hold the longest row, a longer row is handled according to
+/// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception, as is a
+/// malformed row (see `ingest_status`). Larger buffers (e.g. a few megabytes) mean fewer reads.
+/// A failing source stops the stream, without ingesting the incomplete row read before the
+/// failure (see `failed()`). The source reports the failure itself (see `source()`). A row longer
+/// than the buffer stops the stream the same way, if it is not otherwise handled.
+template <typename Set, typename Source>
+class ingest_stream
+{
+private:
+    /// Reads the input.
+    Source input;
+
+    /// Buffer of the chunks of the input.
+    char* buffer;
+
+    /// Number of bytes of the buffer.
+    size_t buffer_size;
+
+    /// Layout of the rows.
+    ingest_format format;
+
+    /// Range of the buffer holding bytes that were read but not ingested.
+    size_t begin;
+    size_t end;
+
+    /// Whether the source returned the end of the input.
+    bool exhausted;
+
+    /// Whether the source failed to read, or a row did not fit in the buffer.
+    bool failure;
+
+    /// Whether the first row is a header that remains to be skipped.
+    bool header;
+
+    /// Moves the pending bytes to the start of the buffer, and reads the source after them.
+    void fill()
+    {
+        std::memmove(buffer, buffer + begin, end - begin);
+        end -= begin;
+        begin = 0;
+        detail::check_bounds(end < buffer_size, "ingest_stream row longer than the buffer");
+        const size_t read = end < buffer_size ? input(buffer + end, buffer_size - end)
+                                              : ingest_read_error;
+        if (read == ingest_read_error)
+        {
+            failure = true;
+            return;
+        }
+        exhausted = read == 0;
+        end += read;
+    }
+
+    /// Skips the header row once it is in the buffer.
+    /// Returns `true` if the header is skipped, otherwise `false`.
+    bool skip_header() noexcept
+    {
+        char const* const line_end = detail::find_line_end(buffer + begin, buffer + end);
+        if (line_end == buffer + end && !exhausted)
+        {
+            return false;
+        }
+        begin = line_end == buffer + end ? end : static_cast<size_t>(line_end - buffer) + 1;
+        header = false;
+        return true;
+    }
+public:
+    /// Constructs a stream of rows in `format` read from `source` through the `size` bytes of
+    /// `buffer`, which must outlive the stream. Skips the first row if `header` is `true`.
+    ingest_stream(Source source, char* buffer, size_t size, ingest_format const& format,
+                  bool header = false)
+        : input{std::move(source)}
+        , buffer{buffer}
+        , buffer_size{size}
+        , format{format}
+        , begin{0}
+        , end{0}
+        , exhausted{false}
+        , failure{false}
+        , header{header}
+    {
+    }
+
+    /// Writes the sets of the next rows to `output`, which holds at most `capacity` sets, and
+    /// returns the number of sets written, which is less than `capacity` only at the end of the
+    /// input or on a failure (see `failed()`). Returns zero once all rows are read.
+    size_t read(Set* output, size_t capacity)
+    {
+        size_t written = 0;
+        while (written < capacity && !failure)
+        {
+            if (!header || skip_header())
+            {
+                const ingest_result result = ingest(buffer + begin, end - begin, format,
+                    output + written, capacity - written, exhausted);
+                begin += result.consumed;
+                written += result.rows;
+                detail::check_bounds(result.status != ingest_status::malformed_row,
+                    "ingest_stream malformed row");
+                if (result.status == ingest_status::output_full)
+                {
+                    break;
+                }
+            }
+            if (exhausted && !header)
+            {
+                break;
+            }
+            fill();
+        }
+        return written;
+    }
+
+    /// Returns `true` if the source failed to read, or a row did not fit in the buffer.
+    /// The rows before the failure are read, the rest of the input is not.
+    bool failed() const noexcept
+    {
+        return failure;
+    }
+
+    /// Returns the source of the input (e.g. to check it for errors).
+    Source const& source() const noexcept
+    {
+        return input;
+    }
+
+}; // class ingest_stream
+
+/// Creates an `ingest_stream`, deducing the type of the `source`.
+template <typename Set, typename Source>
+ingest_stream<Set, Source> make_ingest_stream(
+    Source source, char* buffer, size_t size, ingest_format const& format, bool header = false)
+{
+    return ingest_stream<Set, Source>(std::move(source), buffer, size, format, header);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/// Source of an `ingest_stream` reading a file descriptor (e.g. a file, a pipe or a socket),
+/// which is not owned. A failing read stores the failure in `error`.
+struct file_source
+{
+    /// File descriptor to read.
+    int handle;
+
+    /// Error of the failed read, if any.
+    std::error_code error;
+
+    /// Constructs a source reading the file descriptor `handle`.
+    explicit file_source(int handle) noexcept
+        : handle{handle}
+        , error{}
+    {
+    }
+
+    /// Reads at most `size` bytes into `buffer`, returns the number of bytes read.
+    /// Returns `ingest_read_error`, storing the error in `error`, if reading fails.
+    size_t operator()(char* buffer, size_t size) noexcept
+    {
+        while (true)
+        {
+            const ssize_t read = ::read(handle, buffer, size);
+            if (read >= 0)
+            {
+                return static_cast<size_t>(read);
+            }
+            if (errno != EINTR)
+            {
+                error = std::error_code(errno, std::generic_category());
+                return ingest_read_error;
+            }
+        }
+    }
+};
+#endif
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_MAGIC_ENUM_INGEST_HPP
@@ -0,0 +1,368 @@
+#ifndef ENUM_SET_MAGIC_ENUM_NAMES_HPP
+#define ENUM_SET_MAGIC_ENUM_NAMES_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/value_lookup.hpp>
+#include <enum_set/value_set.hpp>
+#include <enum_set/value_set_view.hpp>
+
+#include <magic_enum.hpp>
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Returns the 64-bit FNV-1a hash `hash` extended with `character`.
+constexpr uint64_t name_hash_step(uint64_t hash, char character) noexcept
+{
+    return (hash ^ static_cast<unsigned char>(character)) * fnv_prime;
+}
+
+/// Returns the 64-bit FNV-1a hash of the characters of `name`.
+constexpr uint64_t name_hash(std::string_view name) noexcept
+{
+    uint64_t hash = fnv_offset_basis;
+    for (const char character : name)
+    {
+        hash = name_hash_step(hash, character);
+    }
+    return hash;
+}
+
+/// Checks if `character` is a blank, a space or a tab.
+constexpr bool is_blank(char character) noexcept
+{
+    return character == ' ' || character == '\t';
+}
+
+/// Mixes a name hash with a displacement `seed`, the finalizer of MurmurHash3.
+constexpr uint64_t name_hash_mix(uint64_t hash, uint64_t seed) noexcept
+{
+    hash += seed * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+    hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return hash ^ (hash >> 33);
+}
+
+/// Returns the smallest power of two greater or equal to `value`, and at least one.
+constexpr size_t next_power_of_two(size_t value) noexcept
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+/// Returns the total number of characters of `names`.
+template <size_t Count>
+constexpr size_t names_size(std::array<std::string_view, Count> const& names) noexcept
+{
+    size_t result = 0;
+    for (auto const& name : names)
+    {
+        result += name.size();
+    }
+    return result;
+}
+
+/// Returns `names` stored back to back, followed by a null character.
+template <size_t Size, size_t Count>
+constexpr std::array<char, Size + 1> concatenate_names(
+    std::array<std::string_view, Count> const& names) noexcept
+{
+    std::array<char, Size + 1> result{};
+    size_t offset = 0;
+    for (auto const& name : names)
+    {
+        for (const char character : name)
+        {
+            result[offset++] = character;
+        }
+    }
+    return result;
+}
+
+/// Returns the offset of each of `names` stored back to back, followed by their total size.
+template <size_t Count>
+constexpr std::array<size_t, Count + 1> name_offsets(
+    std::array<std::string_view, Count> const& names) noexcept
+{
+    std::array<size_t, Count + 1> result{};
+    for (size_t index = 0; index < Count; ++index)
+    {
+        result[index + 1] = result[index] + names[index].size();
+    }
+    return result;
+}
+
+/// Perfect hash from `Count` names to their indices, using hash and displace: the hash of a
+/// name selects a bucket, and the seed of the bucket displaces it to a slot holding the index of
+/// the only name that can be found there, see `make_name_hash_table`.
+template <size_t Count>
+struct name_hash_table
+{
+    /// Number of buckets.
+    static constexpr size_t bucket_count{next_power_of_two(Count)};
+
+    /// Number of slots, twice the number of buckets.
+    static constexpr size_t slot_count{2 * bucket_count};
+
+    /// Seeds of the buckets.
+    std::array<uint16_t, bucket_count> seeds;
+
+    /// Indices of the names in the slots, `Count` for empty slots.
+    std::array<size_t, slot_count> slots;
+
+    /// Whether a seed was found for every bucket.
+    bool complete;
+
+    /// Returns the bucket of a name with hash `hash`, see `name_hash`.
+    static constexpr size_t bucket(uint64_t hash) noexcept
+    {
+        return hash % bucket_count;
+    }
+
+    /// Returns the slot of a name with hash `hash` in a bucket with seed `seed`.
+    static constexpr size_t slot(uint64_t hash, uint16_t seed) noexcept
+    {
+        return name_hash_mix(hash, seed) % slot_count;
+    }
+
+    /// Returns the slot of a name with hash `hash`.
+    constexpr size_t find_slot(uint64_t hash) const noexcept
+    {
+        return slot(hash, seeds[bucket(hash)]);
+    }
+};
+
+/// Builds the perfect hash of `names` from the seeds found by `search_hash_seeds`.
+/// The table is not complete if some seed was not found, or for duplicate or empty names.
+template <size_t Count>
+constexpr name_hash_table<Count> make_name_hash_table(
+    std::array<std::string_view, Count> const& names) noexcept
+{
+    using table_type = name_hash_table<Count>;
+    table_type table{{}, {}, true};
+    std::array<uint64_t, Count> hashes{};
+    for (size_t index = 0; index < Count; ++index)
+    {
+        hashes[index] = name_hash(names[index]);
+        table.complete = table.complete && !names[index].empty();
+    }
+    const auto found = search_hash_seeds<table_type, Count>(hashes.data());
+    for (size_t bucket = 0; bucket < table_type::bucket_count; ++bucket)
+    {
+        table.seeds[bucket] = found.seeds[bucket];
+    }
+    for (size_t slot = 0; slot < table_type::slot_count; ++slot)
+    {
+        table.slots[slot] = found.slots[slot];
+    }
+    table.complete = table.complete && found.complete && found.distinct == Count;
+    return table;
+}
+
+/// Names of the values of a set and their perfect hash, computed at compile time from
+/// `magic_enum::enum_name`. The names are stored back to back in a single array of characters,
+/// the name of the value at index `i` spanning `[offsets[i], offsets[i + 1])`.
+/// A lookup hashes the name once and compares it with a single candidate.
+template <typename Set>
+struct name_table;
+
+template <typename Enum, Enum... Values>
+struct name_table<value_set<Enum, Values...>>
+{
+    /// Number of names.
+    static constexpr size_t count{sizeof...(Values)};
+
+    /// Names of the values, in the order of the set.
+    static constexpr std::array<std::string_view, count> names{
+        {::magic_enum::enum_name(Values)...}
+    };
+
+    /// Number of characters of all names.
+    static constexpr size_t total_size{names_size(names)};
+
+    /// Characters of the names, stored back to back.
+    static constexpr std::array<char, total_size + 1> characters{
+        concatenate_names<total_size>(names)
+    };
+
+    /// Offsets of the names in `characters`.
+    static constexpr std::array<size_t, count + 1> offsets{name_offsets(names)};
+
+    /// Perfect hash of the names.
+    static constexpr name_hash_table<count> hash{make_name_hash_table(names)};
+
+    static_assert(hash.complete, "enumerator names must be unique and non empty");
+
+    /// Returns the index of the value named `name`, or `count` if there is none.
+    static size_t index(std::string_view name) noexcept
+    {
+        return find(name, name_hash(name));
+    }
+
+    /// Returns the index of the value named `name`, given its hash `name_hash(name)`,
+    /// or `count` if there is none.
+    static size_t find(std::string_view name, uint64_t name_hash_value) noexcept
+    {
+        const size_t index = hash.slots[hash.find_slot(name_hash_value)];
+        return (index < count
+             && offsets[index + 1] - offsets[index] == name.size()
+             && std::memcmp(characters.data() + offsets[index], name.data(), name.size()) == 0)
+            ? index
+            : count;
+    }
+};
+
+}  // namespace detail
+
+/// Parses a set of enumerators from their names separated by `separator` (e.g. `READ|WRITE`)
+/// into `set`, a `value_set` of an enumeration (e.g. a `make_magic_enum_set`).
+/// Blanks (spaces and tabs) around names are ignored, and an empty or blank text is the empty
+/// set. Returns `true` on success, otherwise `false` (for unknown or empty names), leaving `set`
+/// unchanged. Hashes each name while scanning for the separator, and looks it up with a compile
+/// time perfect hash of the names of the set (see `detail::name_table`), without allocating.
+template <typename Set>
+bool try_parse(std::string_view text, Set& set, char separator = '|') noexcept
+{
+    using table = detail::name_table<Set>;
+    using mask_type = detail::set_mask_t<Set>;
+    using word_type = typename mask_type::word_type;
+    mask_type mask{};
+    char const* position = text.data();
+    char const* const end = position + text.size();
+    while (position != end && detail::is_blank(*position))
+    {
+        ++position;
+    }
+    while (position != end)
+    {
+        while (position != end && detail::is_blank(*position))
+        {
+            ++position;
+        }
+        char const* const first = position;
+        char const* last = position;
+        uint64_t hash = detail::fnv_offset_basis;
+        uint64_t name_hash_value = hash;
+        for (; position != end && *position != separator; ++position)
+        {
+            hash = detail::name_hash_step(hash, *position);
+            if (!detail::is_blank(*position))
+            {
+                last = position + 1;
+                name_hash_value = hash;
+            }
+        }
+        const size_t index = table::find(
+            std::string_view(first, static_cast<size_t>(last - first)), name_hash_value);
+        if (index == table::count)
+        {
+            return false;
+        }
+        const size_t word = index / mask_type::word_size;
+        mask.set_word(word, static_cast<word_type>(
+            mask.word(word) | (word_type{1} << (index % mask_type::word_size))));
+        if (position != end && ++position == end)
+        {
+            return false;
+        }
+    }
+    set = detail::mask_access::make<Set>(mask);
+    return true;
+}
+
+/// Parses a set of enumerators, see `try_parse`.
+/// A text that cannot be parsed is handled according to `ENUM_SET_BOUNDS_CHECK`,
+/// which by default throws an `std::out_of_range` exception.
+template <typename Set>
+Set parse(std::string_view text, char separator = '|')
+{
+    Set result{};
+    detail::check_bounds(try_parse(text, result, separator), "parse unknown enumerator name");
+    return result;
+}
+
+/// Returns the number of characters `format_to` writes for a set.
+template <typename Set>
+size_t formatted_size(Set const& set) noexcept
+{
+    using table = detail::name_table<Set>;
+    using mask_type = detail::set_mask_t<Set>;
+    using word_type = typename mask_type::word_type;
+    auto const& mask = detail::mask_access::mask(set);
+    size_t result = 0;
+    size_t count = 0;
+    for (size_t word = 0; word < mask_type::word_count; ++word)
+    {
+        for (word_type bits = mask.word(word); bits != 0; bits = detail::clear_lowest(bits))
+        {
+            const size_t index = word * mask_type::word_size + detail::count_trailing_zeros(bits);
+            result += table::offsets[index + 1] - table::offsets[index];
+            ++count;
+        }
+    }
+    return result + (count > 0 ? count - 1 : 0);
+}
+
+/// Returns the number of characters `format_to` writes at most for a `Set`, for the full set.
+template <typename Set>
+constexpr size_t max_formatted_size() noexcept
+{
+    using table = detail::name_table<Set>;
+    return table::total_size + (table::count > 0 ? table::count - 1 : 0);
+}
+
+/// Writes the names of the elements of a set, in the order of the set and separated by
+/// `separator`, to `output`, and returns the number of characters written.
+/// Does not write a terminating null character. Copies the names from a contiguous table
+/// computed at compile time, see `detail::name_table`, and does not allocate.
+/// The `output` must hold at least `capacity` characters, a `capacity` smaller than the
+/// formatted size (see `formatted_size`, and `max_formatted_size` to size a buffer up front) is
+/// handled according to `ENUM_SET_BOUNDS_CHECK`, which by default throws an
+/// `std::out_of_range` exception.
+template <typename Set>
+size_t format_to(char* output, size_t capacity, Set const& set, char separator = '|')
+{
+    using table = detail::name_table<Set>;
+    using mask_type = detail::set_mask_t<Set>;
+    using word_type = typename mask_type::word_type;
+    auto const& mask = detail::mask_access::mask(set);
+    if (capacity < max_formatted_size<Set>())
+    {
+        detail::check_bounds(
+            capacity >= formatted_size(set), "format_to output buffer too small");
+    }
+    size_t written = 0;
+    for (size_t word = 0; word < mask_type::word_count; ++word)
+    {
+        for (word_type bits = mask.word(word); bits != 0; bits = detail::clear_lowest(bits))
+        {
+            const size_t index = word * mask_type::word_size + detail::count_trailing_zeros(bits);
+            const size_t size = table::offsets[index + 1] - table::offsets[index];
+            if (written != 0)
+            {
+                output[written++] = separator;
+            }
+            std::memcpy(
+                output + written, table::characters.data() + table::offsets[index], size);
+            written += size;
+        }
+    }
+    return written;
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_MAGIC_ENUM_NAMES_HPP
@@ -0,0 +1,521 @@
+#ifndef ENUM_SET_MAPPED_INDEX_SET_HPP
+#define ENUM_SET_MAPPED_INDEX_SET_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/word_kernels.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace enum_set
+{
+
+/// Modes of mapping a file into a `mapped_index_set`.
+enum class map_mode
+{
+    /// The set can only be read, and can be shared between processes.
+    read_only,
+    /// The set can be modified, modifications are written back to the file.
+    read_write
+};
+
+/// Access patterns of a `mapped_index_set`, passed to the kernel with `madvise`.
+enum class map_access
+{
+    /// No particular access pattern.
+    normal,
+    /// The words are read in increasing order (e.g. iteration or `size()`), read ahead eagerly.
+    sequential,
+    /// The words are read in random order (e.g. `has()`), do not read ahead.
+    random,
+    /// The whole set will be read soon, start paging it in now.
+    will_need
+};
+
+namespace detail
+{
+
+/// Returns the error code of the current `errno` of a failed system call.
+inline std::error_code last_system_error() noexcept
+{
+    return std::error_code(errno, std::generic_category());
+}
+
+/// Throws an `std::system_error` for an error code, see `throw_exception`.
+[[noreturn]] inline void throw_system_error(std::error_code error, char const* what)
+{
+    throw_exception<std::system_error>(error, what);
+}
+
+/// Owns a file descriptor, closing it on destruction.
+struct file_descriptor
+{
+    int handle;
+
+    ~file_descriptor() noexcept
+    {
+        if (handle >= 0)
+        {
+            ::close(handle);
+        }
+    }
+};
+
+}  // namespace detail
+
+/// Represents a set of indices whose storage words are a memory mapped file, for presence
+/// bitmaps too large to load (e.g. 2^32 indices take 512 MiB) or that must survive restarts.
+/// The file holds the raw 64-bit storage words in native byte order, bit `i % 64` of word
+/// `i / 64` telling whether index `i` is contained in the set, so the capacity is the file size
+/// in bits. Opening a set only maps the file: pages are read lazily by the kernel on first
+/// access, so startup time does not depend on the size of the set. Use `advise()` to tune read
+/// ahead, and `sync()` to write modifications back to the file.
+/// A read only set can be shared between processes without copying.
+/// Offers the runtime interface of `index_set`. Providing an invalid index to a runtime method
+/// is handled according to `ENUM_SET_BOUNDS_CHECK`, which by default throws an
+/// `std::out_of_range` exception. Failing system calls throw an `std::system_error`, and
+/// modifying a read only set throws an `std::logic_error` (both abort if exceptions are
+/// disabled, use `try_create()`, `try_open()`, `try_add()`, `try_remove()` and the overloads
+/// taking an `std::error_code` instead). Only available on POSIX systems.
+class mapped_index_set
+{
+public:
+    /// Storage word type.
+    using word_type = uint64_t;
+
+    /// Number of bits in a storage word.
+    static constexpr size_t word_size{64};
+
+    /// Forward declaration of an iterator class.
+    /// See `mapped_index_set_iterator.hpp` for details.
+    class iterator;
+
+    /// Iterator visiting the elements in reverse order.
+    using reverse_iterator = std::reverse_iterator<iterator>;
+private:
+    /// Mapped storage words.
+    word_type* data;
+
+    /// Number of storage words.
+    size_t word_count;
+
+    /// Whether the mapping is writable.
+    bool writable;
+
+    /// Takes over a mapping of `count` words, or no mapping if `address` is null.
+    mapped_index_set(word_type* address, size_t count, bool is_writable) noexcept
+        : data{address}
+        , word_count{address != nullptr ? count : 0}
+        , writable{is_writable}
+    {
+    }
+
+    /// Maps `count` words of an open file. Stores the error in `error` if mapping fails,
+    /// and returns a set without a mapping and capacity zero.
+    static mapped_index_set map(
+        int handle, size_t count, map_mode mode, std::error_code& error) noexcept
+    {
+        const bool is_writable = mode == map_mode::read_write;
+        void* address = ::mmap(
+            nullptr, count * sizeof(word_type),
+            is_writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, handle, 0);
+        if (address == MAP_FAILED)
+        {
+            error = detail::last_system_error();
+            return mapped_index_set(nullptr, 0, is_writable);
+        }
+        return mapped_index_set(static_cast<word_type*>(address), count, is_writable);
+    }
+
+    /// Checks that the set is writable.
+    void check_writable() const
+    {
+        if (!writable)
+        {
+            detail::throw_exception<std::logic_error>("mapped_index_set is read only");
+        }
+    }
+
+    /// Finds the first element greater or equal to an `offset`, returns the capacity if none.
+    size_t find_next(size_t offset) const noexcept
+    {
+        if (offset >= capacity())
+        {
+            return capacity();
+        }
+        size_t index = offset / word_size;
+        word_type bits = data[index] & detail::mask_from<word_type>(offset % word_size);
+        while (bits == 0)
+        {
+            if (++index == word_count)
+            {
+                return capacity();
+            }
+            bits = data[index];
+        }
+        return index * word_size + detail::count_trailing_zeros(bits);
+    }
+
+    /// Finds the last element strictly less than an `offset`, returns the capacity if none.
+    size_t find_prev(size_t offset) const noexcept
+    {
+        if (offset == 0)
+        {
+            return capacity();
+        }
+        const size_t last = std::min(offset, capacity()) - 1;
+        size_t index = last / word_size;
+        word_type bits = data[index] & detail::mask_to<word_type>(last % word_size);
+        while (bits == 0)
+        {
+            if (index == 0)
+            {
+                return capacity();
+            }
+            bits = data[--index];
+        }
+        return index * word_size + (word_size - 1 - detail::count_leading_zeros(bits));
+    }
+public:
+    /// Creates (or truncates) a file holding an empty set of at least `capacity` indices,
+    /// and maps it for reading and writing, without throwing. The capacity is rounded up to
+    /// whole words. The file is created sparse, so no disk space is used for words that are
+    /// never set. On failure stores the error in `error` (`std::errc::invalid_argument` for a
+    /// zero capacity), and returns a set without a mapping and capacity zero.
+    static mapped_index_set try_create(
+        std::string const& path, size_t capacity, std::error_code& error) noexcept
+    {
+        error.clear();
+        if (capacity == 0)
+        {
+            error = std::make_error_code(std::errc::invalid_argument);
+            return mapped_index_set(nullptr, 0, true);
+        }
+        const detail::file_descriptor file{
+            ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+        const size_t count = (capacity + word_size - 1) / word_size;
+        if (file.handle < 0
+            || ::ftruncate(file.handle, static_cast<off_t>(count * sizeof(word_type))) != 0)
+        {
+            error = detail::last_system_error();
+            return mapped_index_set(nullptr, 0, true);
+        }
+        return map(file.handle, count, map_mode::read_write, error);
+    }
+
+    /// Maps an existing file created by `create()` without throwing, see `map_mode` for the
+    /// modes. The file size must be a strictly positive multiple of the word size.
+    /// On failure stores the error in `error` (`std::errc::invalid_argument` for a file of the
+    /// wrong size), and returns a set without a mapping and capacity zero.
+    static mapped_index_set try_open(
+        std::string const& path, map_mode mode, std::error_code& error) noexcept
+    {
+        error.clear();
+        const detail::file_descriptor file{
+            ::open(path.c_str(), mode == map_mode::read_write ? O_RDWR : O_RDONLY)};
+        struct stat status{};
+        if (file.handle < 0 || ::fstat(file.handle, &status) != 0)
+        {
+            error = detail::last_system_error();
+            return mapped_index_set(nullptr, 0, mode == map_mode::read_write);
+        }
+        const size_t bytes = static_cast<size_t>(status.st_size);
+        if (bytes == 0 || bytes % sizeof(word_type) != 0)
+        {
+            error = std::make_error_code(std::errc::invalid_argument);
+            return mapped_index_set(nullptr, 0, mode == map_mode::read_write);
+        }
+        return map(file.handle, bytes / sizeof(word_type), mode, error);
+    }
+
+    /// Creates a set like `try_create()`, but throws on failure: an `std::invalid_argument`
+    /// for a zero capacity, otherwise an `std::system_error`.
+    static mapped_index_set create(std::string const& path, size_t capacity)
+    {
+        std::error_code error;
+        mapped_index_set result = try_create(path, capacity, error);
+        if (error == std::errc::invalid_argument && capacity == 0)
+        {
+            detail::throw_exception<std::invalid_argument>(
+                "mapped_index_set capacity must be strictly positive");
+        }
+        if (error)
+        {
+            detail::throw_system_error(error, "mapped_index_set create failed");
+        }
+        return result;
+    }
+
+    /// Maps an existing file like `try_open()`, but throws on failure: an
+    /// `std::invalid_argument` for a file of the wrong size, otherwise an `std::system_error`.
+    static mapped_index_set open(std::string const& path, map_mode mode = map_mode::read_only)
+    {
+        std::error_code error;
+        mapped_index_set result = try_open(path, mode, error);
+        if (error == std::errc::invalid_argument)
+        {
+            detail::throw_exception<std::invalid_argument>(
+                "mapped_index_set file size is not a multiple of words");
+        }
+        if (error)
+        {
+            detail::throw_system_error(error, "mapped_index_set open failed");
+        }
+        return result;
+    }
+
+    // The usual suspects.
+    mapped_index_set(mapped_index_set const&)            = delete;
+    mapped_index_set& operator=(mapped_index_set const&) = delete;
+
+    /// Takes over the mapping of another set, leaving it without a mapping and capacity zero.
+    mapped_index_set(mapped_index_set&& another) noexcept
+        : data{another.data}
+        , word_count{another.word_count}
+        , writable{another.writable}
+    {
+        another.data = nullptr;
+        another.word_count = 0;
+    }
+
+    /// Takes over the mapping of another set, leaving it without a mapping and capacity zero.
+    mapped_index_set& operator=(mapped_index_set&& another) noexcept
+    {
+        if (this != &another)
+        {
+            if (data != nullptr)
+            {
+                ::munmap(data, word_count * sizeof(word_type));
+            }
+            data = another.data;
+            word_count = another.word_count;
+            writable = another.writable;
+            another.data = nullptr;
+            another.word_count = 0;
+        }
+        return *this;
+    }
+
+    /// Unmaps the file, without waiting for modifications to be written, see `sync()`.
+    ~mapped_index_set() noexcept
+    {
+        if (data != nullptr)
+        {
+            ::munmap(data, word_count * sizeof(word_type));
+        }
+    }
+
+    /// Returns an iterator to the first element in the set.
+    /// The iterator refers to the set, see `mapped_index_set::iterator` for details.
+    iterator begin() const noexcept;
+
+    /// Returns a sentinel iterator representing the end of this set.
+    /// See `begin()` for details.
+    iterator end() const noexcept;
+
+    /// Returns a reverse iterator to the last element in the set.
+    /// See `begin()` for details.
+    reverse_iterator rbegin() const noexcept;
+
+    /// Returns a sentinel reverse iterator representing the end of the reversed set.
+    /// See `begin()` for details.
+    reverse_iterator rend() const noexcept;
+
+    /// Returns the lowest element in the set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t front() const
+    {
+        const size_t position = find_next(0);
+        detail::check_bounds(position < capacity(), "mapped_index_set front of empty set");
+        return position;
+    }
+
+    /// Returns the highest element in the set.
+    /// Calling this on an empty set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    size_t back() const
+    {
+        const size_t position = find_prev(capacity());
+        detail::check_bounds(position < capacity(), "mapped_index_set back of empty set");
+        return position;
+    }
+
+    /// Checks if the set contains an index.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid indices).
+    /// Pages in the word of the index, if not already in memory.
+    bool has(size_t index) const noexcept
+    {
+        return index < capacity()
+            && (data[index / word_size] & (word_type{1} << (index % word_size))) != 0;
+    }
+
+    /// Adds an index to the set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void add(size_t index) &
+    {
+        detail::check_bounds(index < capacity(), "mapped_index_set add index out of range");
+        check_writable();
+        data[index / word_size] |= word_type{1} << (index % word_size);
+    }
+
+    /// Removes an index from the set.
+    /// Providing an invalid index is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    void remove(size_t index) &
+    {
+        detail::check_bounds(index < capacity(), "mapped_index_set remove index out of range");
+        check_writable();
+        data[index / word_size] &= ~(word_type{1} << (index % word_size));
+    }
+
+    /// Adds an index to the set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity and the set is writable,
+    /// otherwise `false` and leaves the set unchanged.
+    bool try_add(size_t index) & noexcept
+    {
+        if (!writable || index >= capacity())
+        {
+            return false;
+        }
+        data[index / word_size] |= word_type{1} << (index % word_size);
+        return true;
+    }
+
+    /// Removes an index from the set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the index is less than the capacity and the set is writable,
+    /// otherwise `false` and leaves the set unchanged.
+    bool try_remove(size_t index) & noexcept
+    {
+        if (!writable || index >= capacity())
+        {
+            return false;
+        }
+        data[index / word_size] &= ~(word_type{1} << (index % word_size));
+        return true;
+    }
+
+    /// Writes the elements in increasing order to `output`, at most `capacity` of them, and
+    /// returns the number of elements written. See `bit_mask::to_indices` for details.
+    template <typename Index>
+    size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        return detail::word_kernels::extract(data, word_count, output, capacity);
+    }
+
+    /// Returns the total number of possible elements the set can hold.
+    size_t capacity() const noexcept
+    {
+        return word_count * word_size;
+    }
+
+    /// Returns `true` if the set can be modified, otherwise `false`.
+    bool is_writable() const noexcept
+    {
+        return writable;
+    }
+
+    /// Returns the number of elements currently being hold by the set.
+    /// Reads the whole set, consider `advise(map_access::sequential)` first.
+    size_t size() const noexcept
+    {
+        return detail::word_kernels::popcount(data, word_count);
+    }
+
+    /// Works like `size()`, but returns a signed integer instead.
+    ptrdiff_t count() const noexcept
+    {
+        return static_cast<ptrdiff_t>(size());
+    }
+
+    /// Checks if the set is empty. Reads the set up to its first element.
+    bool empty() const noexcept
+    {
+        return find_next(0) == capacity();
+    }
+
+    /// Erases all elements from the set. Only writes the words holding elements, so that pages
+    /// without elements (e.g. the holes of a sparse file) are read but not dirtied.
+    void clear()
+    {
+        check_writable();
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            if (data[i] != 0)
+            {
+                data[i] = 0;
+            }
+        }
+    }
+
+    /// Tells the kernel how the set is going to be accessed, see `map_access`.
+    /// Stores the error in `error` if the system call fails, otherwise clears it.
+    void advise(map_access access, std::error_code& error) const noexcept
+    {
+        const int advice =
+            (access == map_access::sequential) ? MADV_SEQUENTIAL
+          : (access == map_access::random) ? MADV_RANDOM
+          : (access == map_access::will_need) ? MADV_WILLNEED
+          : MADV_NORMAL;
+        error.clear();
+        if (::madvise(data, word_count * sizeof(word_type), advice) != 0)
+        {
+            error = detail::last_system_error();
+        }
+    }
+
+    /// Tells the kernel how the set is going to be accessed, see `map_access`.
+    /// Throws an `std::system_error` if the system call fails.
+    void advise(map_access access) const
+    {
+        std::error_code error;
+        advise(access, error);
+        if (error)
+        {
+            detail::throw_system_error(error, "mapped_index_set madvise failed");
+        }
+    }
+
+    /// Writes modifications back to the file, and waits until they are written.
+    /// Modifications are written eventually even without calling this, unless the system fails.
+    /// Stores the error in `error` if the system call fails, otherwise clears it.
+    void sync(std::error_code& error) const noexcept
+    {
+        error.clear();
+        if (writable && ::msync(data, word_count * sizeof(word_type), MS_SYNC) != 0)
+        {
+            error = detail::last_system_error();
+        }
+    }
+
+    /// Writes modifications back to the file, see `sync(std::error_code&)`.
+    /// Throws an `std::system_error` if the system call fails.
+    void sync() const
+    {
+        std::error_code error;
+        sync(error);
+        if (error)
+        {
+            detail::throw_system_error(error, "mapped_index_set msync failed");
+        }
+    }
+
+}; // class mapped_index_set
+
+}  // namespace enum_set
+
+#include <enum_set/mapped_index_set_iterator.hpp>
+
+#endif // ENUM_SET_MAPPED_INDEX_SET_HPP
@@ -0,0 +1,436 @@
+#ifndef ENUM_SET_SET_EXPRESSION_HPP
+#define ENUM_SET_SET_EXPRESSION_HPP
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/type_set.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace enum_set
+{
+
+template <typename Set, typename Node>
+class set_expression;
+
+namespace detail
+{
+
+/// Returns the type set a set is, or derives from. Only used in unevaluated contexts.
+template <typename... Ts>
+type_set<Ts...> type_set_base(type_set<Ts...> const&);
+
+/// See declaration in `type_set.hpp`.
+struct mask_access
+{
+    /// Returns the bit mask of a type set, or of a set derived from a type set (e.g. a value set).
+    template <typename... Ts>
+    static constexpr bit_mask<sizeof...(Ts)> const& mask(type_set<Ts...> const& set) noexcept
+    {
+        return set.mask;
+    }
+
+    /// Returns the `Set` with the elements given by a bit mask.
+    /// The `Set` must be a type set or constructible from the type set it derives from.
+    template <typename Set, typename Mask>
+    static constexpr Set make(Mask const& mask) noexcept
+    {
+        using base_type = decltype(type_set_base(std::declval<Set const&>()));
+        return Set(base_type(mask));
+    }
+};
+
+/// Declaration of the bit mask type of a `Set`.
+template <typename Set>
+using set_mask_t = std::decay_t<decltype(mask_access::mask(std::declval<Set const&>()))>;
+
+/// Leaf of a set expression, reading the words of a set.
+template <typename Mask>
+struct mask_operand
+{
+    Mask const* mask;
+
+    constexpr typename Mask::word_type word(size_t index) const noexcept
+    {
+        return mask->word(index);
+    }
+};
+
+/// Word operation of a set union.
+struct or_operation
+{
+    template <typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept
+    {
+        return static_cast<Word>(lhs | rhs);
+    }
+};
+
+/// Word operation of a set intersection.
+struct and_operation
+{
+    template <typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept
+    {
+        return static_cast<Word>(lhs & rhs);
+    }
+};
+
+/// Word operation of a symmetric set difference.
+struct xor_operation
+{
+    template <typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept
+    {
+        return static_cast<Word>(lhs ^ rhs);
+    }
+};
+
+/// Word operation of a set difference.
+struct and_not_operation
+{
+    template <typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept
+    {
+        return static_cast<Word>(lhs & ~rhs);
+    }
+};
+
+/// Node of a set expression combining the words of two operands with a word `Operation`.
+template <typename Mask, typename Operation, typename Lhs, typename Rhs>
+struct binary_node
+{
+    Lhs lhs;
+    Rhs rhs;
+
+    constexpr typename Mask::word_type word(size_t index) const noexcept
+    {
+        return Operation::apply(lhs.word(index), rhs.word(index));
+    }
+};
+
+/// Node of a set expression inverting the words of an operand.
+/// The unused tail bits of the last word are kept zero.
+template <typename Mask, typename Operand>
+struct complement_node
+{
+    Operand operand;
+
+    constexpr typename Mask::word_type word(size_t index) const noexcept
+    {
+        return static_cast<typename Mask::word_type>(
+            ~operand.word(index)
+          & ((index + 1 == Mask::word_count)
+              ? Mask::tail_mask()
+              : static_cast<typename Mask::word_type>(~0ULL)));
+    }
+};
+
+/// Type trait checking if a type is a `set_expression`.
+template <typename T>
+struct is_set_expression : std::false_type
+{
+};
+
+/// Specialization of `is_set_expression` for set expressions.
+template <typename Set, typename Node>
+struct is_set_expression<set_expression<Set, Node>> : std::true_type
+{
+};
+
+/// Type trait for the set type of an operand of a set expression.
+template <typename T>
+struct expression_set
+{
+    using type = T;
+};
+
+/// Specialization of `expression_set` for set expressions.
+template <typename Set, typename Node>
+struct expression_set<set_expression<Set, Node>>
+{
+    using type = Set;
+};
+
+/// Enables the set expression operators if at least one operand is a set expression,
+/// and both operands are of (or evaluate to) the same set type.
+template <typename Lhs, typename Rhs>
+using enable_set_expression_t = std::enable_if_t<
+    (is_set_expression<Lhs>::value || is_set_expression<Rhs>::value)
+    && std::is_same<typename expression_set<Lhs>::type, typename expression_set<Rhs>::type>::value,
+    nullptr_t
+>;
+
+/// Returns the expression node of a set expression.
+template <typename Set, typename Node>
+constexpr Node expression_node(set_expression<Set, Node> const& expression) noexcept
+{
+    return expression.root();
+}
+
+/// Returns an expression leaf reading the words of a set.
+template <typename Set, typename = std::enable_if_t<!is_set_expression<Set>::value>>
+constexpr mask_operand<set_mask_t<Set>> expression_node(Set const& set) noexcept
+{
+    return {&mask_access::mask(set)};
+}
+
+/// Combines two operands into a set expression node with a word `Operation`.
+template <typename Operation, typename Lhs, typename Rhs>
+constexpr auto make_binary_expression(Lhs const& lhs, Rhs const& rhs) noexcept
+{
+    using set_type = typename expression_set<Lhs>::type;
+    using node_type = binary_node<
+        set_mask_t<set_type>,
+        Operation,
+        decltype(expression_node(lhs)),
+        decltype(expression_node(rhs))
+    >;
+    return set_expression<set_type, node_type>(
+        node_type{expression_node(lhs), expression_node(rhs)});
+}
+
+/// Read only forward iterator over the elements of a copy of a `Set` (a `value_set`), used where
+/// there is no set to refer to (e.g. an evaluated set expression), so that the iterator stays
+/// valid after the original is gone. The copy is made once, by `begin()`, while the end sentinel
+/// holds an empty set, hence the iterator is forward only.
+template <typename Set>
+class set_snapshot_iterator
+{
+private:
+    /// Copy of the set being iterated over.
+    Set set;
+
+    /// Index of the current element, or the capacity of the set for the end iterator.
+    size_t index;
+public:
+    // Adapt to STL iterator interface.
+    // Elements are returned by value, hence there is no pointer type.
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = ptrdiff_t;
+    using value_type        = std::decay_t<decltype(Set::value_at(0))>;
+    using pointer           = void;
+    using reference         = value_type;
+
+    /// Constructs an iterator over a copy of `elements`, pointing to the first element with
+    /// index greater or equal to `offset`, or to the end if there is no such element.
+    constexpr set_snapshot_iterator(Set const& elements, size_t offset) noexcept
+        : set{elements}
+        , index{mask_access::mask(elements).find_next(offset)}
+    {
+    }
+
+    /// Returns the element pointed to by this iterator, see `Set::value_at`.
+    constexpr value_type operator*() const
+    {
+        return Set::value_at(index);
+    }
+
+    /// Increments this iterator, incrementing end has no effects.
+    constexpr set_snapshot_iterator& operator++() noexcept
+    {
+        if (index < Set::capacity())
+        {
+            index = mask_access::mask(set).find_next(index + 1);
+        }
+        return *this;
+    }
+
+    /// Increments this iterator, returning a copy from before the increment.
+    constexpr set_snapshot_iterator operator++(int) noexcept
+    {
+        set_snapshot_iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    /// Checks for equality between two iterators, that is, if they point to the same element.
+    /// Iterators over copies compare positions only, so any iterator at the end equals `end()`.
+    friend constexpr bool operator==(
+        set_snapshot_iterator const& first, set_snapshot_iterator const& second) noexcept
+    {
+        return first.index == second.index;
+    }
+
+    /// Checks if two iterators are different, see `operator==`.
+    friend constexpr bool operator!=(
+        set_snapshot_iterator const& first, set_snapshot_iterator const& second) noexcept
+    {
+        return !(first == second);
+    }
+
+}; // class set_snapshot_iterator
+
+}  // namespace detail
+
+/// Represents a lazily evaluated set algebra expression over sets of type `Set`
+/// (a `type_set` or a `value_set`), created with `lazy(set)` and combined using the usual set
+/// operators `|`, `&`, `^`, `/` and `~`.
+/// Nothing is computed until the expression is evaluated, which is done in a single pass over
+/// the storage words, without materializing intermediate results.
+/// `empty()` and `is_subset_of()` stop at the first word that decides the answer.
+/// An expression refers to its operands, so it must not outlive them. Evaluate it within the
+/// full expression creating it (e.g. by assigning to a set) rather than storing it with `auto`.
+template <typename Set, typename Node>
+class set_expression
+{
+private:
+    using mask_type = detail::set_mask_t<Set>;
+
+    /// Root node of the expression tree.
+    Node node;
+public:
+    // The usual suspects.
+    constexpr set_expression(set_expression const&) noexcept            = default;
+    constexpr set_expression(set_expression&&) noexcept                 = default;
+    constexpr set_expression& operator=(set_expression const&) noexcept = default;
+    constexpr set_expression& operator=(set_expression&&) noexcept      = default;
+    ~set_expression() noexcept                                          = default;
+
+    /// Constructs a set expression from its root node, see `lazy(set)` for creating expressions.
+    constexpr explicit set_expression(Node const& root) noexcept
+        : node{root}
+    {
+    }
+
+    /// Returns the root node of the expression tree.
+    constexpr Node const& root() const noexcept
+    {
+        return node;
+    }
+
+    /// Evaluates the expression in a single pass over the storage words.
+    constexpr Set evaluate() const noexcept
+    {
+        mask_type mask{};
+        for (size_t index = 0; index < mask_type::word_count; ++index)
+        {
+            mask.set_word(index, node.word(index));
+        }
+        return detail::mask_access::make<Set>(mask);
+    }
+
+    /// Evaluates the expression, see `evaluate()` for details.
+    constexpr operator Set() const noexcept
+    {
+        return evaluate();
+    }
+
+    /// Returns the number of elements of the evaluated expression, without materializing it.
+    constexpr size_t size() const noexcept
+    {
+        size_t result = 0;
+        for (size_t index = 0; index < mask_type::word_count; ++index)
+        {
+            result += detail::popcount(node.word(index));
+        }
+        return result;
+    }
+
+    /// Returns `true` if the evaluated expression has no elements, otherwise `false`.
+    /// Stops at the first non-empty word.
+    constexpr bool empty() const noexcept
+    {
+        for (size_t index = 0; index < mask_type::word_count; ++index)
+        {
+            if (node.word(index) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns `true` if every element of the evaluated expression is an element of `another`
+    /// set or set expression, otherwise `false`. Stops at the first word that is not a subset.
+    template <
+        typename Another,
+        detail::enable_set_expression_t<set_expression, Another> = nullptr
+    >
+    constexpr bool is_subset_of(Another const& another) const noexcept
+    {
+        const auto other = detail::expression_node(another);
+        for (size_t index = 0; index < mask_type::word_count; ++index)
+        {
+            if ((node.word(index) & ~other.word(index)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns a forward iterator to the first element of the evaluated expression.
+    /// Only available if `Set` is a `value_set`. The iterator holds the evaluated set (see
+    /// `detail::set_snapshot_iterator`), so that it stays valid after the expression is gone.
+    /// The expression is evaluated here only, `end()` returns a sentinel that does not evaluate
+    /// it, so a range based for loop makes a single pass. Evaluate the expression into a set
+    /// first for random access or backward iteration.
+    template <typename Iterable = Set>
+    constexpr detail::set_snapshot_iterator<Iterable> begin() const noexcept
+    {
+        return detail::set_snapshot_iterator<Iterable>(static_cast<Iterable>(evaluate()), 0);
+    }
+
+    /// Returns the end sentinel of the evaluated expression, see `begin()` for details.
+    template <typename Iterable = Set>
+    constexpr detail::set_snapshot_iterator<Iterable> end() const noexcept
+    {
+        return detail::set_snapshot_iterator<Iterable>(Iterable{}, Iterable::capacity());
+    }
+
+}; // class set_expression
+
+/// Creates a set expression from a set, to be combined lazily with other sets and set
+/// expressions. See `set_expression` for details.
+template <typename Set>
+constexpr set_expression<Set, detail::mask_operand<detail::set_mask_t<Set>>>
+lazy(Set const& set) noexcept
+{
+    return set_expression<Set, detail::mask_operand<detail::set_mask_t<Set>>>(
+        detail::expression_node(set));
+}
+
+/// Returns the lazy set union of two sets, at least one of them being a set expression.
+template <typename Lhs, typename Rhs, detail::enable_set_expression_t<Lhs, Rhs> = nullptr>
+constexpr auto operator|(Lhs const& lhs, Rhs const& rhs) noexcept
+{
+    return detail::make_binary_expression<detail::or_operation>(lhs, rhs);
+}
+
+/// Returns the lazy set intersection of two sets, at least one of them being a set expression.
+template <typename Lhs, typename Rhs, detail::enable_set_expression_t<Lhs, Rhs> = nullptr>
+constexpr auto operator&(Lhs const& lhs, Rhs const& rhs) noexcept
+{
+    return detail::make_binary_expression<detail::and_operation>(lhs, rhs);
+}
+
+/// Returns the lazy symmetric set difference of two sets, at least one of them being a set
+/// expression.
+template <typename Lhs, typename Rhs, detail::enable_set_expression_t<Lhs, Rhs> = nullptr>
+constexpr auto operator^(Lhs const& lhs, Rhs const& rhs) noexcept
+{
+    return detail::make_binary_expression<detail::xor_operation>(lhs, rhs);
+}
+
+/// Returns the lazy set difference of two sets, at least one of them being a set expression.
+template <typename Lhs, typename Rhs, detail::enable_set_expression_t<Lhs, Rhs> = nullptr>
+constexpr auto operator/(Lhs const& lhs, Rhs const& rhs) noexcept
+{
+    return detail::make_binary_expression<detail::and_not_operation>(lhs, rhs);
+}
+
+/// Returns the lazy set complement of a set expression.
+template <typename Set, typename Node>
+constexpr auto operator~(set_expression<Set, Node> const& expression) noexcept
+{
+    using node_type = detail::complement_node<detail::set_mask_t<Set>, Node>;
+    return set_expression<Set, node_type>(node_type{expression.root()});
+}
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_SET_EXPRESSION_HPP
@@ -11,6 +11,9 @@ using std::nullptr_t;
 using std::ptrdiff_t;
 using std::size_t;
 using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
 
 }  // namespace enum_set
 
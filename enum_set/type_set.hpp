@@ -13,6 +13,10 @@ namespace enum_set
 namespace detail
 {
 
+/// Grants library internals (e.g. the set expressions in `set_expression.hpp`) access to the
+/// bit mask representation of type sets, which is not part of the public interface.
+struct mask_access;
+
 /// Returns a `bit_mask` with bit at index of type `T` in the type list `Ts...` set.
 template <typename T, typename... Ts>
 constexpr bit_mask<sizeof...(Ts)>
@@ -23,12 +27,17 @@ make_bit_mask() noexcept
 
 }  // namespace detail
 
+/// Lazy expression over sets, see `set_expression.hpp`.
+template <typename Set, typename Node>
+class set_expression;
+
 /// Represents a set of types from a fixed non-empty universe of types `Ts...`.
 /// The term element and type are used interchangeably in the documentation of this class.
 template <typename... Ts>
 class type_set
 {
     static_assert(sizeof...(Ts) > 0, "type set types must be non-empty");
+    friend struct detail::mask_access;
 protected:
     using mask_type = bit_mask<sizeof...(Ts)>;
 
@@ -59,7 +68,8 @@ public:
     /// Constructs a type set by specifying which types to hold.
     /// The specification can be given either through a sequence of bools telling which types to
     /// include or not, or by providing the indices of the types to include.
-    /// If using the variant with indices, providing an invalid index throws an `std::out_of_range`.
+    /// If using the variant with indices, providing an invalid index is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range`.
     /// Providing bools is safe, providing an invalid set of bools is a compile time error.
     template <
         typename... Args,
@@ -73,6 +83,14 @@ public:
     {
     }
 
+    /// Constructs a type set by evaluating a set expression (see `set_expression.hpp`), so that
+    /// direct initialization from an expression works like copy initialization.
+    template <typename Node>
+    constexpr type_set(set_expression<type_set, Node> const& expression) noexcept
+        : type_set(expression.evaluate())
+    {
+    }
+
     /// Returns the zero based index of type `T` in the set of types `Ts...`.
     /// If `T` is not present in `Ts...` the capacity of the type set is returned.
     template <typename T>
@@ -107,7 +125,7 @@ public:
     /// Returns the number of elements currently being hold by the type set.
     constexpr size_t size() const noexcept
     {
-        return detail::count(has<Ts>()...);
+        return mask.count();
     }
 
     /// Works like `size()`, but returns a signed integer instead.
@@ -121,7 +139,17 @@ public:
     /// Returns `true` if the type set holds no elements, otherwise `false`.
     constexpr bool empty() const noexcept
     {
-        return !detail::any(has<Ts>()...);
+        return mask.none();
+    }
+
+    /// Writes the indices of the elements (see `index<T>()`) in increasing order to `output`,
+    /// at most `capacity` of them, and returns the number of indices written.
+    /// Entries of `output` after the returned count may be overwritten, so give a `capacity`
+    /// of `capacity()` to get all elements. See `bit_mask::to_indices` for details.
+    template <typename Index>
+    constexpr size_t to_indices(Index* output, size_t capacity) const noexcept
+    {
+        return mask.to_indices(output, capacity);
     }
 
     /// Adds an element `T` to the type set.
@@ -153,7 +181,7 @@ public:
     constexpr type_set
     operator~ () const noexcept
     {
-        return type_set(mask_type{!has<Ts>()...});
+        return type_set(~mask);
     }
 
     /// Checks for equality between two type sets.
@@ -161,7 +189,7 @@ public:
     friend constexpr bool
     operator== (type_set const& first, type_set const& second) noexcept
     {
-        return detail::all((first.has<Ts>() == second.has<Ts>())...);
+        return first.mask == second.mask;
     }
 
     /// Checks for inequality between two type sets.
@@ -177,7 +205,7 @@ public:
     friend constexpr type_set
     operator| (type_set const& first, type_set const& second) noexcept
     {
-        return type_set(mask_type{(first.has<Ts>() || second.has<Ts>())...});
+        return type_set(first.mask | second.mask);
     }
 
     /// Returns the set intersection of two type sets.
@@ -185,7 +213,7 @@ public:
     friend constexpr type_set
     operator& (type_set const& first, type_set const& second) noexcept
     {
-        return type_set(mask_type{(first.has<Ts>() && second.has<Ts>())...});
+        return type_set(first.mask & second.mask);
     }
 
     /// Returns the set difference between two type sets.
@@ -193,7 +221,7 @@ public:
     friend constexpr type_set
     operator/ (type_set const& first, type_set const& second) noexcept
     {
-        return first & ~second;
+        return type_set(first.mask / second.mask);
     }
 
     /// Returns the symmetric set difference between two type sets.
@@ -201,7 +229,7 @@ public:
     friend constexpr type_set
     operator^ (type_set const& first, type_set const& second) noexcept
     {
-        return (first / second) | (second / first);
+        return type_set(first.mask ^ second.mask);
     }
 
     /// Checks if a type set is a subset of another.
@@ -210,7 +238,7 @@ public:
     friend constexpr bool
     operator<= (type_set const& first, type_set const& second) noexcept
     {
-        return detail::all(((first.has<Ts>() && second.has<Ts>()) || !first.has<Ts>())...);
+        return first.mask.is_subset_of(second.mask);
     }
 
     /// Checks if a type set is a superset of another.
@@ -246,7 +274,8 @@ public:
     constexpr type_set&
     operator|= (type_set const& another) & noexcept
     {
-        return *this = *this | another;
+        mask |= another.mask;
+        return *this;
     }
 
     /// Restricts all elements in this type set to those contained in another type set.
@@ -255,7 +284,8 @@ public:
     constexpr type_set&
     operator&= (type_set const& another) & noexcept
     {
-        return *this = *this & another;
+        mask &= another.mask;
+        return *this;
     }
 
     /// Removes all elements in this type set that are contained in another type set.
@@ -264,7 +294,8 @@ public:
     constexpr type_set&
     operator/= (type_set const& another) & noexcept
     {
-        return *this = *this / another;
+        mask /= another.mask;
+        return *this;
     }
 
     /// Removes all elements in this type set that are contained in another type set,
@@ -274,7 +305,8 @@ public:
     constexpr type_set&
     operator^= (type_set const& other) & noexcept
     {
-        return *this = *this ^ other;
+        mask ^= other.mask;
+        return *this;
     }
 
 }; // class type_set
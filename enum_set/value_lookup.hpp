@@ -0,0 +1,634 @@
+#ifndef ENUM_SET_VALUE_LOOKUP_HPP
+#define ENUM_SET_VALUE_LOOKUP_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/common.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <type_traits>
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Strategies for looking up the index of a value known at runtime, see `value_lookup`.
+enum class lookup_strategy
+{
+    /// The values are consecutive, the index is the offset from the first value.
+    dense,
+    /// The values are the flags `1, 2, 4, ...`, the index is the position of the bit.
+    flags,
+    /// The values span a small range, the index is read from a table covering the range.
+    table,
+    /// The values are sparse, the index is read from a perfect hash table of the keys.
+    hash,
+    /// The index is found by a branch free binary search over the values sorted by key.
+    /// Used for sparse values if no perfect hash is found for them.
+    search,
+    /// The values are not integers nor enums, the index is found by comparing one by one.
+    linear
+};
+
+/// Type trait for the integer key of a value used by the lookup strategies.
+/// The key of an enum is its underlying type, the key of an integer is the integer itself.
+template <typename Type, bool = std::is_enum<Type>::value>
+struct lookup_key
+{
+    using type = std::underlying_type_t<Type>;
+};
+
+/// Specialization of `lookup_key` for non enum types.
+template <typename Type>
+struct lookup_key<Type, false>
+{
+    using type = Type;
+};
+
+/// Compile time properties of a list of `Values...` deciding which lookup strategy to use.
+/// Offsets between keys are computed modulo 2^64, which is correct for signed keys as well.
+template <typename Type, Type... Values>
+struct value_range
+{
+    using key_type = typename lookup_key<Type>::type;
+
+    /// Returns the key of the value at `index`.
+    static constexpr key_type key(size_t index) noexcept
+    {
+        return static_cast<key_type>(value_table<Type, Values...>::values[index]);
+    }
+
+    /// Returns the smallest key.
+    static constexpr key_type min() noexcept
+    {
+        key_type result = key(0);
+        for (size_t index = 1; index < sizeof...(Values); ++index)
+        {
+            result = (key(index) < result) ? key(index) : result;
+        }
+        return result;
+    }
+
+    /// Returns the difference between the largest and the smallest key.
+    static constexpr uint64_t span() noexcept
+    {
+        key_type result = key(0);
+        for (size_t index = 1; index < sizeof...(Values); ++index)
+        {
+            result = (result < key(index)) ? key(index) : result;
+        }
+        return static_cast<uint64_t>(result) - static_cast<uint64_t>(min());
+    }
+
+    /// Returns `true` if every key is one larger than the key before it.
+    static constexpr bool consecutive() noexcept
+    {
+        for (size_t index = 1; index < sizeof...(Values); ++index)
+        {
+            if (static_cast<uint64_t>(key(index)) - static_cast<uint64_t>(key(0)) != index)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Whether the keys can be flags, that is, integers with an unsigned type (all but `bool`).
+    static constexpr bool flag_keys = !std::is_same<std::remove_cv_t<key_type>, bool>::value;
+
+    /// Returns the key of the value at `index` as an unsigned integer, without sign extension.
+    /// Only meaningful if `flag_keys`, a `bool` key is not made unsigned.
+    static constexpr uint64_t bits(size_t index) noexcept
+    {
+        return static_cast<std::make_unsigned_t<
+            std::conditional_t<flag_keys, key_type, unsigned>>>(key(index));
+    }
+
+    /// Returns `true` if the key of the value at index `i` is `2^i`, that is, bit `i` is set.
+    static constexpr bool flags() noexcept
+    {
+        if (!flag_keys)
+        {
+            return false;
+        }
+        for (size_t index = 0; index < sizeof...(Values); ++index)
+        {
+            if (index >= 64 || bits(index) != uint64_t{1} << index)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Picks the lookup strategy for the values, where `search` stands for any sparse values.
+    /// Flags are picked over dense values, so that `{1, 2}` is tested with a single AND too.
+    /// A table is used if it has at most four entries per value (and at least 64 entries).
+    static constexpr lookup_strategy strategy() noexcept
+    {
+        return flags()
+            ? lookup_strategy::flags
+            : consecutive()
+            ? lookup_strategy::dense
+            : (span() < 4 * sizeof...(Values) + 64)
+            ? lookup_strategy::table
+            : lookup_strategy::search;
+    }
+};
+
+/// Implementation of a lookup `Strategy`, providing `index(Type)` for the `Values...`.
+/// The `index(value)` returns the index of the first occurence of `value` among the `Values...`,
+/// or the number of `Values...` if the value is not present, just like `index_of_value`.
+template <lookup_strategy Strategy, typename Type, Type... Values>
+struct value_lookup_strategy;
+
+/// Type factory for the lookup strategy of values with integer keys picked by `value_range`.
+/// The perfect hash of sparse values is only built here, so dense values do not pay for it.
+template <lookup_strategy Strategy, typename Type, Type... Values>
+struct sparse_lookup_strategy
+{
+    static constexpr lookup_strategy value{Strategy};
+};
+
+/// Specialization of `sparse_lookup_strategy` for sparse values, hashed if a hash is found.
+template <typename Type, Type... Values>
+struct sparse_lookup_strategy<lookup_strategy::search, Type, Values...>
+{
+    static constexpr lookup_strategy value{
+        value_lookup_strategy<lookup_strategy::hash, Type, Values...>::table.complete
+            ? lookup_strategy::hash
+            : lookup_strategy::search
+    };
+};
+
+/// Type factory for the lookup strategy of `Values...`, linear unless they have integer keys.
+template <bool IntegerKeys, typename Type, Type... Values>
+struct lookup_strategy_factory
+{
+    static constexpr lookup_strategy value{lookup_strategy::linear};
+};
+
+/// Specialization of `lookup_strategy_factory` for values with integer keys.
+template <typename Type, Type... Values>
+struct lookup_strategy_factory<true, Type, Values...>
+{
+    static constexpr lookup_strategy value{
+        sparse_lookup_strategy<value_range<Type, Values...>::strategy(), Type, Values...>::value
+    };
+};
+
+/// Type factory for the smallest unsigned integer type holding the indices `[0, Count]`.
+template <size_t Count>
+using lookup_index_type =
+    std::conditional_t<(Count < 0xFF), uint8_t,
+    std::conditional_t<(Count < 0xFFFF), uint16_t,
+    std::conditional_t<(Count < 0xFFFFFFFF), uint32_t, uint64_t>>>;
+
+/// Dense lookup: a subtraction and a comparison.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::dense, Type, Values...>
+{
+    using range = value_range<Type, Values...>;
+
+    static constexpr size_t index(Type value) noexcept
+    {
+        const uint64_t offset =
+            static_cast<uint64_t>(static_cast<typename range::key_type>(value))
+          - static_cast<uint64_t>(range::min());
+        return (offset < sizeof...(Values)) ? static_cast<size_t>(offset) : sizeof...(Values);
+    }
+};
+
+/// Flags lookup: the trailing zeros of the key, and a test that the key is a single flag.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::flags, Type, Values...>
+{
+    using range = value_range<Type, Values...>;
+    using bits_type = std::make_unsigned_t<typename range::key_type>;
+
+    /// Returns the key of `value` as an unsigned integer, bit `i` standing for the value at `i`.
+    static constexpr uint64_t bits(Type value) noexcept
+    {
+        return static_cast<bits_type>(static_cast<typename range::key_type>(value));
+    }
+
+    /// The bit past the last value keeps the trailing zeros of a zero key in range (with 64
+    /// values there is no such bit, and the 64 trailing zeros of a zero key are out of range).
+    /// The result is selected with a mask, compilers tend to branch on a conditional expression.
+    static constexpr size_t index(Type value) noexcept
+    {
+        constexpr size_t count = sizeof...(Values);
+        constexpr uint64_t sentinel = (count < 64) ? uint64_t{1} << (count % 64) : 0;
+        const uint64_t key = bits(value);
+        const size_t position = count_trailing_zeros(key | sentinel);
+        const size_t invalid = size_t{0} - static_cast<size_t>(
+            ((key & (key - 1)) != 0) | (key == 0) | (position >= count));
+        return (position & ~invalid) | (count & invalid);
+    }
+};
+
+/// Table of indices covering a range of keys, entries of absent keys hold the number of values.
+template <typename Index, size_t Size>
+struct lookup_table
+{
+    Index indices[Size];
+};
+
+/// Table lookup: a subtraction, a comparison and a load.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::table, Type, Values...>
+{
+    using range = value_range<Type, Values...>;
+    using index_type = lookup_index_type<sizeof...(Values)>;
+    using table_type = lookup_table<index_type, static_cast<size_t>(range::span()) + 1>;
+
+    /// Builds the table, filled backwards so that the first occurence of a duplicate wins.
+    static constexpr table_type make_table() noexcept
+    {
+        table_type result{};
+        for (size_t offset = 0; offset <= range::span(); ++offset)
+        {
+            result.indices[offset] = static_cast<index_type>(sizeof...(Values));
+        }
+        for (size_t index = sizeof...(Values); index-- > 0;)
+        {
+            const uint64_t offset =
+                static_cast<uint64_t>(range::key(index)) - static_cast<uint64_t>(range::min());
+            result.indices[offset] = static_cast<index_type>(index);
+        }
+        return result;
+    }
+
+    static constexpr table_type table = make_table();
+
+    static constexpr size_t index(Type value) noexcept
+    {
+        const uint64_t offset =
+            static_cast<uint64_t>(static_cast<typename range::key_type>(value))
+          - static_cast<uint64_t>(range::min());
+        return (offset <= range::span()) ? table.indices[offset] : sizeof...(Values);
+    }
+};
+
+template <typename Type, Type... Values>
+constexpr typename value_lookup_strategy<lookup_strategy::table, Type, Values...>::table_type
+value_lookup_strategy<lookup_strategy::table, Type, Values...>::table;
+
+/// Seeds and slots of a perfect hash of `Count` keys, found by `search_hash_seeds`.
+/// Each slot holds the position of its key among the hashes searched, or `Count` if empty.
+template <typename Hash, size_t Count>
+struct hash_seeds
+{
+    /// Seeds of the buckets.
+    uint16_t seeds[Hash::bucket_count];
+
+    /// Positions of the keys in the slots.
+    size_t slots[Hash::slot_count];
+
+    /// Number of keys with distinct hashes, the keys placed in the slots.
+    size_t distinct;
+
+    /// Whether a seed was found for every bucket.
+    bool complete;
+};
+
+/// Searches the seeds of a perfect hash with hash and displace, given the `hashes` of `Count`
+/// keys. `Hash::bucket(hash)` picks the bucket of a key and `Hash::slot(hash, seed)` its slot,
+/// for one of `Hash::bucket_count` buckets and `Hash::slot_count` slots.
+/// The keys are grouped by bucket with a stable counting sort, leaving out a key with the same
+/// hash as an earlier one, then the seeds are searched placing the largest buckets first.
+/// The result is not complete if some seed was not found.
+template <typename Hash, size_t Count>
+constexpr hash_seeds<Hash, Count> search_hash_seeds(uint64_t const* hashes) noexcept
+{
+    hash_seeds<Hash, Count> result{};
+    size_t starts[Hash::bucket_count + 1]{};
+    size_t sizes[Hash::bucket_count]{};
+    size_t order[Count + 1]{};
+    for (size_t key = 0; key < Count; ++key)
+    {
+        ++starts[Hash::bucket(hashes[key]) + 1];
+    }
+    for (size_t bucket = 0; bucket < Hash::bucket_count; ++bucket)
+    {
+        starts[bucket + 1] += starts[bucket];
+    }
+    size_t largest = 0;
+    for (size_t key = 0; key < Count; ++key)
+    {
+        const size_t bucket = Hash::bucket(hashes[key]);
+        bool duplicate = false;
+        for (size_t member = 0; member < sizes[bucket]; ++member)
+        {
+            duplicate = duplicate || hashes[order[starts[bucket] + member]] == hashes[key];
+        }
+        if (!duplicate)
+        {
+            order[starts[bucket] + sizes[bucket]++] = key;
+            largest = (largest < sizes[bucket]) ? sizes[bucket] : largest;
+            ++result.distinct;
+        }
+    }
+    for (auto& slot : result.slots)
+    {
+        slot = Count;
+    }
+    result.complete = true;
+    for (size_t size = largest; size > 0; --size)
+    {
+        for (size_t bucket = 0; bucket < Hash::bucket_count; ++bucket)
+        {
+            if (sizes[bucket] != size)
+            {
+                continue;
+            }
+            bool placed = false;
+            for (uint32_t seed = 0; !placed && seed <= 0xFFFF; ++seed)
+            {
+                size_t member = 0;
+                for (; member < size; ++member)
+                {
+                    const size_t key = order[starts[bucket] + member];
+                    auto& slot = result.slots[Hash::slot(hashes[key], static_cast<uint16_t>(seed))];
+                    if (slot != Count)
+                    {
+                        break;
+                    }
+                    slot = key;
+                }
+                placed = member == size;
+                while (!placed && member-- > 0)
+                {
+                    const size_t key = order[starts[bucket] + member];
+                    result.slots[Hash::slot(hashes[key], static_cast<uint16_t>(seed))] = Count;
+                }
+                result.seeds[bucket] = static_cast<uint16_t>(seed);
+            }
+            result.complete = result.complete && placed;
+        }
+    }
+    return result;
+}
+
+/// Slot of a perfect hash table, holding a key and its index.
+/// Empty slots hold an index past the last value, so a lookup needs no emptiness check.
+template <typename Key, typename Index>
+struct lookup_slot
+{
+    Key key;
+    Index index;
+};
+
+/// Perfect hash table of `Count` integer keys, with hash and displace.
+/// A multiplicative hash of a key picks its bucket from the high bits, and the seed of the
+/// bucket is mixed into the hash to pick one of twice as many slots as there are buckets.
+/// The size of the table depends on the number of keys only, not on how far apart they are.
+template <typename Key, typename Index, size_t Count>
+struct lookup_hash_table
+{
+    /// Returns the smallest number of bits, at least one, holding `Count` buckets.
+    static constexpr unsigned make_bucket_bits() noexcept
+    {
+        unsigned result = 1;
+        while ((size_t{1} << result) < Count)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    static constexpr unsigned bucket_bits = make_bucket_bits();
+    static constexpr size_t bucket_count = size_t{1} << bucket_bits;
+    static constexpr size_t slot_count = 2 * bucket_count;
+
+    /// Returns the hash of `key`, a bijection with well mixed high bits.
+    static constexpr uint64_t hash(Key key) noexcept
+    {
+        return static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    /// Returns the bucket of a key with hash `hash`.
+    static constexpr size_t bucket(uint64_t hash) noexcept
+    {
+        return static_cast<size_t>(hash >> (64 - bucket_bits));
+    }
+
+    /// Returns the slot of a key with hash `hash` in a bucket with seed `seed`.
+    static constexpr size_t slot(uint64_t hash, uint16_t seed) noexcept
+    {
+        return static_cast<size_t>(((hash ^ seed) * 0xC4CEB9FE1A85EC53ULL) >> (63 - bucket_bits));
+    }
+
+    /// Seeds of the buckets.
+    uint16_t seeds[bucket_count];
+
+    /// Keys and indices in the slots.
+    lookup_slot<Key, Index> slots[slot_count];
+
+    /// Whether a seed was found for every bucket.
+    bool complete;
+};
+
+/// Hash lookup: a perfect hash of the key, a load of the seed of its bucket, a load of its slot
+/// and a comparison, whatever the number of values and however far apart they are.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::hash, Type, Values...>
+{
+    using range = value_range<Type, Values...>;
+    using key_type = typename range::key_type;
+    using index_type = lookup_index_type<sizeof...(Values)>;
+    using table_type = lookup_hash_table<key_type, index_type, sizeof...(Values)>;
+
+    /// Builds the table from the seeds found by `search_hash_seeds`. The hash is a bijection,
+    /// so only duplicate keys share a hash, and the first occurence of a duplicate is kept.
+    static constexpr table_type make_table() noexcept
+    {
+        constexpr size_t count = sizeof...(Values);
+        uint64_t hashes[count]{};
+        for (size_t index = 0; index < count; ++index)
+        {
+            hashes[index] = table_type::hash(range::key(index));
+        }
+        const auto found = search_hash_seeds<table_type, count>(hashes);
+        table_type result{};
+        for (size_t bucket = 0; bucket < table_type::bucket_count; ++bucket)
+        {
+            result.seeds[bucket] = found.seeds[bucket];
+        }
+        for (size_t slot = 0; slot < table_type::slot_count; ++slot)
+        {
+            const size_t index = found.slots[slot];
+            result.slots[slot].key = (index < count) ? range::key(index) : key_type{};
+            result.slots[slot].index = static_cast<index_type>(index);
+        }
+        result.complete = found.complete;
+        return result;
+    }
+
+    static constexpr table_type table = make_table();
+
+    static constexpr size_t index(Type value) noexcept
+    {
+        const key_type key = static_cast<key_type>(value);
+        const uint64_t hash = table_type::hash(key);
+        auto const& slot =
+            table.slots[table_type::slot(hash, table.seeds[table_type::bucket(hash)])];
+        // Select with a mask, compilers tend to branch on a conditional expression here.
+        const size_t mismatch = size_t{0} - static_cast<size_t>(slot.key != key);
+        return (slot.index & ~mismatch) | (sizeof...(Values) & mismatch);
+    }
+};
+
+template <typename Type, Type... Values>
+constexpr typename value_lookup_strategy<lookup_strategy::hash, Type, Values...>::table_type
+value_lookup_strategy<lookup_strategy::hash, Type, Values...>::table;
+
+/// Entry of a sorted search table, mapping a key to an index.
+template <typename Key>
+struct lookup_entry
+{
+    Key key;
+    size_t index;
+};
+
+/// Search table of `Size` entries sorted by key.
+template <typename Key, size_t Size>
+struct lookup_entries
+{
+    lookup_entry<Key> entries[Size];
+};
+
+/// Search lookup: a branch free binary search in a sorted table, logarithmic in the number
+/// of values.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::search, Type, Values...>
+{
+    using range = value_range<Type, Values...>;
+    using key_type = typename range::key_type;
+    using entries_type = lookup_entries<key_type, sizeof...(Values)>;
+
+    /// Builds the search table with a stable insertion sort, then points all entries of a
+    /// duplicate key to its first occurence.
+    static constexpr entries_type make_entries() noexcept
+    {
+        entries_type result{};
+        for (size_t index = 0; index < sizeof...(Values); ++index)
+        {
+            const lookup_entry<key_type> entry{range::key(index), index};
+            size_t position = index;
+            for (; position > 0 && entry.key < result.entries[position - 1].key; --position)
+            {
+                result.entries[position] = result.entries[position - 1];
+            }
+            result.entries[position] = entry;
+        }
+        for (size_t index = 1; index < sizeof...(Values); ++index)
+        {
+            if (result.entries[index].key == result.entries[index - 1].key)
+            {
+                result.entries[index].index = result.entries[index - 1].index;
+            }
+        }
+        return result;
+    }
+
+    static constexpr entries_type table = make_entries();
+
+    /// Finds the last entry with a key less than or equal to the key of `value`.
+    /// The loop runs a fixed number of iterations for a given number of values, and the
+    /// conditional update compiles to a conditional move.
+    static constexpr size_t index(Type value) noexcept
+    {
+        const key_type key = static_cast<key_type>(value);
+        size_t first = 0;
+        size_t length = sizeof...(Values);
+        while (length > 1)
+        {
+            const size_t half = length / 2;
+            first += (table.entries[first + half].key <= key) ? half : 0;
+            length -= half;
+        }
+        return (table.entries[first].key == key) ? table.entries[first].index : sizeof...(Values);
+    }
+};
+
+template <typename Type, Type... Values>
+constexpr typename value_lookup_strategy<lookup_strategy::search, Type, Values...>::entries_type
+value_lookup_strategy<lookup_strategy::search, Type, Values...>::table;
+
+/// Linear lookup, for values that are neither integers nor enums.
+template <typename Type, Type... Values>
+struct value_lookup_strategy<lookup_strategy::linear, Type, Values...>
+{
+    static constexpr size_t index(Type value) noexcept
+    {
+        return index_of_value<Type, Values...>(value);
+    }
+};
+
+/// Constant time (or, failing a perfect hash, logarithmic) lookup of the index of a value known
+/// at runtime in a compile time list of `Values...`, replacing the linear `index_of_value`.
+/// The lookup strategy is picked at compile time, see `value_range::strategy`.
+/// Every lookup strategy provides `index(Type)`, see `value_lookup_strategy`.
+template <typename Type, Type... Values>
+struct value_lookup
+    : value_lookup_strategy<
+          lookup_strategy_factory<
+              std::is_integral<typename lookup_key<Type>::type>::value, Type, Values...
+          >::value,
+          Type,
+          Values...
+      >
+{
+    /// Returns the lookup strategy picked for the `Values...`.
+    static constexpr lookup_strategy strategy() noexcept
+    {
+        return lookup_strategy_factory<
+            std::is_integral<typename lookup_key<Type>::type>::value, Type, Values...
+        >::value;
+    }
+};
+
+/// Test of a value known at runtime in a bit `Mask` of the `Values...`, looking up its index
+/// with the lookup `Strategy`. Returns `false` for invalid values.
+template <lookup_strategy Strategy, typename Type, Type... Values>
+struct value_membership
+{
+    template <typename Mask>
+    static constexpr bool has(Mask const& mask, Type value) noexcept
+    {
+        bool result = false;
+        return mask.try_get(value_lookup<Type, Values...>::index(value), result) && result;
+    }
+};
+
+/// Specialization of `value_membership` for flags, where bit `i` of the mask is the key of the
+/// value at `i`. The test is an AND of the key with the mask word, and a test for a single flag.
+template <typename Type, Type... Values>
+struct value_membership<lookup_strategy::flags, Type, Values...>
+{
+    template <typename Mask>
+    static constexpr bool has(Mask const& mask, Type value) noexcept
+    {
+        const uint64_t key =
+            value_lookup_strategy<lookup_strategy::flags, Type, Values...>::bits(value);
+        return ((mask.word(0) & key) != 0) & ((key & (key - 1)) == 0);
+    }
+};
+
+/// Function object returning the index of a value convertible to `Type` among the `Values...`,
+/// see `value_lookup`. Used for bulk operations over ranges of values.
+template <typename Type, Type... Values>
+struct value_index
+{
+    template <typename Value>
+    constexpr size_t operator()(Value const& value) const noexcept
+    {
+        return value_lookup<Type, Values...>::index(static_cast<Type>(value));
+    }
+};
+
+}  // namespace detail
+}  // namespace enum_set
+
+#endif // ENUM_SET_VALUE_LOOKUP_HPP
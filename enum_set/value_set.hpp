@@ -4,7 +4,10 @@
 #include <enum_set/common.hpp>
 #include <enum_set/standard_types.hpp>
 #include <enum_set/type_set.hpp>
+#include <enum_set/value_lookup.hpp>
+#include <enum_set/word_kernels.hpp>
 
+#include <iterator>
 #include <utility>
 
 namespace enum_set
@@ -25,11 +28,17 @@ class value_set : public type_set<value<Type, Values>...>
     static_assert(sizeof...(Values) > 0, "value set values must be non-empty");
 public:
     using base_type = type_set<value<Type, Values>...>;
+protected:
+    using mask_type = typename base_type::mask_type;
+public:
 
     /// Forward declaration of an iterator class.
     /// See `value_set_iterator.hpp` for details.
     class iterator;
 
+    /// Iterator visiting the elements in reverse order.
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     // The usual suspects
     constexpr value_set() noexcept                              = default;
     constexpr value_set(value_set const&) noexcept              = default;
@@ -44,25 +53,32 @@ public:
     {
     }
 
+    /// Constructs a value set by evaluating a set expression (see `set_expression.hpp`), so that
+    /// direct initialization from an expression works like copy initialization.
+    template <typename Node>
+    constexpr value_set(set_expression<value_set, Node> const& expression) noexcept
+        : value_set(expression.evaluate())
+    {
+    }
+
     /// Constructs a value set from a set of values.
-    /// Providing an invalid value throws an `std::out_of_range` exception.
-    /// Complexity is bilinear in the number of `Values...` of the `value_set`
-    /// and the number of argument `Types...` provided in the constructor call,
-    /// hence, if you use many `Values...`, use this constructor with care.
+    /// Providing an invalid value is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    /// Each value is looked up in constant time if the `Values...` are integers or enums spanning
+    /// a small range, otherwise in logarithmic time, see `detail::value_lookup` for details.
     /// If you know the values at compile time, use `make` factory method instead.
-    template <typename... Types>
+    /// Only takes values convertible to `Type`.
+    template <
+        typename... Types,
+        typename = std::enable_if_t<detail::all(std::is_convertible<Types, Type>::value...)>
+    >
     constexpr value_set(Types... values)
-        : base_type(detail::index_of_value<Type, Values...>(static_cast<Type>(values))...)
+        : base_type(detail::value_lookup<Type, Values...>::index(static_cast<Type>(values))...)
     {
-        static_assert(
-            detail::all(std::is_convertible<Types, Type>::value...),
-            "All values in value_set constructor must be convertible to the value_set value type");
     }
 
     /// Returns an iterator to the first element in the value set.
-    /// The iterator does not point to any underlying value, it only acts as an indicator of the
-    /// existence of a certain element in the value set.
-    /// See `value_set_iterator` class for details.
+    /// The iterator refers to the value set, see `value_set_iterator` class for details.
     constexpr iterator begin() const noexcept
     {
         return iterator(this, 0);
@@ -75,6 +91,99 @@ public:
         return iterator(this, sizeof...(Values));
     }
 
+    /// Returns a reverse iterator to the last element in the value set.
+    /// See `begin()` for details.
+    constexpr reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /// Returns a sentinel reverse iterator representing the end of the reversed value set.
+    /// See `begin()` for details.
+    constexpr reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /// Returns the first element in the value set, that is, the one with the lowest index.
+    /// Calling this on an empty value set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr Type front() const
+    {
+        const size_t position = this->mask.find_first();
+        detail::check_bounds(position < sizeof...(Values), "value_set front of empty set");
+        return detail::value_table<Type, Values...>::values[position];
+    }
+
+    /// Returns the last element in the value set, that is, the one with the highest index.
+    /// Calling this on an empty value set is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    constexpr Type back() const
+    {
+        const size_t position = this->mask.find_last();
+        detail::check_bounds(position < sizeof...(Values), "value_set back of empty set");
+        return detail::value_table<Type, Values...>::values[position];
+    }
+
+    /// Returns the number of elements in the value set with lower index than `Value`,
+    /// that is, the zero based position `Value` has or would have among the elements.
+    template <Type Value>
+    constexpr size_t rank() const noexcept
+    {
+        static_assert(index<Value>() < sizeof...(Values), "Invalid value for value set");
+        return this->mask.rank(index<Value>());
+    }
+
+    /// Returns the `k`:th (zero based) element of the value set.
+    /// Providing a `k` greater or equal to the size of the value set is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    constexpr Type select(size_t k) const
+    {
+        const size_t position = this->mask.select(k);
+        detail::check_bounds(position < sizeof...(Values), "value_set select out of range");
+        return detail::value_table<Type, Values...>::values[position];
+    }
+
+    /// Returns the value at `position` in the `Values...` of the value set,
+    /// that is, the inverse of `index<Value>()`.
+    /// Providing a position greater or equal to the capacity is handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    /// Complexity is constant, all value sets over the same `Values...` share one table of values.
+    static constexpr Type value_at(size_t position)
+    {
+        return detail::get_value<Type, Values...>(position);
+    }
+
+    /// Writes the elements in increasing order of index to `output`, at most `capacity` of them,
+    /// and returns the number of elements written.
+    /// Unlike `to_indices`, entries of `output` after the returned count are left untouched.
+    /// The indices of each storage word are extracted in one go (see `bit_mask::to_indices`),
+    /// then mapped to values through the table shared with `value_at`.
+    constexpr size_t to_values(Type* output, size_t capacity) const noexcept
+    {
+        using word_type = typename mask_type::word_type;
+        uint32_t positions[mask_type::word_size]{};
+        size_t written = 0;
+        for (size_t index = 0; index < mask_type::word_count && written < capacity; ++index)
+        {
+            const word_type bits = this->mask.word(index);
+            if (bits == 0)
+            {
+                continue;
+            }
+            const size_t room = capacity - written;
+            const size_t extracted = detail::word_kernels::extract(
+                &bits, 1, positions, room < mask_type::word_size ? room : mask_type::word_size);
+            for (size_t k = 0; k < extracted; ++k)
+            {
+                output[written + k] = detail::value_table<Type, Values...>::values[
+                    index * mask_type::word_size + positions[k]];
+            }
+            written += extracted;
+        }
+        return written;
+    }
+
     template <Type Value>
     static constexpr size_t index() noexcept
     {
@@ -107,6 +216,111 @@ public:
         base_type::template remove<value<Type, Value>>();
     }
 
+    /// Checks if the value set contains a value known at runtime.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid values).
+    /// See `detail::value_lookup` for the complexity of looking up the value.
+    constexpr bool has(Type value) const noexcept
+    {
+        return detail::value_membership<
+            detail::value_lookup<Type, Values...>::strategy(), Type, Values...
+        >::has(this->mask, value);
+    }
+
+    /// Adds a value known at runtime to the value set.
+    /// Providing an invalid value is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    /// See `detail::value_lookup` for the complexity of looking up the value.
+    constexpr void add(Type value) &
+    {
+        this->mask.set(detail::value_lookup<Type, Values...>::index(value));
+    }
+
+    /// Removes a value known at runtime from the value set.
+    /// Providing an invalid value is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    /// See `detail::value_lookup` for the complexity of looking up the value.
+    constexpr void remove(Type value) &
+    {
+        this->mask.clear(detail::value_lookup<Type, Values...>::index(value));
+    }
+
+    /// Adds a value known at runtime to the value set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the value is one of the `Values...`, otherwise `false`.
+    constexpr bool try_add(Type value) & noexcept
+    {
+        return this->mask.try_set(detail::value_lookup<Type, Values...>::index(value));
+    }
+
+    /// Removes a value known at runtime from the value set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// Returns `true` if the value is one of the `Values...`, otherwise `false`.
+    constexpr bool try_remove(Type value) & noexcept
+    {
+        return this->mask.try_clear(detail::value_lookup<Type, Values...>::index(value));
+    }
+
+    /// Constructs a value set from the values in `[first, last)`, whose number is only known at
+    /// runtime. The values are validated in one batch after they are all looked up, and
+    /// providing an invalid value is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
+    /// See `bit_mask::try_set_all` and `detail::value_lookup` for the complexity.
+    template <typename Iterator>
+    static constexpr value_set from_range(Iterator first, Iterator last)
+    {
+        value_set result{};
+        detail::check_bounds(
+            result.mask.try_set_all(first, last, detail::value_index<Type, Values...>{}),
+            "value_set from_range invalid value");
+        return result;
+    }
+
+    /// Constructs a value set from the values in a `range`, see `from_range(first, last)`.
+    template <typename Range>
+    static constexpr value_set from_range(Range const& range)
+    {
+        using std::begin;
+        using std::end;
+        return from_range(begin(range), end(range));
+    }
+
+    /// Adds the values in `[first, last)` to the value set, validated in one batch.
+    /// Providing an invalid value is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception, leaving the value set unchanged.
+    template <typename Iterator>
+    constexpr void insert(Iterator first, Iterator last) &
+    {
+        detail::check_bounds(
+            this->mask.try_set_all(first, last, detail::value_index<Type, Values...>{}),
+            "value_set insert invalid value");
+    }
+
+    /// Adds the values in a `range` to the value set, see `insert(first, last)`.
+    template <typename Range>
+    constexpr void insert(Range const& range) &
+    {
+        using std::begin;
+        using std::end;
+        insert(begin(range), end(range));
+    }
+
+    /// Adds the values in `[first, last)` to the value set, regardless of `ENUM_SET_BOUNDS_CHECK`.
+    /// If all values are valid, they are added and `last` is returned. Otherwise the value set
+    /// is left unchanged and an iterator to the first invalid value is returned, so the
+    /// `Iterator` must allow passing over the range twice (a forward iterator).
+    template <typename Iterator>
+    constexpr Iterator try_insert(Iterator first, Iterator last) &
+    {
+        const detail::value_index<Type, Values...> index_of{};
+        if (this->mask.try_set_all(first, last, index_of))
+        {
+            return last;
+        }
+        while (first != last && index_of(*first) < sizeof...(Values))
+        {
+            ++first;
+        }
+        return first;
+    }
+
     constexpr value_set operator~ () const noexcept
     {
         return value_set(base_type::operator~());
@@ -137,7 +351,7 @@ public:
     }
 
     friend constexpr value_set
-    operator^ (value_set const& lhs, value_set const& rhs)
+    operator^ (value_set const& lhs, value_set const& rhs) noexcept
     {
         return value_set(
                 static_cast<base_type const&>(lhs)
@@ -2,54 +2,67 @@
 #define ENUM_SET_VALUE_SET_ITERATOR_HPP
 
 #include <enum_set/bit_mask.hpp>
+#include <enum_set/bit_operations.hpp>
 #include <enum_set/common.hpp>
 #include <enum_set/standard_types.hpp>
 #include <enum_set/value_set.hpp>
 
-#include <algorithm>
 #include <iterator>
 
 namespace enum_set
 {
-namespace detail
-{
 
-/// Finds the first set bit at index greater or equal to an offset into a bit mask.
-/// Returns the index of the bit if found, otherwise returns `mask.size()`.
-template <size_t N>
-constexpr size_t find(bit_mask<N> const& mask, size_t offset) noexcept
-{
-    while (offset < mask.size())
-    {
-        if (mask.get(offset))
-        {
-            return offset;
-        }
-        offset += 1;
-    }
-    return std::min(offset, mask.size());
-}
-
-}  // namespace detail
-
-/// Represents an read only forward iterator to the elements of a value set.
+/// Represents an read only random access iterator to the elements of a value set.
+/// The iterator refers to the value set it was created from, like `index_set::iterator`, and
+/// holds a copy of the storage word of the current member only. Hence the iterator is invalidated
+/// when the value set is destroyed, and it observes modifications made to the value set (except
+/// to the storage word of the current member). Iterate over a temporary (e.g. `a & b`) with a
+/// range based for loop, which keeps the temporary alive, or through a set expression.
+/// Incrementing jumps directly to the next member by clearing the lowest bit of the current
+/// storage word and counting trailing zeros, skipping empty words altogether.
+/// Decrementing works the same way backwards, using count leading zeros.
+/// Differences and random jumps count the members before the current member with
+/// `bit_mask::rank` when they are needed, and jump with `bit_mask::select`.
 template <typename Type, Type... Values>
 class value_set<Type, Values...>::iterator
 {
 private:
+    using word_type = typename mask_type::word_type;
+
     /// Pointer to the value set being iterated over.
-    /// Changing the pointee invalidates this iterator.
+    /// Destroying the pointee invalidates this iterator.
     value_set const* container;
 
-    /// Index of the current member into the `container` pointee.
+    /// Index of the current member, or the capacity of the value set for the end iterator.
     size_t index;
+
+    /// Members left in the storage word of the current member, the current member included.
+    word_type word;
+
+    /// Moves to the member at `position`, or to the end if `position` is the capacity.
+    constexpr void move_to(size_t position) noexcept
+    {
+        index = position;
+        word = (index < sizeof...(Values))
+            ? static_cast<word_type>(
+                  container->mask.word(index / mask_type::word_size)
+                & detail::mask_from<word_type>(index % mask_type::word_size))
+            : word_type{0};
+    }
+
+    /// Returns the number of members before the current member, or the size for end.
+    constexpr size_t ordinal() const noexcept
+    {
+        return container->mask.rank(index);
+    }
 public:
     // Adapt to STL iterator interface.
-    using iterator_category = std::forward_iterator_tag;
+    // Elements are returned by value, hence there is no pointer type.
+    using iterator_category = std::random_access_iterator_tag;
     using difference_type   = ptrdiff_t;
     using value_type        = Type;
-    using pointer           = Type*;
-    using reference         = Type&;
+    using pointer           = void;
+    using reference         = Type;
 
     // The usual suspects.
     constexpr iterator(iterator const&) noexcept            = default;
@@ -66,16 +79,21 @@ public:
     /// iterator will become the end of sequence sentinel iterator.
     constexpr iterator(value_set const* container, size_t offset) noexcept
         : container{container}
-        , index{detail::find(container->mask, offset)}
+        , index{sizeof...(Values)}
+        , word{0}
     {
+        move_to(container->mask.find_next(offset));
     }
 
     /// Returns the element pointed to by this iterator.
     /// Although the syntax resembles dereferencing, the element is returned by value.
-    /// Dereferencing the end iterator throws an `std::out_of_range` exception.
+    /// Dereferencing the end iterator is handled according to `ENUM_SET_BOUNDS_CHECK`,
+    /// which by default throws an `std::out_of_range` exception.
     constexpr Type operator*() const
     {
-        return detail::get_value<Type, Values...>(index);
+        detail::check_bounds(
+            index < sizeof...(Values), "value_set iterator dereference out of range");
+        return detail::value_table<Type, Values...>::values[index];
     }
 
     /// Increments this iterator.
@@ -86,11 +104,106 @@ public:
     {
         if (index < sizeof...(Values))
         {
-            index = detail::find(container->mask, index + 1);
+            const size_t word_index = index / mask_type::word_size;
+            word = detail::clear_lowest(word);
+            if (word != 0)
+            {
+                index = word_index * mask_type::word_size + detail::count_trailing_zeros(word);
+            }
+            else
+            {
+                move_to(container->mask.find_next((word_index + 1) * mask_type::word_size));
+            }
+        }
+        return *this;
+    }
+
+    /// Increments this iterator, see `operator++()` for details.
+    /// Returns a copy of this iterator from before the increment.
+    constexpr iterator operator++(int) noexcept
+    {
+        iterator previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    /// Decrements this iterator.
+    /// Decrementing end makes the iterator point to the last element, if any.
+    /// Decrementing an iterator pointing to the first element has no effects.
+    /// Returns a reference to this iterator.
+    constexpr iterator& operator--() noexcept
+    {
+        const size_t previous = container->mask.find_prev(index);
+        if (previous < sizeof...(Values))
+        {
+            move_to(previous);
         }
         return *this;
     }
 
+    /// Decrements this iterator, see `operator--()` for details.
+    /// Returns a copy of this iterator from before the decrement.
+    constexpr iterator operator--(int) noexcept
+    {
+        iterator next = *this;
+        --(*this);
+        return next;
+    }
+
+    /// Advances this iterator `offset` elements, backwards if `offset` is negative.
+    /// Advancing beyond the last element makes the iterator equal to end,
+    /// advancing before the first element makes it point to the first element.
+    /// Returns a reference to this iterator.
+    constexpr iterator& operator+=(difference_type offset) noexcept
+    {
+        const difference_type target = static_cast<difference_type>(ordinal()) + offset;
+        move_to(container->mask.select((target < 0) ? 0 : static_cast<size_t>(target)));
+        return *this;
+    }
+
+    /// Advances this iterator `offset` elements backwards.
+    /// See `operator+=` for details.
+    constexpr iterator& operator-=(difference_type offset) noexcept
+    {
+        return *this += -offset;
+    }
+
+    /// Returns a copy of an iterator advanced `offset` elements.
+    /// See `operator+=` for details.
+    friend constexpr iterator operator+(iterator it, difference_type offset) noexcept
+    {
+        return it += offset;
+    }
+
+    /// Returns a copy of an iterator advanced `offset` elements.
+    /// See `operator+=` for details.
+    friend constexpr iterator operator+(difference_type offset, iterator it) noexcept
+    {
+        return it += offset;
+    }
+
+    /// Returns a copy of an iterator advanced `offset` elements backwards.
+    /// See `operator+=` for details.
+    friend constexpr iterator operator-(iterator it, difference_type offset) noexcept
+    {
+        return it -= offset;
+    }
+
+    /// Returns the number of elements between two iterators of the same value set.
+    /// Runs in time linear in the number of storage words before the elements.
+    friend constexpr difference_type operator-(iterator const& last, iterator const& first) noexcept
+    {
+        return static_cast<difference_type>(last.ordinal())
+             - static_cast<difference_type>(first.ordinal());
+    }
+
+    /// Returns the element `offset` elements from the element pointed to by this iterator.
+    /// See `operator*` for details.
+    constexpr Type operator[](difference_type offset) const
+    {
+        return *(*this + offset);
+    }
+
     /// Checks for equality between two iterators.
     /// Returns `true` if both points to the same element in the same container, otherwise `false`.
     friend constexpr bool
@@ -99,6 +212,34 @@ public:
         return (first.container == second.container) && (first.index == second.index);
     }
 
+    /// Checks if an iterator points to an element before another of the same value set.
+    friend constexpr bool
+    operator<(iterator const& first, iterator const& second) noexcept
+    {
+        return first.index < second.index;
+    }
+
+    /// Checks if an iterator points to an element after another.
+    friend constexpr bool
+    operator>(iterator const& first, iterator const& second) noexcept
+    {
+        return second < first;
+    }
+
+    /// Checks if an iterator points to an element before or equal to another.
+    friend constexpr bool
+    operator<=(iterator const& first, iterator const& second) noexcept
+    {
+        return !(second < first);
+    }
+
+    /// Checks if an iterator points to an element after or equal to another.
+    friend constexpr bool
+    operator>=(iterator const& first, iterator const& second) noexcept
+    {
+        return !(first < second);
+    }
+
     /// Checks if two iterators are different.
     /// See `operator==` for details.
     friend constexpr bool
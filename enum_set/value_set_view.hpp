@@ -0,0 +1,325 @@
+#ifndef ENUM_SET_VALUE_SET_VIEW_HPP
+#define ENUM_SET_VALUE_SET_VIEW_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/bounds_check.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/type_set.hpp>
+#include <enum_set/value_lookup.hpp>
+#include <enum_set/value_set.hpp>
+
+#include <type_traits>
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Offset basis of the 64-bit FNV-1a hash.
+constexpr uint64_t fnv_offset_basis = 0xCBF29CE484222325ULL;
+
+/// Prime of the 64-bit FNV-1a hash.
+constexpr uint64_t fnv_prime = 0x100000001B3ULL;
+
+/// Returns the 64-bit FNV-1a hash `hash` extended with the eight bytes of `value`,
+/// least significant byte first.
+constexpr uint64_t fnv_hash(uint64_t hash, uint64_t value) noexcept
+{
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+        hash = (hash ^ ((value >> (8 * byte)) & 0xFF)) * fnv_prime;
+    }
+    return hash;
+}
+
+/// Returns the 64-bit FNV-1a hash of the universe of a set of `Values...`: the size and
+/// signedness of `Type`, the number of values, and the key of every value in order.
+template <typename Type, Type... Values>
+constexpr uint64_t universe_fingerprint() noexcept
+{
+    using range = value_range<Type, Values...>;
+    uint64_t hash = fnv_offset_basis;
+    hash = fnv_hash(hash, sizeof(Type));
+    hash = fnv_hash(hash, std::is_signed<typename range::key_type>::value ? 1 : 0);
+    hash = fnv_hash(hash, sizeof...(Values));
+    for (size_t index = 0; index < sizeof...(Values); ++index)
+    {
+        hash = fnv_hash(hash, static_cast<uint64_t>(range::key(index)));
+    }
+    return hash;
+}
+
+/// Stores `value` in eight bytes at `output`, least significant byte first.
+inline void store_little_endian(uint64_t value, unsigned char* output) noexcept
+{
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+        output[byte] = static_cast<unsigned char>(value >> (8 * byte));
+    }
+}
+
+/// Loads a value from eight bytes at `input`, least significant byte first.
+inline uint64_t load_little_endian(unsigned char const* input) noexcept
+{
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+        value |= static_cast<uint64_t>(input[byte]) << (8 * byte);
+    }
+    return value;
+}
+
+}  // namespace detail
+
+/// Describes the stable binary layout of a set of values, which is either a `value_set` or a
+/// `type_set` of `value`s (both having the same layout for the same values).
+/// The layout is a header followed by the elements:
+/// - the `fingerprint` of the universe, 8 bytes, least significant byte first,
+/// - the elements as a bit mask of `capacity` bits, the element at index `i` in bit `i % 8` of
+///   byte `i / 8`, unused bits of the last byte are zero.
+/// The layout does not depend on the platform, the compiler or the storage word type.
+/// Sets of types that are not values have no layout, since types have no portable
+/// compile time identity.
+template <typename Set>
+struct set_layout;
+
+/// Specialization of `set_layout` for type sets of values.
+template <typename Type, Type... Values>
+struct set_layout<type_set<value<Type, Values>...>>
+{
+    /// Set type that is materialized from the layout.
+    using set_type = value_set<Type, Values...>;
+
+    /// Type of the values of the set.
+    using value_type = Type;
+
+    /// Compile time hash of the universe of the set, see `detail::universe_fingerprint`.
+    /// Changes if values are added, removed, reordered or renumbered, or if their type changes
+    /// size or signedness.
+    static constexpr uint64_t fingerprint{detail::universe_fingerprint<Type, Values...>()};
+
+    /// Number of possible elements.
+    static constexpr size_t capacity{sizeof...(Values)};
+
+    /// Number of bytes of the header.
+    static constexpr size_t header_size{8};
+
+    /// Number of bytes of the layout.
+    static constexpr size_t size{header_size + (capacity + 7) / 8};
+
+    /// Returns the index of a value in the universe, or the capacity if it is not a member.
+    static constexpr size_t index(Type value) noexcept
+    {
+        return detail::value_lookup<Type, Values...>::index(value);
+    }
+};
+
+template <typename Type, Type... Values>
+constexpr uint64_t set_layout<type_set<value<Type, Values>...>>::fingerprint;
+
+template <typename Type, Type... Values>
+constexpr size_t set_layout<type_set<value<Type, Values>...>>::capacity;
+
+template <typename Type, Type... Values>
+constexpr size_t set_layout<type_set<value<Type, Values>...>>::header_size;
+
+template <typename Type, Type... Values>
+constexpr size_t set_layout<type_set<value<Type, Values>...>>::size;
+
+/// Specialization of `set_layout` for value sets, same as for their base type.
+template <typename Type, Type... Values>
+struct set_layout<value_set<Type, Values...>>
+    : set_layout<type_set<value<Type, Values>...>>
+{
+};
+
+namespace detail
+{
+
+/// Stores the elements of a set of values as the bit mask of its binary layout (see
+/// `set_layout`), `(capacity + 7) / 8` bytes at `output`.
+template <typename Set>
+void store_elements(Set const& set, unsigned char* output) noexcept
+{
+    using layout = set_layout<Set>;
+    using word_type = typename set_mask_t<Set>::word_type;
+    auto const& mask = mask_access::mask(set);
+    for (size_t byte = 0; byte < (layout::capacity + 7) / 8; ++byte)
+    {
+        const word_type word = mask.word(byte / sizeof(word_type));
+        output[byte] = static_cast<unsigned char>(word >> (8 * (byte % sizeof(word_type))));
+    }
+}
+
+/// Loads a set of values from the bit mask of its binary layout (see `set_layout`),
+/// `(capacity + 7) / 8` bytes at `input`. The unused bits of the last byte are ignored.
+template <typename Set>
+typename set_layout<Set>::set_type load_elements(unsigned char const* input) noexcept
+{
+    using layout = set_layout<Set>;
+    using mask_type = set_mask_t<typename layout::set_type>;
+    using word_type = typename mask_type::word_type;
+    constexpr size_t byte_count = (layout::capacity + 7) / 8;
+    mask_type mask{};
+    for (size_t index = 0; index < byte_count; ++index)
+    {
+        const unsigned char byte = (index + 1 == byte_count && layout::capacity % 8 != 0)
+            ? static_cast<unsigned char>(input[index] & ((1U << (layout::capacity % 8)) - 1))
+            : input[index];
+        const size_t word_index = index / sizeof(word_type);
+        mask.set_word(word_index, static_cast<word_type>(
+            mask.word(word_index)
+          | static_cast<word_type>(static_cast<word_type>(byte)
+                << (8 * (index % sizeof(word_type))))));
+    }
+    return mask_access::make<typename layout::set_type>(mask);
+}
+
+}  // namespace detail
+
+/// Writes a set in its binary layout (see `set_layout`) to `output`, which must hold at least
+/// `capacity` bytes, and returns the number of bytes written, `set_layout<Set>::size`.
+/// Providing a smaller `capacity` is handled according to `ENUM_SET_BOUNDS_CHECK`,
+/// which by default throws an `std::out_of_range` exception.
+template <typename Set>
+size_t serialize(Set const& set, unsigned char* output, size_t capacity)
+{
+    using layout = set_layout<Set>;
+    detail::check_bounds(capacity >= layout::size, "serialize output buffer too small");
+    detail::store_little_endian(layout::fingerprint, output);
+    detail::store_elements(set, output + layout::header_size);
+    return layout::size;
+}
+
+/// Read only view of a set of values serialized in its binary layout (see `set_layout`).
+/// Reads the elements in place from the bytes, without copying or deserializing them.
+/// The bytes are checked on construction, in constant time: a buffer of the wrong size or with
+/// the fingerprint of another universe (e.g. written by a program built with another enum
+/// definition) is rejected. The view refers to the bytes, so it must not outlive them.
+/// `Set` is the `value_set` (or type set of values) the bytes were serialized from.
+template <typename Set>
+class value_set_view
+{
+public:
+    using layout = set_layout<Set>;
+
+    /// Set type that is materialized from the view.
+    using set_type = typename layout::set_type;
+private:
+    /// Number of bytes of the elements.
+    static constexpr size_t byte_count{layout::size - layout::header_size};
+
+    /// Bytes of the elements, following the header.
+    unsigned char const* bytes;
+
+    /// Returns the byte of the elements at `index`, with the unused bits of the last byte cleared.
+    unsigned char byte(size_t index) const noexcept
+    {
+        return (index + 1 == byte_count && layout::capacity % 8 != 0)
+            ? static_cast<unsigned char>(bytes[index] & ((1U << (layout::capacity % 8)) - 1))
+            : bytes[index];
+    }
+public:
+    // The usual suspects.
+    value_set_view(value_set_view const&) noexcept            = default;
+    value_set_view(value_set_view&&) noexcept                 = default;
+    value_set_view& operator=(value_set_view const&) noexcept = default;
+    value_set_view& operator=(value_set_view&&) noexcept      = default;
+    ~value_set_view() noexcept                                = default;
+
+    /// Returns `true` if `size` bytes at `data` hold a set of the universe of `Set`, that is if
+    /// the size and the fingerprint match the layout, otherwise `false`.
+    static bool accepts(unsigned char const* data, size_t size) noexcept
+    {
+        return size == layout::size && detail::load_little_endian(data) == layout::fingerprint;
+    }
+
+    /// Constructs a view of `size` bytes at `data`.
+    /// Bytes that are not accepted (see `accepts`) are handled according to
+    /// `ENUM_SET_BOUNDS_CHECK`, which by default throws an `std::out_of_range` exception.
+    value_set_view(unsigned char const* data, size_t size)
+        : bytes{data + layout::header_size}
+    {
+        detail::check_bounds(accepts(data, size), "value_set_view size or fingerprint mismatch");
+    }
+
+    /// Checks if the viewed set contains the value `Value`.
+    template <typename layout::value_type Value>
+    bool has() const noexcept
+    {
+        return has_index(set_type::template index<Value>());
+    }
+
+    /// Checks if the viewed set contains a value known at runtime.
+    /// Returns `true` if there is such an element, otherwise `false` (also for invalid values).
+    /// See `detail::value_lookup` for the complexity of looking up the value.
+    bool has(typename layout::value_type value) const noexcept
+    {
+        return has_index(layout::index(value));
+    }
+
+    /// Checks if the viewed set contains the value at `index` in the universe.
+    /// Returns `false` for indices greater or equal to the capacity.
+    bool has_index(size_t index) const noexcept
+    {
+        return index < layout::capacity && ((bytes[index / 8] >> (index % 8)) & 1) != 0;
+    }
+
+    /// Returns the number of elements of the viewed set.
+    size_t size() const noexcept
+    {
+        size_t result = 0;
+        for (size_t index = 0; index < byte_count; ++index)
+        {
+            result += detail::popcount(static_cast<uint8_t>(byte(index)));
+        }
+        return result;
+    }
+
+    /// Checks if the viewed set is empty.
+    bool empty() const noexcept
+    {
+        for (size_t index = 0; index < byte_count; ++index)
+        {
+            if (byte(index) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Copies the viewed set into a `set_type`.
+    set_type to_set() const noexcept
+    {
+        return detail::load_elements<Set>(bytes);
+    }
+
+    /// Copies the viewed set, see `to_set()`.
+    operator set_type() const noexcept
+    {
+        return to_set();
+    }
+
+    /// Returns an iterator to the first element of the viewed set.
+    /// The iterator holds a copy of the elements, see `detail::set_snapshot_iterator`.
+    detail::set_snapshot_iterator<set_type> begin() const noexcept
+    {
+        return detail::set_snapshot_iterator<set_type>(to_set(), 0);
+    }
+
+    /// Returns the end iterator of the viewed set, see `begin()` for details.
+    detail::set_snapshot_iterator<set_type> end() const noexcept
+    {
+        return detail::set_snapshot_iterator<set_type>(set_type{}, set_type::capacity());
+    }
+
+}; // class value_set_view
+
+template <typename Set>
+constexpr size_t value_set_view<Set>::byte_count;
+
+}  // namespace enum_set
+
+#endif // ENUM_SET_VALUE_SET_VIEW_HPP
@@ -0,0 +1,607 @@
+#ifndef ENUM_SET_WORD_KERNELS_HPP
+#define ENUM_SET_WORD_KERNELS_HPP
+
+#include <enum_set/bit_operations.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <type_traits>
+
+/// Detects if the compiler can tell constant evaluation apart from runtime evaluation.
+/// Vectorized kernels are not constexpr, so they are only used when this is available.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ENUM_SET_HAS_CONSTANT_EVALUATED 1
+#endif
+#endif
+#ifndef ENUM_SET_HAS_CONSTANT_EVALUATED
+#define ENUM_SET_HAS_CONSTANT_EVALUATED 0
+#endif
+
+/// Width in bits of the vector registers used by the vectorized word kernels,
+/// picked at compile time from the target flags (e.g. `-mavx2` or `-march=native`).
+/// A width of 0 means that only the scalar kernels are used.
+/// Define `ENUM_SET_DISABLE_SIMD` to always use the scalar kernels.
+#if defined(ENUM_SET_DISABLE_SIMD) || !ENUM_SET_HAS_CONSTANT_EVALUATED
+#define ENUM_SET_SIMD_WIDTH 0
+#elif defined(__AVX512F__)
+#define ENUM_SET_SIMD_WIDTH 512
+#elif defined(__AVX2__)
+#define ENUM_SET_SIMD_WIDTH 256
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENUM_SET_SIMD_WIDTH 128
+#else
+#define ENUM_SET_SIMD_WIDTH 0
+#endif
+
+#if ENUM_SET_SIMD_WIDTH > 0
+#include <immintrin.h>
+#endif
+
+namespace enum_set
+{
+namespace detail
+{
+
+/// Word by word implementations of the bulk operations of a `bit_mask`.
+/// Every kernel operates on `count` words, and the in place kernels store their result in `lhs`.
+/// These are constexpr and work for any unsigned word type.
+struct scalar_kernels
+{
+    template <typename Word>
+    static constexpr void bitwise_or(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            lhs[index] |= rhs[index];
+        }
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_and(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            lhs[index] &= rhs[index];
+        }
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_xor(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            lhs[index] ^= rhs[index];
+        }
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_and_not(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            lhs[index] &= static_cast<Word>(~rhs[index]);
+        }
+    }
+
+    template <typename Word>
+    static constexpr bool equal(Word const* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            if (lhs[index] != rhs[index])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Word>
+    static constexpr bool subset(Word const* lhs, Word const* rhs, size_t count) noexcept
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            if ((lhs[index] & ~rhs[index]) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Word>
+    static constexpr size_t popcount(Word const* words, size_t count) noexcept
+    {
+        size_t result = 0;
+        for (size_t index = 0; index < count; ++index)
+        {
+            result += detail::popcount(words[index]);
+        }
+        return result;
+    }
+
+    /// Writes the positions of the set bits in increasing order to `output`, at most `capacity`
+    /// of them, and returns the number of positions written. The position of bit `i` of word
+    /// `k` is `offset + k * W + i`, where `W` is the number of bits in `Word`.
+    /// Skips to each non-zero byte with count trailing zeros and looks up the positions of its
+    /// set bits in the `byte_select_table`. While there is room, all eight table entries of a
+    /// byte are written and the output advances by the number of set bits in the byte, so
+    /// entries after the returned count may be overwritten.
+    template <typename Word, typename Index>
+    static constexpr size_t
+    extract(Word const* words, size_t count, Index* output, size_t capacity, size_t offset) noexcept
+    {
+        size_t written = 0;
+        for (size_t index = 0; index < count; ++index)
+        {
+            Word word = words[index];
+            while (word != 0)
+            {
+                const size_t shift = count_trailing_zeros(word) & ~size_t{7};
+                const uint8_t byte = static_cast<uint8_t>(word >> shift);
+                const uint8_t* positions = byte_select<>::table.positions[byte];
+                const size_t base = offset + index * 8 * sizeof(Word) + shift;
+                const size_t bits = byte_select<>::table.counts[byte];
+                word = static_cast<Word>(word & ~static_cast<Word>(Word{0xFF} << shift));
+                if (capacity - written >= 8)
+                {
+                    for (size_t k = 0; k < 8; ++k)
+                    {
+                        output[written + k] = static_cast<Index>(base + positions[k]);
+                    }
+                    written += bits;
+                    continue;
+                }
+                for (size_t k = 0; k < bits && written < capacity; ++k)
+                {
+                    output[written++] = static_cast<Index>(base + positions[k]);
+                }
+                if (written == capacity)
+                {
+                    return written;
+                }
+            }
+        }
+        return written;
+    }
+};
+
+#if ENUM_SET_SIMD_WIDTH == 512
+
+/// Writes the positions of the set bits of a 64-bit word with AVX-512 `vpcompress`,
+/// for indices of `IndexSize` bytes. The primary template is used for unsupported sizes.
+template <size_t IndexSize>
+struct simd_compressor
+{
+    static constexpr bool available = false;
+};
+
+/// Compresses 32-bit positions, 16 bits of the word at a time (AVX-512F).
+template <>
+struct simd_compressor<4>
+{
+    static constexpr bool available = true;
+
+    /// Writes `base` plus the positions of the set bits of `word` to `output`, which must have
+    /// room for 64 positions, and returns the number of set bits.
+    static size_t compress(uint64_t word, size_t base, void* output) noexcept
+    {
+        static constexpr uint32_t lanes[16] = {
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+        uint32_t* positions = static_cast<uint32_t*>(output);
+        size_t written = 0;
+        for (size_t chunk = 0; chunk < 64; chunk += 16)
+        {
+            const __mmask16 bits = static_cast<__mmask16>(word >> chunk);
+            const __m512i values = _mm512_add_epi32(
+                _mm512_loadu_si512(lanes), _mm512_set1_epi32(static_cast<int>(base + chunk)));
+            _mm512_storeu_si512(positions + written, _mm512_maskz_compress_epi32(bits, values));
+            written += popcount(bits);
+        }
+        return written;
+    }
+};
+
+#if defined(__AVX512VBMI2__)
+/// Compresses 16-bit positions, 32 bits of the word at a time (AVX-512 VBMI2).
+template <>
+struct simd_compressor<2>
+{
+    static constexpr bool available = true;
+
+    /// Writes `base` plus the positions of the set bits of `word` to `output`, which must have
+    /// room for 64 positions, and returns the number of set bits.
+    static size_t compress(uint64_t word, size_t base, void* output) noexcept
+    {
+        static constexpr uint16_t lanes[32] = {
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+            16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
+        uint16_t* positions = static_cast<uint16_t*>(output);
+        size_t written = 0;
+        for (size_t chunk = 0; chunk < 64; chunk += 32)
+        {
+            const __mmask32 bits = static_cast<__mmask32>(word >> chunk);
+            const __m512i values = _mm512_add_epi16(
+                _mm512_loadu_si512(lanes), _mm512_set1_epi16(static_cast<short>(base + chunk)));
+            _mm512_storeu_si512(positions + written, _mm512_maskz_compress_epi16(bits, values));
+            written += popcount(bits);
+        }
+        return written;
+    }
+};
+#endif
+
+#endif // ENUM_SET_SIMD_WIDTH == 512
+
+#if ENUM_SET_SIMD_WIDTH > 0
+
+/// Vectorized implementations of the `scalar_kernels` for 64-bit words.
+/// Processes `ENUM_SET_SIMD_WIDTH` bits at a time with unaligned loads and stores,
+/// and hands any remaining words to the scalar kernels.
+/// These are not constexpr, see `word_kernels` for the dispatch between the two.
+struct simd_kernels
+{
+#if ENUM_SET_SIMD_WIDTH == 512
+    using vector = __m512i;
+    static vector load(uint64_t const* words) noexcept { return _mm512_loadu_si512(words); }
+    static void store(uint64_t* words, vector x) noexcept { _mm512_storeu_si512(words, x); }
+    static vector vor(vector a, vector b) noexcept { return _mm512_or_si512(a, b); }
+    static vector vand(vector a, vector b) noexcept { return _mm512_and_si512(a, b); }
+    static vector vxor(vector a, vector b) noexcept { return _mm512_xor_si512(a, b); }
+    // Computed as a ^ (a & b), since GCC 12 warns about `_mm512_andnot_si512`.
+    static vector vand_not(vector a, vector b) noexcept
+    {
+        return _mm512_xor_si512(a, _mm512_and_si512(a, b));
+    }
+    static bool is_zero(vector a) noexcept { return _mm512_test_epi64_mask(a, a) == 0; }
+#elif ENUM_SET_SIMD_WIDTH == 256
+    using vector = __m256i;
+    static vector load(uint64_t const* words) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<vector const*>(words));
+    }
+    static void store(uint64_t* words, vector x) noexcept
+    {
+        _mm256_storeu_si256(reinterpret_cast<vector*>(words), x);
+    }
+    static vector vor(vector a, vector b) noexcept { return _mm256_or_si256(a, b); }
+    static vector vand(vector a, vector b) noexcept { return _mm256_and_si256(a, b); }
+    static vector vxor(vector a, vector b) noexcept { return _mm256_xor_si256(a, b); }
+    static vector vand_not(vector a, vector b) noexcept { return _mm256_andnot_si256(b, a); }
+    static bool is_zero(vector a) noexcept { return _mm256_testz_si256(a, a) != 0; }
+#else
+    using vector = __m128i;
+    static vector load(uint64_t const* words) noexcept
+    {
+        return _mm_loadu_si128(reinterpret_cast<vector const*>(words));
+    }
+    static void store(uint64_t* words, vector x) noexcept
+    {
+        _mm_storeu_si128(reinterpret_cast<vector*>(words), x);
+    }
+    static vector vor(vector a, vector b) noexcept { return _mm_or_si128(a, b); }
+    static vector vand(vector a, vector b) noexcept { return _mm_and_si128(a, b); }
+    static vector vxor(vector a, vector b) noexcept { return _mm_xor_si128(a, b); }
+    static vector vand_not(vector a, vector b) noexcept { return _mm_andnot_si128(b, a); }
+    static bool is_zero(vector a) noexcept
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128())) == 0xFFFF;
+    }
+#endif
+
+    /// Number of 64-bit words per vector.
+    static constexpr size_t lane_words = ENUM_SET_SIMD_WIDTH / 64;
+
+    /// Returns the number of words out of `count` that fill whole vectors.
+    static size_t vectorized(size_t count) noexcept
+    {
+        return count - count % lane_words;
+    }
+
+    /// Applies a binary vector operation in place over `count` words, `count` being a multiple
+    /// of the number of words per vector.
+    template <typename Operation>
+    static void
+    apply(uint64_t* lhs, uint64_t const* rhs, size_t count, Operation operation) noexcept
+    {
+        for (size_t index = 0; index < count; index += lane_words)
+        {
+            store(lhs + index, operation(load(lhs + index), load(rhs + index)));
+        }
+    }
+
+    /// Returns `true` if a binary vector operation yields zero over `count` words, `count` being a
+    /// multiple of the number of words per vector.
+    template <typename Operation>
+    static bool
+    all_zero(uint64_t const* lhs, uint64_t const* rhs, size_t count, Operation operation) noexcept
+    {
+        for (size_t index = 0; index < count; index += lane_words)
+        {
+            if (!is_zero(operation(load(lhs + index), load(rhs + index))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void bitwise_or(uint64_t* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        apply(lhs, rhs, vector_count, [](vector a, vector b) { return vor(a, b); });
+        scalar_kernels::bitwise_or(lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    static void bitwise_and(uint64_t* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        apply(lhs, rhs, vector_count, [](vector a, vector b) { return vand(a, b); });
+        scalar_kernels::bitwise_and(lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    static void bitwise_xor(uint64_t* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        apply(lhs, rhs, vector_count, [](vector a, vector b) { return vxor(a, b); });
+        scalar_kernels::bitwise_xor(lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    static void bitwise_and_not(uint64_t* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        apply(lhs, rhs, vector_count, [](vector a, vector b) { return vand_not(a, b); });
+        scalar_kernels::bitwise_and_not(
+            lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    static bool equal(uint64_t const* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        return all_zero(lhs, rhs, vector_count, [](vector a, vector b) { return vxor(a, b); })
+            && scalar_kernels::equal(lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    static bool subset(uint64_t const* lhs, uint64_t const* rhs, size_t count) noexcept
+    {
+        const size_t vector_count = vectorized(count);
+        return all_zero(lhs, rhs, vector_count, [](vector a, vector b) { return vand_not(a, b); })
+            && scalar_kernels::subset(lhs + vector_count, rhs + vector_count, count - vector_count);
+    }
+
+    /// Counts set bits with `vpopcntq` if available (AVX-512 VPOPCNTDQ), otherwise with the
+    /// nibble lookup table method using `vpshufb` if AVX2 is available, otherwise word by word.
+    static size_t popcount(uint64_t const* words, size_t count) noexcept
+    {
+        size_t index = 0;
+        size_t result = 0;
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+        __m512i sum = _mm512_setzero_si512();
+        for (; index + 8 <= count; index += 8)
+        {
+            sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(_mm512_loadu_si512(words + index)));
+        }
+        uint64_t lanes[8];
+        _mm512_storeu_si512(lanes, sum);
+        for (uint64_t lane : lanes)
+        {
+            result += static_cast<size_t>(lane);
+        }
+#elif defined(__AVX2__)
+        const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+        __m256i sum = _mm256_setzero_si256();
+        for (; index + 4 <= count; index += 4)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(words + index));
+            const __m256i low = _mm256_and_si256(x, low_nibbles);
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), low_nibbles);
+            const __m256i bytes = _mm256_add_epi8(
+                _mm256_shuffle_epi8(lookup, low),
+                _mm256_shuffle_epi8(lookup, high));
+            sum = _mm256_add_epi64(sum, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+        }
+        result += static_cast<size_t>(_mm256_extract_epi64(sum, 0))
+                + static_cast<size_t>(_mm256_extract_epi64(sum, 1))
+                + static_cast<size_t>(_mm256_extract_epi64(sum, 2))
+                + static_cast<size_t>(_mm256_extract_epi64(sum, 3));
+#endif
+        return result + scalar_kernels::popcount(words + index, count - index);
+    }
+
+#if ENUM_SET_SIMD_WIDTH == 512
+    /// Writes the positions of the set bits in increasing order to `output`, like
+    /// `scalar_kernels::extract`, compressing the positions of each word with `vpcompress`
+    /// while there is room for a whole word of positions. See `simd_compressor` for the
+    /// supported `Index` types.
+    template <typename Index>
+    static size_t
+    extract(uint64_t const* words, size_t count, Index* output, size_t capacity) noexcept
+    {
+        size_t written = 0;
+        size_t index = 0;
+        for (; index < count && capacity - written >= 64; ++index)
+        {
+            if (words[index] != 0)
+            {
+                written += simd_compressor<sizeof(Index)>::compress(
+                    words[index], 64 * index, output + written);
+            }
+        }
+        return written + scalar_kernels::extract(
+            words + index, count - index, output + written, capacity - written, 64 * index);
+    }
+#endif
+};
+
+#endif // ENUM_SET_SIMD_WIDTH > 0
+
+/// Dispatches the bulk operations of a `bit_mask` to either the `scalar_kernels`
+/// or the `simd_kernels`. The vectorized kernels are used for runtime evaluation of arrays of
+/// 64-bit words spanning at least one vector, everything else uses the scalar kernels.
+struct word_kernels
+{
+#if ENUM_SET_SIMD_WIDTH > 0
+    /// Returns `true` if the vectorized kernels should be used for `count` words of type `Word`.
+    template <typename Word>
+    static constexpr bool use_simd(size_t count) noexcept
+    {
+        return std::is_same<Word, uint64_t>::value
+            && count >= simd_kernels::lane_words
+            && !__builtin_is_constant_evaluated();
+    }
+
+    /// Reinterprets words as 64-bit words, only called if `Word` is `uint64_t`.
+    template <typename Word>
+    static uint64_t* words(Word* values) noexcept
+    {
+        return reinterpret_cast<uint64_t*>(values);
+    }
+
+    /// Reinterprets words as 64-bit words, only called if `Word` is `uint64_t`.
+    template <typename Word>
+    static uint64_t const* words(Word const* values) noexcept
+    {
+        return reinterpret_cast<uint64_t const*>(values);
+    }
+#else
+    /// Returns `true` if the vectorized kernels should be used, which is never the case
+    /// when the vectorized kernels are disabled.
+    template <typename Word>
+    static constexpr bool use_simd(size_t) noexcept
+    {
+        return false;
+    }
+#endif
+
+    template <typename Word>
+    static constexpr void bitwise_or(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::bitwise_or(words(lhs), words(rhs), count);
+        }
+#endif
+        scalar_kernels::bitwise_or(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_and(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::bitwise_and(words(lhs), words(rhs), count);
+        }
+#endif
+        scalar_kernels::bitwise_and(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_xor(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::bitwise_xor(words(lhs), words(rhs), count);
+        }
+#endif
+        scalar_kernels::bitwise_xor(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr void bitwise_and_not(Word* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::bitwise_and_not(words(lhs), words(rhs), count);
+        }
+#endif
+        scalar_kernels::bitwise_and_not(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr bool equal(Word const* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::equal(words(lhs), words(rhs), count);
+        }
+#endif
+        return scalar_kernels::equal(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr bool subset(Word const* lhs, Word const* rhs, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::subset(words(lhs), words(rhs), count);
+        }
+#endif
+        return scalar_kernels::subset(lhs, rhs, count);
+    }
+
+    template <typename Word>
+    static constexpr size_t popcount(Word const* words, size_t count) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH > 0
+        if (use_simd<Word>(count))
+        {
+            return simd_kernels::popcount(word_kernels::words(words), count);
+        }
+#endif
+        return scalar_kernels::popcount(words, count);
+    }
+
+    template <typename Word, typename Index>
+    static constexpr size_t
+    extract(Word const* words, size_t count, Index* output, size_t capacity) noexcept
+    {
+#if ENUM_SET_SIMD_WIDTH == 512
+        using compressible = std::integral_constant<bool,
+            std::is_same<Word, uint64_t>::value
+            && std::is_integral<Index>::value
+            && simd_compressor<sizeof(Index)>::available>;
+        return extract(words, count, output, capacity, compressible{});
+#else
+        return scalar_kernels::extract(words, count, output, capacity, 0);
+#endif
+    }
+
+#if ENUM_SET_SIMD_WIDTH == 512
+private:
+    /// Extracts with `vpcompress` at runtime, `Word` is `uint64_t`.
+    template <typename Word, typename Index>
+    static constexpr size_t
+    extract(Word const* words, size_t count, Index* output, size_t capacity, std::true_type)
+        noexcept
+    {
+        if (!__builtin_is_constant_evaluated())
+        {
+            return simd_kernels::extract(word_kernels::words(words), count, output, capacity);
+        }
+        return scalar_kernels::extract(words, count, output, capacity, 0);
+    }
+
+    /// Extracts with the `scalar_kernels`, for words or indices `vpcompress` does not support.
+    template <typename Word, typename Index>
+    static constexpr size_t
+    extract(Word const* words, size_t count, Index* output, size_t capacity, std::false_type)
+        noexcept
+    {
+        return scalar_kernels::extract(words, count, output, capacity, 0);
+    }
+#endif
+};
+
+}  // namespace detail
+}  // namespace enum_set
+
+#endif // ENUM_SET_WORD_KERNELS_HPP
@@ -0,0 +1,259 @@
+#include "testing.hpp"
+
+#include <enum_set/magic/magic_enum_ingest.hpp>
+#include <enum_set/magic/magic_enum_set.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+enum class permission
+{
+    READ,
+    WRITE,
+    EXEC,
+    DELETE
+};
+
+using permission_set = enum_set::make_magic_enum_set<permission>;
+
+/// Returns a CSV export of `rows` rows, with the names in the second field.
+std::string make_export(size_t rows)
+{
+    static char const* const names[] = {"", "READ", "WRITE|EXEC", "DELETE|READ", "EXEC"};
+    std::string result = "id,permissions,owner\n";
+    for (size_t row = 0; row < rows; ++row)
+    {
+        result += std::to_string(row) + "," + names[row % 5] + ",someone\n";
+    }
+    return result;
+}
+
+/// Returns the set of row `row` of `make_export`.
+permission_set expected_row(size_t row)
+{
+    switch (row % 5)
+    {
+        case 1: return permission_set{permission::READ};
+        case 2: return permission_set{permission::WRITE, permission::EXEC};
+        case 3: return permission_set{permission::DELETE, permission::READ};
+        case 4: return permission_set{permission::EXEC};
+        default: return permission_set{};
+    }
+}
+
+}  // namespace
+
+namespace enum_set
+{
+
+TEST_CASE("find_either finds the first of two characters")
+{
+    const std::string text = std::string(40, 'x') + ",y\nz";
+    char const* const first = text.data();
+    char const* const last = first + text.size();
+    CHECK(detail::find_either(first, last, ',', '\n') == first + 40);
+    CHECK(detail::find_either(first, last, '\n', 'z') == first + 42);
+    CHECK(detail::find_either(first, last, '#', '$') == last);
+    CHECK(detail::find_either(first + 41, last, ',', '\n') == first + 42);
+    CHECK(detail::count_rows(first, last) == 2);
+    CHECK(detail::count_rows(first, first) == 0);
+}
+
+TEST_CASE("ingest rows of a chunk")
+{
+    const std::string text = "1,READ|WRITE\n\n2,\r\n3, EXEC ,extra\r\n4,DELETE";
+    permission_set output[8];
+    const auto result = ingest(text.data(), text.size(), csv_format(1), output, 8);
+    CHECK(result.status == ingest_status::done);
+    CHECK(result.rows == 4);
+    CHECK(result.consumed == text.size());
+    CHECK(output[0] == permission_set{permission::READ, permission::WRITE});
+    CHECK(output[1].empty());
+    CHECK(output[2] == permission_set{permission::EXEC});
+    CHECK(output[3] == permission_set{permission::DELETE});
+
+    const auto partial = ingest(text.data(), text.size(), csv_format(1), output, 8, false);
+    CHECK(partial.status == ingest_status::done);
+    CHECK(partial.rows == 3);
+    CHECK(partial.consumed == text.rfind('\n') + 1);
+
+    const std::string tsv = "READ\tx\nWRITE,EXEC\ty\n";
+    const auto tabs = ingest(tsv.data(), tsv.size(), tsv_format(0, ','), output, 8);
+    CHECK(tabs.rows == 2);
+    CHECK(output[1] == permission_set{permission::WRITE, permission::EXEC});
+}
+
+TEST_CASE("ingest stops at malformed rows and full output")
+{
+    const std::string text = "1,READ\n2,WRIT\n3,EXEC\n";
+    permission_set output[4];
+    const auto malformed = ingest(text.data(), text.size(), csv_format(1), output, 4);
+    CHECK(malformed.status == ingest_status::malformed_row);
+    CHECK(malformed.rows == 1);
+    CHECK(malformed.consumed == 7);
+
+    const std::string missing = "1,READ\n2\n";
+    const auto too_few = ingest(missing.data(), missing.size(), csv_format(1), output, 4);
+    CHECK(too_few.status == ingest_status::malformed_row);
+    CHECK(too_few.consumed == 7);
+
+    const std::string valid = "1,READ\n\n2,WRITE\n";
+    const auto full = ingest(valid.data(), valid.size(), csv_format(1), output, 1);
+    CHECK(full.status == ingest_status::output_full);
+    CHECK(full.rows == 1);
+    CHECK(full.consumed == 8);
+}
+
+TEST_CASE("ingest in parallel matches a single thread")
+{
+    const std::string text = make_export(10000);
+    const size_t header = text.find('\n') + 1;
+    std::vector<permission_set> output(10000);
+    for (const size_t threads : {1, 2, 3, 8})
+    {
+        std::fill(output.begin(), output.end(), permission_set{});
+        const auto result = ingest_parallel(text.data() + header, text.size() - header,
+                                            csv_format(1), output.data(), output.size(), threads);
+        CHECK(result.status == ingest_status::done);
+        CHECK(result.rows == 10000);
+        CHECK(result.consumed == text.size() - header);
+        bool all_match = true;
+        for (size_t row = 0; row < output.size(); ++row)
+        {
+            all_match = all_match && output[row] == expected_row(row);
+        }
+        CHECK(all_match);
+    }
+
+    const auto full = ingest_parallel(text.data() + header, text.size() - header,
+                                      csv_format(1), output.data(), 5000, 4);
+    CHECK(full.status == ingest_status::output_full);
+    CHECK(full.rows == 5000);
+
+    std::string broken = text;
+    broken.replace(broken.find(",EXEC,", text.size() / 2), 6, ",EXCE,");
+    const auto malformed = ingest_parallel(broken.data() + header, broken.size() - header,
+                                           csv_format(1), output.data(), output.size(), 4);
+    CHECK(malformed.status == ingest_status::malformed_row);
+    const std::string id = std::to_string(malformed.rows) + ",EXCE,";
+    CHECK(broken.compare(header + malformed.consumed, id.size(), id) == 0);
+}
+
+TEST_CASE("ingest stream reads chunks through a small buffer")
+{
+    const std::string text = make_export(1000);
+    size_t offset = 0;
+    auto source = [&text, &offset](char* buffer, size_t size)
+    {
+        const size_t read = std::min<size_t>({size, text.size() - offset, 7});
+        text.copy(buffer, read, offset);
+        offset += read;
+        return read;
+    };
+    char buffer[64];
+    auto stream = make_ingest_stream<permission_set>(
+        source, buffer, sizeof(buffer), csv_format(1), true);
+    std::vector<permission_set> output(300);
+    size_t rows = 0;
+    bool all_match = true;
+    while (const size_t read = stream.read(output.data(), output.size()))
+    {
+        for (size_t row = 0; row < read; ++row)
+        {
+            all_match = all_match && output[row] == expected_row(rows + row);
+        }
+        rows += read;
+    }
+    CHECK(all_match);
+    CHECK(rows == 1000);
+    CHECK(stream.read(output.data(), output.size()) == 0);
+
+    const std::string long_row = "1," + std::string(100, ' ') + "READ\n";
+    size_t long_offset = 0;
+    auto long_source = [&long_row, &long_offset](char* buffer, size_t size)
+    {
+        const size_t read = std::min(size, long_row.size() - long_offset);
+        long_row.copy(buffer, read, long_offset);
+        long_offset += read;
+        return read;
+    };
+    size_t long_reads = 0;
+    auto counted_source = [&long_source, &long_reads](char* buffer, size_t size)
+    {
+        CHECK(size != 0);
+        ++long_reads;
+        return long_source(buffer, size);
+    };
+    auto long_stream = make_ingest_stream<permission_set>(
+        counted_source, buffer, sizeof(buffer), csv_format(1));
+    CHECK_THROWS_AS(long_stream.read(output.data(), output.size()), std::out_of_range);
+    CHECK_THROWS_AS(long_stream.read(output.data(), output.size()), std::out_of_range);
+    CHECK(long_reads == 1);
+}
+
+TEST_CASE("ingest stream stops without the incomplete row on a failing source")
+{
+    const std::string text = "1,EXEC\n2,READ";
+    bool delivered = false;
+    auto failing_source = [&text, &delivered](char* buffer, size_t size)
+    {
+        if (delivered)
+        {
+            return ingest_read_error;
+        }
+        delivered = true;
+        return static_cast<size_t>(text.copy(buffer, size));
+    };
+    char buffer[64];
+    auto stream = make_ingest_stream<permission_set>(
+        failing_source, buffer, sizeof(buffer), csv_format(1));
+    permission_set output[4];
+    CHECK(!stream.failed());
+    CHECK(stream.read(output, 4) == 1);
+    CHECK(output[0] == permission_set{permission::EXEC});
+    CHECK(stream.failed());
+    CHECK(stream.read(output, 4) == 0);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("ingest stream reads a file descriptor")
+{
+    int pipe_handles[2];
+    REQUIRE(::pipe(pipe_handles) == 0);
+    const std::string text = "a,READ\nb,WRITE|DELETE\nc,";
+    const auto written = ::write(pipe_handles[1], text.data(), text.size());
+    REQUIRE(written == static_cast<ssize_t>(text.size()));
+    ::close(pipe_handles[1]);
+
+    char buffer[256];
+    auto stream = make_ingest_stream<permission_set>(
+        file_source{pipe_handles[0]}, buffer, sizeof(buffer), csv_format(1));
+    permission_set output[4];
+    CHECK(stream.read(output, 4) == 3);
+    CHECK(output[0] == permission_set{permission::READ});
+    CHECK(output[1] == permission_set{permission::WRITE, permission::DELETE});
+    CHECK(output[2].empty());
+    CHECK(!stream.failed());
+    CHECK(!stream.source().error);
+    ::close(pipe_handles[0]);
+
+    file_source invalid{-1};
+    CHECK(invalid(buffer, sizeof(buffer)) == ingest_read_error);
+    CHECK(invalid.error == std::errc::bad_file_descriptor);
+    auto failing = make_ingest_stream<permission_set>(
+        file_source{-1}, buffer, sizeof(buffer), csv_format(1));
+    CHECK(failing.read(output, 4) == 0);
+    CHECK(failing.failed());
+    CHECK(failing.source().error == std::errc::bad_file_descriptor);
+}
+#endif
+
+}  // namespace enum_set
@@ -0,0 +1,118 @@
+#include "testing.hpp"
+
+#include <enum_set/magic/magic_enum_names.hpp>
+#include <enum_set/magic/magic_enum_set.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace
+{
+
+enum class permission
+{
+    READ,
+    WRITE,
+    EXEC,
+    DELETE,
+    ADMIN
+};
+
+enum class letter
+{
+    a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z,
+    aa, bb, cc, dd, ee, ff, gg, hh, ii, jj, kk, ll, mm, nn, oo, pp, qq, rr, ss, tt
+};
+
+using permission_set = enum_set::make_magic_enum_set<permission>;
+using letter_set = enum_set::make_magic_enum_set<letter>;
+
+/// Formats a set into a string, through a buffer of the maximal size.
+template <typename Set>
+std::string format(Set const& set, char separator = '|')
+{
+    char buffer[enum_set::max_formatted_size<Set>()];
+    return std::string(buffer, enum_set::format_to(buffer, sizeof(buffer), set, separator));
+}
+
+}  // namespace
+
+namespace enum_set
+{
+
+TEST_CASE("name table stores the names back to back")
+{
+    using table = detail::name_table<permission_set>;
+    STATIC_CHECK(table::count == 5, "One name per value");
+    STATIC_CHECK(table::total_size == 24, "READ WRITE EXEC DELETE ADMIN");
+    STATIC_CHECK(table::offsets[1] == 4, "READ");
+    STATIC_CHECK(table::characters[4] == 'W', "WRITE follows READ");
+    STATIC_CHECK(table::hash.complete, "Every name has a slot");
+    STATIC_CHECK(max_formatted_size<permission_set>() == 28, "Names and four separators");
+}
+
+TEST_CASE("name table finds every name and only those")
+{
+    using table = detail::name_table<letter_set>;
+    for (size_t index = 0; index < table::count; ++index)
+    {
+        CHECK(table::index(table::names[index]) == index);
+    }
+    CHECK(table::index("") == table::count);
+    CHECK(table::index("A") == table::count);
+    CHECK(table::index("aaa") == table::count);
+    CHECK(table::index("zz") == table::count);
+}
+
+TEST_CASE("name hash table is incomplete for duplicate or empty names")
+{
+    constexpr std::array<std::string_view, 3> unique{{"a", "b", "c"}};
+    constexpr std::array<std::string_view, 3> duplicate{{"a", "b", "a"}};
+    constexpr std::array<std::string_view, 2> empty{{"a", ""}};
+    STATIC_CHECK(detail::make_name_hash_table(unique).complete, "Unique names are hashed");
+    STATIC_CHECK(!detail::make_name_hash_table(duplicate).complete, "Duplicates are rejected");
+    STATIC_CHECK(!detail::make_name_hash_table(empty).complete, "Empty names are rejected");
+}
+
+TEST_CASE("parse names separated by a separator")
+{
+    CHECK(parse<permission_set>("READ|WRITE|EXEC")
+        == permission_set{permission::READ, permission::WRITE, permission::EXEC});
+    CHECK(parse<permission_set>(" ADMIN | READ ")
+        == permission_set{permission::READ, permission::ADMIN});
+    CHECK(parse<permission_set>("DELETE,DELETE", ',') == permission_set{permission::DELETE});
+    CHECK(parse<permission_set>("").empty());
+    CHECK(parse<permission_set>("  ").empty());
+    CHECK(parse<letter_set>("tt|a|mm") == letter_set{letter::a, letter::mm, letter::tt});
+
+    permission_set set{permission::EXEC};
+    CHECK(!try_parse("READ|WRIT", set));
+    CHECK(!try_parse("READ||WRITE", set));
+    CHECK(!try_parse("READ|", set));
+    CHECK(!try_parse("read", set));
+    CHECK(set == permission_set{permission::EXEC});
+    CHECK(try_parse("WRITE", set));
+    CHECK(set == permission_set{permission::WRITE});
+    CHECK_THROWS_AS(parse<permission_set>("EXECUTE"), std::out_of_range);
+}
+
+TEST_CASE("format names in the order of the set")
+{
+    CHECK(format(permission_set{}).empty());
+    CHECK(format(permission_set{permission::EXEC}) == "EXEC");
+    CHECK(format(permission_set{permission::ADMIN, permission::READ}) == "READ|ADMIN");
+    CHECK(format(~permission_set{}, ',') == "READ,WRITE,EXEC,DELETE,ADMIN");
+    CHECK(format(letter_set{letter::z, letter::aa, letter::tt}) == "z|aa|tt");
+    CHECK(formatted_size(permission_set{permission::ADMIN, permission::READ}) == 10);
+
+    const permission_set set{permission::READ, permission::WRITE};
+    CHECK(parse<permission_set>(format(set)) == set);
+
+    char buffer[10] = {};
+    CHECK(format_to(buffer, 10, set) == 10);
+    CHECK(std::string_view(buffer, 10) == "READ|WRITE");
+    CHECK_THROWS_AS(format_to(buffer, 9, set), std::out_of_range);
+}
+
+}  // namespace enum_set
@@ -0,0 +1,151 @@
+#include "testing.hpp"
+
+#include <enum_set/adaptive_index_set.hpp>
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/codec.hpp>
+#include <enum_set/columnar.hpp>
+#include <enum_set/copy_on_write.hpp>
+#include <enum_set/dynamic_index_set.hpp>
+#include <enum_set/enum_set.hpp>
+#include <enum_set/flag_enum_set.hpp>
+#include <enum_set/index_set.hpp>
+#include <enum_set/index_set_visitor.hpp>
+#include <enum_set/integer_set.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/type_set.hpp>
+#include <enum_set/type_set_visitor.hpp>
+#include <enum_set/value_set.hpp>
+#include <enum_set/value_set_view.hpp>
+#include <enum_set/value_set_visitor.hpp>
+#include <enum_set/word_kernels.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <enum_set/mapped_index_set.hpp>
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+#include <sstream>
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+enum class color { red, green, blue };
+
+using color_set = make_enum_set<color, color::blue>;
+
+enum class flag : uint8_t { read = 1, write = 2, exec = 4 };
+
+using flag_set = make_flag_enum_set<flag, flag::exec>;
+
+}  // namespace
+
+static_assert(!ENUM_SET_HAS_EXCEPTIONS, "Built without exceptions");
+static_assert(ENUM_SET_BOUNDS_CHECK == ENUM_SET_BOUNDS_CHECK_UNCHECKED, "Built unchecked");
+
+TEST_CASE("try accessors of bit masks and index sets check bounds without exceptions")
+{
+    bit_mask<100> mask{};
+    bool bit = true;
+    CHECK(mask.try_set(99));
+    CHECK(!mask.try_set(100));
+    CHECK(mask.try_get(99, bit));
+    CHECK(bit);
+    CHECK(!mask.try_get(100, bit));
+    CHECK(mask.try_clear(99));
+    CHECK(!mask.try_clear(100));
+
+    make_index_set<10> indices{};
+    CHECK(indices.try_add(9));
+    CHECK(!indices.try_add(10));
+    CHECK(indices.try_remove(9));
+    CHECK(!indices.try_remove(10));
+    const std::vector<size_t> values{1, 2, 12, 3};
+    CHECK(indices.try_insert(values.begin(), values.end()) == values.begin() + 2);
+    CHECK(indices.empty());
+
+    dynamic_index_set dynamic(300);
+    CHECK(dynamic.try_add(299));
+    CHECK(!dynamic.try_add(300));
+    CHECK(dynamic.try_remove(299));
+    CHECK(!dynamic.try_remove(300));
+
+    adaptive_index_set<1000, 4> adaptive{};
+    CHECK(adaptive.try_add(999));
+    CHECK(!adaptive.try_add(1000));
+    CHECK(adaptive.try_remove(999));
+    CHECK(!adaptive.try_remove(1000));
+}
+
+TEST_CASE("try accessors of value sets check values without exceptions")
+{
+    color_set colors{};
+    CHECK(colors.try_add(color::green));
+    CHECK(!colors.try_add(static_cast<color>(7)));
+    CHECK(!colors.try_remove(static_cast<color>(7)));
+    CHECK(colors.try_remove(color::green));
+    CHECK(colors.empty());
+
+    flag_set flags{};
+    CHECK(try_from_flags(uint8_t{5}, flags));
+    CHECK(flags == flag_set{flag::read, flag::exec});
+    CHECK(!try_from_flags(uint8_t{8}, flags));
+    CHECK(to_flags(flags) == 5);
+}
+
+TEST_CASE("decoding and writing report errors without exceptions")
+{
+    const make_index_set<64> set{1, 40};
+    unsigned char buffer[64];
+    const size_t size = encode(set, buffer, sizeof(buffer));
+    make_index_set<64> decoded{};
+    CHECK(try_decode(buffer, size, decoded) == size);
+    CHECK(decoded == set);
+    CHECK(try_decode(buffer, 0, decoded) == 0);
+
+    std::ostringstream stream;
+    columnar_writer<color_set> writer(stream, true, 2);
+    CHECK(writer.try_write(color_set{color::red}));
+    stream.setstate(std::ios_base::badbit);
+    CHECK(!writer.try_write(color_set{color::blue}));
+    stream.clear();
+    CHECK(writer.try_flush());
+    CHECK(writer.size() == 2);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("mapped index sets report errors without exceptions")
+{
+    std::string path{"/tmp/enum_set_no_exceptions_XXXXXX"};
+    const int handle = ::mkstemp(&path[0]);
+    CHECK(handle >= 0);
+    ::close(handle);
+
+    std::error_code error;
+    auto set = mapped_index_set::try_open(path, map_mode::read_only, error);
+    CHECK(error == std::errc::invalid_argument);
+    set = mapped_index_set::try_create(path, 128, error);
+    CHECK(!error);
+    CHECK(set.try_add(127));
+    CHECK(!set.try_add(128));
+    set.sync(error);
+    CHECK(!error);
+    CHECK(set.has(127));
+    auto read_only = mapped_index_set::try_open(path, map_mode::read_only, error);
+    CHECK(!error);
+    CHECK(!read_only.try_add(1));
+    CHECK(!read_only.try_remove(127));
+    CHECK(read_only.has(127));
+    std::remove(path.c_str());
+}
+#endif
+
+}  // namespace enum_set
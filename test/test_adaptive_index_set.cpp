@@ -0,0 +1,233 @@
+#include "testing.hpp"
+
+#include <enum_set/adaptive_index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+/// Small threshold, so that both representations and the conversions between them are tested.
+using small_set = adaptive_index_set<1000, 16>;
+
+/// Returns the elements of a set in iteration order.
+template <typename Set>
+std::vector<size_t> elements_of(Set const& set)
+{
+    return std::vector<size_t>(set.begin(), set.end());
+}
+
+/// Returns an adaptive index set and a reference set of `count` random indices.
+small_set random_set(std::mt19937& engine, size_t count, std::set<size_t>& reference)
+{
+    std::uniform_int_distribution<size_t> distribution(0, small_set::capacity() - 1);
+    small_set result{};
+    reference.clear();
+    for (size_t k = 0; k < count; ++k)
+    {
+        const size_t index = distribution(engine);
+        result.add(index);
+        reference.insert(index);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("adaptive index set picks the smallest index type and a matching threshold")
+{
+    STATIC_CHECK(
+        (std::is_same<adaptive_index_set<65536>::index_type, uint16_t>::value),
+        "Indices below 2^16 are stored as 16-bit integers");
+    STATIC_CHECK(
+        (std::is_same<adaptive_index_set<65537>::index_type, uint32_t>::value),
+        "Indices from 2^16 are stored as 32-bit integers");
+    STATIC_CHECK(adaptive_index_set<65536>::threshold() == 4096, "Array is at most 8 KiB");
+    STATIC_CHECK(adaptive_index_set<8>::threshold() == 1, "Threshold is at least one");
+}
+
+TEST_CASE("adaptive index set switches representation at the threshold")
+{
+    small_set x{};
+    CHECK(x.is_sparse());
+    for (size_t index = 0; index < 16; ++index)
+    {
+        x.add(index * 10);
+    }
+    CHECK(x.is_sparse());
+    x.add(999);
+    CHECK(!x.is_sparse());
+    CHECK(x.size() == 17);
+    x.add(999);
+    CHECK(x.size() == 17);
+    x.remove(999);
+    x.remove(0);
+    CHECK(!x.is_sparse());
+    for (size_t index = 1; index < 8; ++index)
+    {
+        x.remove(index * 10);
+    }
+    CHECK(x.is_sparse());
+    CHECK(x.size() == 8);
+    CHECK(elements_of(x) == std::vector<size_t>{80, 90, 100, 110, 120, 130, 140, 150});
+}
+
+TEST_CASE("adaptive index set membership and iteration follow index_set")
+{
+    for (const size_t count : {5, 500})
+    {
+        std::mt19937 engine(42);
+        std::set<size_t> reference;
+        const small_set x = random_set(engine, count, reference);
+        CHECK(x.is_sparse() == (count == 5));
+        CHECK(x.size() == reference.size());
+        CHECK(elements_of(x) == std::vector<size_t>(reference.begin(), reference.end()));
+        CHECK(std::vector<size_t>(x.rbegin(), x.rend())
+              == std::vector<size_t>(reference.rbegin(), reference.rend()));
+        CHECK(x.front() == *reference.begin());
+        CHECK(x.back() == *reference.rbegin());
+        for (size_t index = 0; index < small_set::capacity(); ++index)
+        {
+            CHECK(x.has(index) == (reference.count(index) == 1));
+        }
+        CHECK(!x.has(1000));
+        std::vector<uint32_t> written(x.size());
+        CHECK(x.to_indices(written.data(), written.size()) == x.size());
+        CHECK(std::vector<size_t>(written.begin(), written.end()) == elements_of(x));
+    }
+}
+
+TEST_CASE("adaptive index set reports invalid indices")
+{
+    small_set x{};
+    CHECK(!x.try_add(1000));
+    CHECK(!x.try_remove(1000));
+    CHECK_THROWS(x.add(1000));
+    CHECK_THROWS(x.remove(1000));
+    CHECK_THROWS(x.front());
+    CHECK_THROWS(x.back());
+    CHECK_THROWS(*x.begin());
+    CHECK_THROWS((small_set{1, 1000}));
+}
+
+TEST_CASE("set algebra on adaptive index sets works across representations")
+{
+    std::mt19937 engine(7);
+    for (const size_t first_count : {0, 3, 12, 40, 700})
+    {
+        for (const size_t second_count : {0, 2, 14, 60, 900})
+        {
+            std::set<size_t> a;
+            std::set<size_t> b;
+            const small_set x = random_set(engine, first_count, a);
+            const small_set y = random_set(engine, second_count, b);
+            std::set<size_t> expected_union = a;
+            expected_union.insert(b.begin(), b.end());
+            std::vector<size_t> expected_intersection;
+            std::vector<size_t> expected_difference;
+            std::vector<size_t> expected_symmetric;
+            for (size_t index = 0; index < small_set::capacity(); ++index)
+            {
+                const bool in_a = a.count(index) == 1;
+                const bool in_b = b.count(index) == 1;
+                if (in_a && in_b)
+                {
+                    expected_intersection.push_back(index);
+                }
+                if (in_a && !in_b)
+                {
+                    expected_difference.push_back(index);
+                }
+                if (in_a != in_b)
+                {
+                    expected_symmetric.push_back(index);
+                }
+            }
+            const auto check = [](small_set const& result, std::vector<size_t> const& expected)
+            {
+                CHECK(elements_of(result) == expected);
+                CHECK(result.size() == expected.size());
+                CHECK(result.is_sparse() == (expected.size() <= small_set::threshold()));
+            };
+            check(x | y, std::vector<size_t>(expected_union.begin(), expected_union.end()));
+            check(x & y, expected_intersection);
+            check(x / y, expected_difference);
+            check(x ^ y, expected_symmetric);
+
+            small_set z = x;
+            z |= y;
+            CHECK(z == (x | y));
+            z = x;
+            z &= y;
+            CHECK(z == (x & y));
+            z = x;
+            z /= y;
+            CHECK(z == (x / y));
+            z = x;
+            z ^= y;
+            CHECK(z == (x ^ y));
+
+            CHECK((x & y) <= x);
+            CHECK((x & y) <= y);
+            CHECK(x <= (x | y));
+            CHECK((x <= y) == std::includes(b.begin(), b.end(), a.begin(), a.end()));
+            CHECK((x == y) == (a == b));
+            CHECK((x < (x | y)) == (a.size() < expected_union.size()));
+        }
+    }
+}
+
+TEST_CASE("galloping finds the first element not less than a value")
+{
+    const uint16_t sorted[] = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+    for (size_t value = 0; value < 22; ++value)
+    {
+        CHECK(detail::gallop(std::begin(sorted), std::end(sorted), value)
+              == std::lower_bound(std::begin(sorted), std::end(sorted), value));
+    }
+    CHECK(detail::gallop(std::begin(sorted), std::begin(sorted), 5) == std::begin(sorted));
+}
+
+TEST_CASE("galloping intersection and difference of sorted arrays of different sizes")
+{
+    adaptive_index_set<1000, 1000> large{};
+    for (size_t index = 0; index < 1000; index += 5)
+    {
+        large.add(index);
+    }
+    CHECK(large.is_sparse());
+    adaptive_index_set<1000, 1000> small{5, 7, 500, 995, 999};
+    CHECK(elements_of(small & large) == std::vector<size_t>{5, 500, 995});
+    CHECK(elements_of(large & small) == std::vector<size_t>{5, 500, 995});
+    CHECK(elements_of(small / large) == std::vector<size_t>{7, 999});
+}
+
+TEST_CASE("adaptive index set copies and clears its bit mask")
+{
+    small_set x{};
+    for (size_t index = 0; index < 100; ++index)
+    {
+        x.add(index);
+    }
+    small_set y = x;
+    y.remove(0);
+    CHECK(x.size() == 100);
+    CHECK(y.size() == 99);
+    x = y;
+    CHECK(x == y);
+    x.clear();
+    CHECK(x.empty());
+    CHECK(x.is_sparse());
+    CHECK(x.begin() == x.end());
+}
+
+} // namespace enum_set
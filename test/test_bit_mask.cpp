@@ -2,100 +2,128 @@
 
 #include <enum_set/bit_mask.hpp>
 
+#include <iterator>
 #include <type_traits>
 
-using ::enum_set::detail::byte_storage;
 using ::enum_set::detail::bit_storage;
 using ::enum_set::detail::make_bit_storage;
-using ::enum_set::detail::make_byte;
+using ::enum_set::detail::word_storage;
+using ::enum_set::uint8_t;
+using ::enum_set::uint16_t;
+using ::enum_set::uint32_t;
+using ::enum_set::uint64_t;
 
 template <size_t N>
 using bit_mask = ::enum_set::bit_mask<N>;
 
-TEST_CASE("bit storage requires the expected number of bytes")
+TEST_CASE("bit storage uses the smallest exact width word that fits all bits")
 {
     STATIC_CHECK(
-        (std::is_same<bit_storage<1>, byte_storage<1>>::value),
-        "1 bit requires 1 byte storage");
+        (std::is_same<bit_storage<1>, word_storage<uint8_t, 1>>::value),
+        "1 bit requires a single 8-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<8>, byte_storage<1>>::value),
-        "8 bits requires 1 byte storage");
+        (std::is_same<bit_storage<8>, word_storage<uint8_t, 1>>::value),
+        "8 bits requires a single 8-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<9>, byte_storage<2>>::value),
-        "9 bits requires 2 bytes storage");
+        (std::is_same<bit_storage<9>, word_storage<uint16_t, 1>>::value),
+        "9 bits requires a single 16-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<16>, byte_storage<2>>::value),
-        "16 bits requires 2 bytes storage");
+        (std::is_same<bit_storage<16>, word_storage<uint16_t, 1>>::value),
+        "16 bits requires a single 16-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<17>, byte_storage<3>>::value),
-        "17 bits requires 3 bytes storage");
+        (std::is_same<bit_storage<17>, word_storage<uint32_t, 1>>::value),
+        "17 bits requires a single 32-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<24>, byte_storage<3>>::value),
-        "24 bits requires 3 bytes storage");
+        (std::is_same<bit_storage<32>, word_storage<uint32_t, 1>>::value),
+        "32 bits requires a single 32-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<25>, byte_storage<4>>::value),
-        "25 bits requires 4 bytes storage");
+        (std::is_same<bit_storage<33>, word_storage<uint64_t, 1>>::value),
+        "33 bits requires a single 64-bit word");
     STATIC_CHECK(
-        (std::is_same<bit_storage<32>, byte_storage<4>>::value),
-        "32 bits requires 4 bytes storage");
-    STATIC_CHECK(
-        (std::is_same<bit_storage<33>, byte_storage<5>>::value),
-        "33 bits requires 5 bytes storage");
+        (std::is_same<bit_storage<64>, word_storage<uint64_t, 1>>::value),
+        "64 bits requires a single 64-bit word");
 }
 
-TEST_CASE("make byte from bools returns the expected unsigned 8-bit integer")
+TEST_CASE("bit storage of a single word is a plain unsigned integer")
 {
+    STATIC_CHECK((std::is_same<bit_storage<8>, uint8_t>::value), "8 bits are stored in a uint8_t");
+    STATIC_CHECK((std::is_same<bit_storage<16>, uint16_t>::value), "16 bits in a uint16_t");
+    STATIC_CHECK((std::is_same<bit_storage<32>, uint32_t>::value), "32 bits in a uint32_t");
+    STATIC_CHECK((std::is_same<bit_storage<64>, uint64_t>::value), "64 bits in a uint64_t");
     STATIC_CHECK(
-        make_byte(false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false, false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false, false, false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false, false, false, false, false) == 0,
-        "Making a byte from false yields zero");
-    STATIC_CHECK(
-        make_byte(false, false, false, false, false, false, false, false) == 0,
-        "Making a byte from false yields zero");
+        (std::is_same<bit_storage<65>, ::enum_set::detail::array<uint64_t, 2>>::value),
+        "65 bits are stored in an array of words");
+}
+
+TEST_CASE("bit masks are trivially copyable and as small as their words")
+{
+    STATIC_CHECK(std::is_trivially_copyable<bit_mask<1>>::value, "Small bit mask");
+    STATIC_CHECK(std::is_trivially_copyable<bit_mask<64>>::value, "Single word bit mask");
+    STATIC_CHECK(std::is_trivially_copyable<bit_mask<200>>::value, "Multi word bit mask");
+    STATIC_CHECK(sizeof(bit_mask<7>) == 1 && alignof(bit_mask<7>) == 1, "7 bits in one byte");
+    STATIC_CHECK(sizeof(bit_mask<12>) == 2 && alignof(bit_mask<12>) == 2, "12 bits in two bytes");
+    STATIC_CHECK(sizeof(bit_mask<20>) == 4 && alignof(bit_mask<20>) == 4, "20 bits in four bytes");
+    STATIC_CHECK(sizeof(bit_mask<64>) == 8 && alignof(bit_mask<64>) == 8, "64 bits in one word");
+}
+
+TEST_CASE("bit storage spreads large bit counts over 64-bit words")
+{
     STATIC_CHECK(
-        make_byte(true) == 2-1,
-        "Making a byte from true yields power of two minus one");
+        (std::is_same<bit_storage<65>, word_storage<uint64_t, 2>>::value),
+        "65 bits requires two 64-bit words");
     STATIC_CHECK(
-        make_byte(true, true) == 4-1,
-        "Making a byte from all true yields power of two minus one");
+        (std::is_same<bit_storage<128>, word_storage<uint64_t, 2>>::value),
+        "128 bits requires two 64-bit words");
     STATIC_CHECK(
-        make_byte(true, true, true) == 8-1,
-        "Making a byte from all true yields power of two minus one");
+        (std::is_same<bit_storage<129>, word_storage<uint64_t, 3>>::value),
+        "129 bits requires three 64-bit words");
     STATIC_CHECK(
-        make_byte(true, true, true, true) == 16-1,
-        "Making a byte from all true yields power of two minus one");
+        (std::is_same<bit_storage<600>, word_storage<uint64_t, 10>>::value),
+        "600 bits requires ten 64-bit words");
+}
+
+TEST_CASE("make bit storage from bools sets the expected bits of each word")
+{
     STATIC_CHECK(
-        make_byte(true, true, true, true, true) == 32-1,
-        "Making a byte from all true yields power of two minus one");
+        make_bit_storage(false) == 0,
+        "Making storage from false yields zero");
     STATIC_CHECK(
-        make_byte(true, true, true, true, true, true) == 64-1,
-        "Making a byte from all true yields power of two minus one");
+        make_bit_storage(true) == 1,
+        "Making storage from true yields one");
     STATIC_CHECK(
-        make_byte(true, true, true, true, true, true, true) == 128-1,
-        "Making a byte from all true yields power of two minus one");
+        make_bit_storage(true, true, true, true, true, true, true, true) == 256-1,
+        "Making storage from all true yields power of two minus one");
     STATIC_CHECK(
-        make_byte(true, true, true, true, true, true, true, true) == 256-1,
-        "Making a byte from all true yields power of two minus one");
+        make_bit_storage(true, false, true, true, false, false, false, true) == 1 + 4 + 8 + 128,
+        "Making storage from mixed true and false yields expected value");
     STATIC_CHECK(
-        make_byte(true, false, true, true, false, false, false, true) == 1 + 4 + 8 + 128,
-        "Making a byte from all mixed true and false yields expected value");
+        make_bit_storage(false, false, false, false, false, false, false, false, true) == 256,
+        "Bits beyond the first byte end up in the same word");
+}
+
+TEST_CASE("make bit storage from many bools sets bits across word boundaries")
+{
+    constexpr auto storage = make_bit_storage(
+        true,  false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, false,
+        false, false, false, false, false, false, false, true,
+        false, true);
+    STATIC_CHECK(storage[0] == ((uint64_t{1} << 63) | 1), "First word holds bits 0 and 63");
+    STATIC_CHECK(storage[1] == 2, "Second word holds bit 65");
+}
+
+TEST_CASE("bit mask exposes its word layout")
+{
+    STATIC_CHECK(bit_mask<9>::word_size == 16, "9 bits are stored in a 16-bit word");
+    STATIC_CHECK(bit_mask<9>::word_count == 1, "9 bits are stored in a single word");
+    STATIC_CHECK(bit_mask<200>::word_size == 64, "200 bits are stored in 64-bit words");
+    STATIC_CHECK(bit_mask<200>::word_count == 4, "200 bits are stored in four words");
+    STATIC_CHECK(sizeof(bit_mask<200>) == 32, "200 bits require 32 bytes");
 }
 
 TEST_CASE("bit mask variadic bool constructor work as expected")
@@ -198,6 +226,73 @@ TEST_CASE("bit mask get method throws exception for invalid index")
     CHECK_THROWS(mask.get(9));
 }
 
+TEST_CASE("bit mask try methods report invalid indices instead of throwing")
+{
+    bit_mask<9> mask{};
+    CHECK(mask.try_set(8));
+    CHECK(!mask.try_set(9));
+    bool bit = false;
+    CHECK(mask.try_get(8, bit));
+    CHECK(bit);
+    CHECK(!mask.try_get(9, bit));
+    CHECK(mask.try_clear(8));
+    CHECK(!mask.try_clear(9));
+    CHECK(mask.try_get(8, bit));
+    CHECK(!bit);
+    CHECK(mask.none());
+}
+
+namespace
+{
+
+constexpr bool try_set_and_get(size_t index)
+{
+    bit_mask<9> mask{};
+    bool bit = false;
+    return mask.try_set(index) && mask.try_get(index, bit) && bit;
+}
+
+}  // namespace
+
+TEST_CASE("bit mask try methods are constexpr")
+{
+    STATIC_CHECK(try_set_and_get(3), "Index 3 is valid");
+    STATIC_CHECK(!try_set_and_get(9), "Index 9 is invalid");
+}
+
+namespace
+{
+
+struct identity
+{
+    constexpr size_t operator()(size_t index) const noexcept
+    {
+        return index;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("bit mask try set all sets all bits or none")
+{
+    const size_t valid[] = {0, 8, 3, 8};
+    const size_t invalid[] = {1, 9};
+    bit_mask<9> small{};
+    CHECK(small.try_set_all(std::begin(valid), std::end(valid), identity{}));
+    CHECK(small == bit_mask<9>(true, false, false, true, false, false, false, false, true));
+    CHECK(!small.try_set_all(std::begin(invalid), std::end(invalid), identity{}));
+    CHECK(small.count() == 3);
+
+    const size_t large_valid[] = {0, 64, 199};
+    const size_t large_invalid[] = {1, 200};
+    bit_mask<200> large{};
+    CHECK(large.try_set_all(std::begin(large_valid), std::end(large_valid), identity{}));
+    CHECK(!large.try_set_all(std::begin(large_invalid), std::end(large_invalid), identity{}));
+    CHECK(large.count() == 3);
+    CHECK(large.get(199));
+    CHECK(!large.get(1));
+}
+
 TEST_CASE("bit mask set method sets the correct bits")
 {
     bit_mask<9> mask{true, false, true, true, false, false, false, true, true};
@@ -309,3 +404,202 @@ TEST_CASE("bit mask clear method throws exception for invalid index")
     bit_mask<9> mask;
     CHECK_THROWS(mask.clear(9));
 }
+
+TEST_CASE("bit mask spanning several words gets, sets and clears the correct bits")
+{
+    bit_mask<130> mask;
+    mask.set(0);
+    mask.set(63);
+    mask.set(64);
+    mask.set(129);
+    CHECK( mask.get(0));
+    CHECK(!mask.get(1));
+    CHECK( mask.get(63));
+    CHECK( mask.get(64));
+    CHECK(!mask.get(65));
+    CHECK(!mask.get(128));
+    CHECK( mask.get(129));
+    mask.clear(63);
+    mask.clear(129);
+    CHECK( mask.get(0));
+    CHECK(!mask.get(63));
+    CHECK( mask.get(64));
+    CHECK(!mask.get(129));
+    CHECK_THROWS(mask.get(130));
+    CHECK_THROWS(mask.set(130));
+    CHECK_THROWS(mask.clear(130));
+}
+
+TEST_CASE("bit mask equality compares bits in all words")
+{
+    constexpr bit_mask<130> A(1, 64, 129);
+    constexpr bit_mask<130> B(1, 64, 129);
+    constexpr bit_mask<130> C(1, 64);
+    constexpr bit_mask<130> D(1, 129);
+    STATIC_CHECK(A == B, "bit_mask equals another bit_mask with same bit values");
+    STATIC_CHECK(A != C, "bit_mask differing in the last word is not equal");
+    STATIC_CHECK(A != D, "bit_mask differing in a middle word is not equal");
+}
+
+TEST_CASE("bit mask count returns the number of set bits")
+{
+    STATIC_CHECK(bit_mask<9>{}.count() == 0, "Empty bit mask has no set bits");
+    STATIC_CHECK((bit_mask<9>{0, 3, 8}.count() == 3), "Bit mask with 3 bits set counts 3");
+    STATIC_CHECK((bit_mask<130>{0, 63, 64, 129}.count() == 4), "Count covers all words");
+}
+
+TEST_CASE("bit mask any, none and all inspect every word")
+{
+    STATIC_CHECK(!bit_mask<130>{}.any(), "Empty bit mask has no bits set");
+    STATIC_CHECK( bit_mask<130>{}.none(), "Empty bit mask has no bits set");
+    STATIC_CHECK( bit_mask<130>{129}.any(), "Bit in last word is found by any");
+    STATIC_CHECK(!bit_mask<130>{129}.none(), "Bit in last word is found by none");
+    STATIC_CHECK(!bit_mask<130>{129}.all(), "Bit mask with one bit set is not all set");
+    STATIC_CHECK((~bit_mask<130>{}).all(), "Complement of empty bit mask is all set");
+}
+
+TEST_CASE("bit mask complement clears the unused tail bits")
+{
+    STATIC_CHECK((~bit_mask<9>{}).count() == 9, "Complement of empty 9 bit mask has 9 bits set");
+    STATIC_CHECK((~bit_mask<64>{}).count() == 64, "Complement of empty 64 bit mask is full");
+    STATIC_CHECK((~bit_mask<130>{}).count() == 130, "Complement of empty 130 bit mask is full");
+    STATIC_CHECK((~bit_mask<130>{0, 129}).count() == 128, "Complement clears previously set bits");
+    STATIC_CHECK((~~bit_mask<130>{0, 129} == bit_mask<130>{0, 129}), "Complement is an involution");
+}
+
+TEST_CASE("bit mask binary operators combine bits word by word")
+{
+    constexpr bit_mask<130> A(1, 64, 129);
+    constexpr bit_mask<130> B(1, 65, 129);
+    STATIC_CHECK((A | B) == (bit_mask<130>{1, 64, 65, 129}), "Or keeps bits set in either");
+    STATIC_CHECK((A & B) == (bit_mask<130>{1, 129}), "And keeps bits set in both");
+    STATIC_CHECK((A ^ B) == (bit_mask<130>{64, 65}), "Xor keeps bits set in exactly one");
+    STATIC_CHECK((A / B) == (bit_mask<130>{64}), "And-not keeps bits set only in the first");
+}
+
+TEST_CASE("bit mask compound operators modify the bit mask in place")
+{
+    const bit_mask<130> B(1, 65, 129);
+    bit_mask<130> x(1, 64, 129);
+    x |= B;
+    CHECK(x == bit_mask<130>{1, 64, 65, 129});
+    x &= B;
+    CHECK(x == bit_mask<130>{1, 65, 129});
+    x ^= bit_mask<130>{1, 2};
+    CHECK(x == bit_mask<130>{2, 65, 129});
+    x /= B;
+    CHECK(x == bit_mask<130>{2});
+    x.flip();
+    CHECK(x.count() == 129);
+    CHECK(!x.get(2));
+}
+
+TEST_CASE("bit mask intersects and subset tests")
+{
+    constexpr bit_mask<130> A(1, 129);
+    constexpr bit_mask<130> B(1, 64, 129);
+    constexpr bit_mask<130> C(64);
+    STATIC_CHECK( A.intersects(B), "Masks sharing a bit intersect");
+    STATIC_CHECK(!A.intersects(C), "Masks sharing no bits do not intersect");
+    STATIC_CHECK( A.is_subset_of(B), "A is a subset of B");
+    STATIC_CHECK( A.is_subset_of(A), "A mask is a subset of itself");
+    STATIC_CHECK(!B.is_subset_of(A), "B is not a subset of A");
+    STATIC_CHECK( bit_mask<130>{}.is_subset_of(C), "The empty mask is a subset of any mask");
+}
+
+TEST_CASE("bit mask find next returns the first set bit greater or equal to the offset")
+{
+    constexpr bit_mask<5> x = {true, false, true, false, true};
+    STATIC_CHECK(x.find_first() == 0, "Finds first bit");
+    STATIC_CHECK(x.find_next(0) == 0, "Finds bit at zero offset");
+    STATIC_CHECK(x.find_next(1) == 2, "Finds first bit after offset");
+    STATIC_CHECK(x.find_next(2) == 2, "Finds bit at non-zero offset");
+    STATIC_CHECK(x.find_next(3) == 4, "Finds last bit if there is no other bit before");
+    STATIC_CHECK(x.find_next(4) == 4, "Finds last bit if offset is at last bit");
+    STATIC_CHECK(x.find_next(5) == 5, "Returns size of bit_mask for offset beyond last bit");
+    STATIC_CHECK(x.find_next(6) == 5, "Returns size of bit_mask for offset beyond last bit");
+}
+
+TEST_CASE("bit mask find next skips over empty words")
+{
+    constexpr bit_mask<300> x(3, 64, 299);
+    STATIC_CHECK(x.find_first() == 3, "Finds first bit in first word");
+    STATIC_CHECK(x.find_next(4) == 64, "Finds bit at the start of the next word");
+    STATIC_CHECK(x.find_next(65) == 299, "Skips empty words");
+    STATIC_CHECK(x.find_next(300) == 300, "Returns size of bit_mask for offset beyond last bit");
+    STATIC_CHECK(bit_mask<300>{}.find_first() == 300, "Returns size of bit_mask when empty");
+    STATIC_CHECK(x.word(1) == 1, "Word accessor returns the expected word");
+}
+
+TEST_CASE("bit mask find prev returns the last set bit strictly less than the offset")
+{
+    constexpr bit_mask<5> x = {true, false, true, false, false};
+    STATIC_CHECK(x.find_last() == 2, "Finds last bit");
+    STATIC_CHECK(x.find_prev(5) == 2, "Finds last bit before the size");
+    STATIC_CHECK(x.find_prev(9) == 2, "Offsets beyond the size are clamped");
+    STATIC_CHECK(x.find_prev(2) == 0, "Excludes the bit at the offset");
+    STATIC_CHECK(x.find_prev(1) == 0, "Finds first bit");
+    STATIC_CHECK(x.find_prev(0) == 5, "Returns size of bit_mask when there is no bit before");
+}
+
+TEST_CASE("bit mask find prev skips over empty words")
+{
+    constexpr bit_mask<300> x(3, 64, 299);
+    STATIC_CHECK(x.find_last() == 299, "Finds last bit in last word");
+    STATIC_CHECK(x.find_prev(299) == 64, "Skips empty words");
+    STATIC_CHECK(x.find_prev(64) == 3, "Finds bit at the end of the previous word");
+    STATIC_CHECK(x.find_prev(3) == 300, "Returns size of bit_mask when there is no bit before");
+    STATIC_CHECK(bit_mask<300>{}.find_last() == 300, "Returns size of bit_mask when empty");
+}
+
+TEST_CASE("bit mask rank counts the set bits before an index")
+{
+    constexpr bit_mask<300> x(3, 63, 64, 299);
+    STATIC_CHECK(x.rank(0) == 0, "No bits before the first index");
+    STATIC_CHECK(x.rank(3) == 0, "The bit at the index is not counted");
+    STATIC_CHECK(x.rank(4) == 1, "Bits before the index are counted");
+    STATIC_CHECK(x.rank(64) == 2, "Bits in preceding words are counted");
+    STATIC_CHECK(x.rank(65) == 3, "Bits in preceding and current words are counted");
+    STATIC_CHECK(x.rank(299) == 3, "Bits up to the last index are counted");
+    STATIC_CHECK(x.rank(300) == 4, "Rank of the size counts all bits");
+    STATIC_CHECK(x.rank(1000) == 4, "Rank beyond the size counts all bits");
+}
+
+TEST_CASE("bit mask select returns the index of the k:th set bit")
+{
+    constexpr bit_mask<300> x(3, 63, 64, 299);
+    STATIC_CHECK(x.select(0) == 3, "First set bit");
+    STATIC_CHECK(x.select(1) == 63, "Second set bit");
+    STATIC_CHECK(x.select(2) == 64, "Third set bit is in the next word");
+    STATIC_CHECK(x.select(3) == 299, "Last set bit");
+    STATIC_CHECK(x.select(4) == 300, "Selecting beyond the number of set bits returns the size");
+    STATIC_CHECK(bit_mask<9>{}.select(0) == 9, "Selecting in an empty mask returns the size");
+}
+
+TEST_CASE("bit mask select is the inverse of rank for set bits")
+{
+    bit_mask<200> x;
+    for (size_t index = 0; index < 200; index += 7)
+    {
+        x.set(index);
+    }
+    for (size_t k = 0; k < x.count(); ++k)
+    {
+        CHECK(x.rank(x.select(k)) == k);
+    }
+}
+
+TEST_CASE("bit mask to indices writes the indices of all set bits")
+{
+    constexpr bit_mask<300> x(3, 63, 64, 299);
+    uint16_t indices[300] = {};
+    CHECK(x.to_indices(indices, 300) == 4);
+    CHECK(indices[0] == 3);
+    CHECK(indices[1] == 63);
+    CHECK(indices[2] == 64);
+    CHECK(indices[3] == 299);
+    uint32_t truncated[3] = {};
+    CHECK(x.to_indices(truncated, 3) == 3);
+    CHECK(truncated[2] == 64);
+    CHECK(bit_mask<9>{}.to_indices(indices, 300) == 0);
+}
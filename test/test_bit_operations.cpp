@@ -0,0 +1,83 @@
+#include "testing.hpp"
+
+#include <enum_set/bit_operations.hpp>
+
+using namespace ::enum_set;
+
+TEST_CASE("popcount returns the number of set bits")
+{
+    STATIC_CHECK(detail::popcount(uint8_t{0}) == 0, "No bits set in zero");
+    STATIC_CHECK(detail::popcount(uint8_t{0xFF}) == 8, "All bits set in a full byte");
+    STATIC_CHECK(detail::popcount(uint16_t{0x8001}) == 2, "Highest and lowest bit of 16-bit word");
+    STATIC_CHECK(detail::popcount(uint32_t{0xF0F0F0F0}) == 16, "Half the bits of 32-bit word");
+    STATIC_CHECK(detail::popcount(~uint64_t{0}) == 64, "All bits set in a 64-bit word");
+    STATIC_CHECK(detail::popcount(uint64_t{1} << 63) == 1, "Highest bit of a 64-bit word");
+}
+
+TEST_CASE("count trailing zeros returns the index of the lowest set bit")
+{
+    STATIC_CHECK(detail::count_trailing_zeros(uint8_t{1}) == 0, "Lowest bit set");
+    STATIC_CHECK(detail::count_trailing_zeros(uint8_t{0x80}) == 7, "Highest bit of a byte");
+    STATIC_CHECK(detail::count_trailing_zeros(uint16_t{0x8000}) == 15, "Highest bit of 16 bits");
+    STATIC_CHECK(detail::count_trailing_zeros(uint32_t{0x30}) == 4, "Lowest of several bits");
+    STATIC_CHECK(detail::count_trailing_zeros(uint64_t{1} << 63) == 63, "Highest of 64 bits");
+    STATIC_CHECK(detail::count_trailing_zeros(uint8_t{0}) == 8, "Zero byte yields word size");
+    STATIC_CHECK(detail::count_trailing_zeros(uint64_t{0}) == 64, "Zero word yields word size");
+}
+
+TEST_CASE("mask from sets all bits at and above an index")
+{
+    STATIC_CHECK(detail::mask_from<uint8_t>(0) == 0xFF, "Mask from zero is all bits");
+    STATIC_CHECK(detail::mask_from<uint8_t>(7) == 0x80, "Mask from last bit is the last bit");
+    STATIC_CHECK(detail::mask_from<uint16_t>(4) == 0xFFF0, "Mask from middle bit");
+    STATIC_CHECK(detail::mask_from<uint64_t>(63) == uint64_t{1} << 63, "Mask from last bit");
+}
+
+TEST_CASE("clear lowest clears exactly the lowest set bit")
+{
+    STATIC_CHECK(detail::clear_lowest(uint8_t{0x90}) == 0x80, "Clears lowest of two bits");
+    STATIC_CHECK(detail::clear_lowest(uint8_t{0x80}) == 0, "Clears single bit");
+    STATIC_CHECK(detail::clear_lowest(uint64_t{6}) == 4, "Clears lowest of 64-bit word");
+}
+
+TEST_CASE("count leading zeros counts from the highest bit of the word type")
+{
+    STATIC_CHECK(detail::count_leading_zeros(uint8_t{1}) == 7, "Lowest bit of a byte");
+    STATIC_CHECK(detail::count_leading_zeros(uint8_t{0x80}) == 0, "Highest bit of a byte");
+    STATIC_CHECK(detail::count_leading_zeros(uint16_t{0x0100}) == 7, "Middle bit of 16 bits");
+    STATIC_CHECK(detail::count_leading_zeros(uint32_t{0x30}) == 26, "Highest of several bits");
+    STATIC_CHECK(detail::count_leading_zeros(uint64_t{1}) == 63, "Lowest of 64 bits");
+    STATIC_CHECK(detail::count_leading_zeros(uint8_t{0}) == 8, "Zero byte yields word size");
+    STATIC_CHECK(detail::count_leading_zeros(uint64_t{0}) == 64, "Zero word yields word size");
+}
+
+TEST_CASE("mask to sets all bits at and below an index")
+{
+    STATIC_CHECK(detail::mask_to<uint8_t>(0) == 0x01, "Mask to zero is the first bit");
+    STATIC_CHECK(detail::mask_to<uint8_t>(7) == 0xFF, "Mask to last bit is all bits");
+    STATIC_CHECK(detail::mask_to<uint16_t>(3) == 0x000F, "Mask to middle bit");
+    STATIC_CHECK(detail::mask_to<uint64_t>(63) == ~uint64_t{0}, "Mask to last bit is all bits");
+}
+
+TEST_CASE("byte select table holds the positions of the set bits of each byte")
+{
+    constexpr auto table = detail::make_byte_select_table();
+    STATIC_CHECK(table.positions[0][0] == 8, "Zero byte has no set bits");
+    STATIC_CHECK(table.positions[1][0] == 0, "First bit of one is at position 0");
+    STATIC_CHECK(table.positions[0xA0][0] == 5, "First set bit of 0xA0 is at position 5");
+    STATIC_CHECK(table.positions[0xA0][1] == 7, "Second set bit of 0xA0 is at position 7");
+    STATIC_CHECK(table.positions[0xA0][2] == 8, "0xA0 has only two set bits");
+    STATIC_CHECK(table.positions[0xFF][7] == 7, "Last set bit of a full byte");
+    STATIC_CHECK(table.counts[0] == 0, "Zero byte has no set bits");
+    STATIC_CHECK(table.counts[0xA0] == 2, "0xA0 has two set bits");
+    STATIC_CHECK(table.counts[0xFF] == 8, "Full byte has eight set bits");
+}
+
+TEST_CASE("select in word returns the position of the k:th set bit")
+{
+    STATIC_CHECK(detail::select_in_word(uint8_t{0x12}, 0) == 1, "First set bit of a byte");
+    STATIC_CHECK(detail::select_in_word(uint8_t{0x12}, 1) == 4, "Second set bit of a byte");
+    STATIC_CHECK(detail::select_in_word(uint8_t{0x12}, 2) == 8, "No third set bit in a byte");
+    STATIC_CHECK(detail::select_in_word((uint64_t{1} << 63) | 1, 1) == 63, "Across bytes");
+    STATIC_CHECK(detail::select_in_word(uint32_t{0x00010100}, 1) == 16, "Skips empty bytes");
+}
@@ -0,0 +1,33 @@
+#include "testing.hpp"
+
+#include <enum_set/bounds_check.hpp>
+
+using namespace ::enum_set;
+
+TEST_CASE("the default bounds checking mode throws when exceptions are enabled")
+{
+    STATIC_CHECK(ENUM_SET_BOUNDS_CHECK == ENUM_SET_BOUNDS_CHECK_THROW, "Throws by default");
+    CHECK_THROWS_AS(detail::check_bounds(false, "out of bounds"), std::out_of_range);
+    CHECK_NOTHROW(detail::check_bounds(true, "within bounds"));
+}
+
+TEST_CASE("throwing bounds checker throws only on failed checks")
+{
+    using checker = detail::bounds_checker<detail::bounds_check::throws>;
+    CHECK_THROWS_AS(checker::check(false, "out of bounds"), std::out_of_range);
+    CHECK_NOTHROW(checker::check(true, "within bounds"));
+}
+
+TEST_CASE("asserting bounds checker is noexcept and accepts valid checks")
+{
+    using checker = detail::bounds_checker<detail::bounds_check::asserts>;
+    STATIC_CHECK(noexcept(checker::check(true, "within bounds")), "Asserting checker never throws");
+    checker::check(true, "within bounds");
+}
+
+TEST_CASE("unchecked bounds checker ignores failed checks")
+{
+    using checker = detail::bounds_checker<detail::bounds_check::unchecked>;
+    STATIC_CHECK(noexcept(checker::check(false, "out of bounds")), "Unchecked never throws");
+    CHECK_NOTHROW(checker::check(false, "out of bounds"));
+}
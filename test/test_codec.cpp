@@ -0,0 +1,143 @@
+#include "testing.hpp"
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/codec.hpp>
+#include <enum_set/index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+using small_set = make_index_set<16>;
+using large_set = make_index_set<1000>;
+
+/// Encodes and decodes a set, checking the sizes and the result.
+template <typename Set>
+void check_round_trip(Set const& set, set_encoding encoding)
+{
+    std::vector<unsigned char> buffer(max_encoded_size<Set>());
+    CHECK(choose_encoding(set) == encoding);
+    const size_t written = encode(set, buffer.data(), buffer.size());
+    CHECK(written == encoded_size(set));
+    CHECK(written <= max_encoded_size<Set>());
+    CHECK(buffer[0] == static_cast<unsigned char>(encoding));
+    Set result{};
+    CHECK(decode(buffer.data(), written, result) == written);
+    CHECK(result == set);
+}
+
+} // namespace
+
+TEST_CASE("varint sizes")
+{
+    STATIC_CHECK(detail::varint_size(0) == 1, "Small values take one byte");
+    STATIC_CHECK(detail::varint_size(127) == 1, "Seven bits fit in one byte");
+    STATIC_CHECK(detail::varint_size(128) == 2, "Eight bits take two bytes");
+    STATIC_CHECK(detail::varint_size(UINT64_MAX) == 10, "64 bits take ten bytes");
+    STATIC_CHECK(max_encoded_size<small_set>() == 3, "Encoding byte and the bit mask");
+    STATIC_CHECK(max_encoded_size<bit_mask<1000>>() == 126, "Encoding byte and the bit mask");
+}
+
+TEST_CASE("encoding is picked from the cardinality and the runs")
+{
+    check_round_trip(large_set{}, set_encoding::runs);
+    check_round_trip(large_set{3, 500, 999}, set_encoding::delta);
+
+    large_set runs{};
+    for (size_t index = 100; index < 900; ++index)
+    {
+        runs.add(index);
+    }
+    check_round_trip(runs, set_encoding::runs);
+    check_round_trip(~large_set{}, set_encoding::runs);
+
+    large_set dense{};
+    for (size_t index = 0; index < 1000; index += 3)
+    {
+        dense.add(index);
+    }
+    check_round_trip(dense, set_encoding::dense);
+
+    check_round_trip(small_set{1, 5}, set_encoding::dense);
+    check_round_trip(small_set{}, set_encoding::runs);
+}
+
+TEST_CASE("runs crossing storage words")
+{
+    bit_mask<1000> mask{};
+    for (const size_t start : {60, 200, 300})
+    {
+        for (size_t index = start; index < start + 70; ++index)
+        {
+            mask.set(index);
+        }
+    }
+    mask.set(999);
+    CHECK(detail::run_count(mask) == 4);
+    std::vector<unsigned char> buffer(max_encoded_size<bit_mask<1000>>());
+    const size_t written = encode(mask, buffer.data(), buffer.size());
+    CHECK(buffer[0] == static_cast<unsigned char>(set_encoding::runs));
+    bit_mask<1000> result{};
+    CHECK(decode(buffer.data(), written, result) == written);
+    CHECK(result == mask);
+}
+
+TEST_CASE("consecutive sets decode from one buffer")
+{
+    const std::vector<large_set> sets = {large_set{1}, ~large_set{}, large_set{}, large_set{7, 8}};
+    std::vector<unsigned char> buffer(sets.size() * max_encoded_size<large_set>());
+    size_t offset = 0;
+    for (auto const& set : sets)
+    {
+        offset += encode(set, buffer.data() + offset, buffer.size() - offset);
+    }
+    size_t read = 0;
+    for (auto const& set : sets)
+    {
+        large_set result{};
+        read += decode(buffer.data() + read, offset - read, result);
+        CHECK(result == set);
+    }
+    CHECK(read == offset);
+}
+
+TEST_CASE("encode checks the output capacity")
+{
+    unsigned char buffer[4] = {};
+    CHECK_THROWS_AS(encode(large_set{1, 3, 5, 7}, buffer, 4), std::out_of_range);
+    CHECK(encode(large_set{1, 2, 3, 4}, buffer, 4) == 4);
+}
+
+TEST_CASE("malformed input is rejected")
+{
+    small_set set{2};
+    const small_set original = set;
+    const unsigned char truncated_dense[] = {0, 0xFF};
+    const unsigned char unknown_encoding[] = {7, 0, 0};
+    const unsigned char outside_delta[] = {1, 1, 16};
+    const unsigned char truncated_delta[] = {1, 2, 0};
+    const unsigned char outside_runs[] = {2, 1, 10, 6};
+    const unsigned char overlong_varint[] = {
+        1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0
+    };
+    CHECK(try_decode(truncated_dense, sizeof(truncated_dense), set) == 0);
+    CHECK(try_decode(unknown_encoding, sizeof(unknown_encoding), set) == 0);
+    CHECK(try_decode(outside_delta, sizeof(outside_delta), set) == 0);
+    CHECK(try_decode(truncated_delta, sizeof(truncated_delta), set) == 0);
+    CHECK(try_decode(outside_runs, sizeof(outside_runs), set) == 0);
+    CHECK(try_decode(overlong_varint, sizeof(overlong_varint), set) == 0);
+    CHECK(try_decode(truncated_dense, 0, set) == 0);
+    CHECK(set == original);
+    CHECK_THROWS_AS(decode(outside_delta, sizeof(outside_delta), set), std::out_of_range);
+
+    const unsigned char last_run[] = {2, 1, 10, 5};
+    CHECK(try_decode(last_run, sizeof(last_run), set) == sizeof(last_run));
+    CHECK(set == small_set{10, 11, 12, 13, 14, 15});
+}
+
+} // namespace enum_set
@@ -0,0 +1,225 @@
+#include "testing.hpp"
+
+#include <enum_set/columnar.hpp>
+#include <enum_set/integer_set.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/value_set.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+enum class color : int8_t { red, green, blue, alpha };
+
+using color_set = value_set<color, color::red, color::green, color::blue, color::alpha>;
+using reordered_set = value_set<color, color::green, color::red, color::blue, color::alpha>;
+using large_set = make_integer_set<int, 200>;
+
+/// Returns the bytes written to a stream.
+std::vector<unsigned char> bytes_of(std::ostringstream const& stream)
+{
+    const std::string data = stream.str();
+    return std::vector<unsigned char>(data.begin(), data.end());
+}
+
+/// Returns a set of `large_set` that depends on `row`.
+large_set large_row(int row)
+{
+    large_set result{};
+    for (int value = row % 7; value < 200; value += 7 + row % 5)
+    {
+        result.add(value);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("columnar layout sizes")
+{
+    using layout = columnar_layout<color_set>;
+    STATIC_CHECK(layout::row_size == 1, "Four values fit in a byte");
+    STATIC_CHECK(layout::header_size == 64, "Fixed fields and a count per value");
+    STATIC_CHECK(layout::rows_size(3) == 8, "Rows are padded to eight bytes");
+    STATIC_CHECK(layout::bitmap_size(65) == 16, "Bitmaps are padded to eight bytes");
+    STATIC_CHECK(layout::block_size(3, false) == 72, "Header and rows");
+    STATIC_CHECK(layout::block_size(3, true) == 104, "Header, rows and four bitmaps");
+    STATIC_CHECK(columnar_layout<large_set>::row_size == 25, "200 values fit in 25 bytes");
+}
+
+TEST_CASE("columnar round trip")
+{
+    const std::vector<color_set> sets = {
+        color_set{},
+        color_set{color::red},
+        color_set{color::green, color::alpha},
+        color_set{color::red, color::green, color::blue, color::alpha},
+        color_set{color::blue},
+    };
+    for (const bool bitmaps : {false, true})
+    {
+        for (const size_t block_rows : {1, 2, 5, 100})
+        {
+            std::ostringstream stream;
+            columnar_writer<color_set> writer(stream, bitmaps, block_rows);
+            for (auto const& set : sets)
+            {
+                writer.write(set);
+            }
+            CHECK(writer.size() == sets.size());
+            writer.flush();
+            const auto bytes = bytes_of(stream);
+            CHECK(bytes.size() % 8 == 0);
+
+            const columnar_reader<color_set> reader(bytes.data(), bytes.size());
+            CHECK(reader.size() == sets.size());
+            CHECK(reader.block_count() == (sets.size() + block_rows - 1) / block_rows);
+            for (size_t row = 0; row < sets.size(); ++row)
+            {
+                CHECK(reader.row(row) == sets[row]);
+                CHECK(reader.has(row, color::blue) == sets[row].has<color::blue>());
+            }
+            CHECK_THROWS_AS(reader.row(sets.size()), std::out_of_range);
+            CHECK(!reader.has(sets.size(), color::red));
+            CHECK(!reader.has(0, static_cast<color>(42)));
+        }
+    }
+}
+
+TEST_CASE("columnar projection of a single value")
+{
+    for (const bool bitmaps : {false, true})
+    {
+        std::ostringstream stream;
+        {
+            columnar_writer<large_set> writer(stream, bitmaps, 64);
+            for (int row = 0; row < 1000; ++row)
+            {
+                writer.write(large_row(row));
+            }
+        }
+        const auto bytes = bytes_of(stream);
+        const columnar_reader<large_set> reader(bytes.data(), bytes.size());
+        CHECK(reader.size() == 1000);
+        CHECK(reader.block_count() == 16);
+
+        for (const int value : {0, 1, 13, 99, 199})
+        {
+            std::vector<size_t> expected;
+            for (int row = 0; row < 1000; ++row)
+            {
+                if (large_row(row).has(value))
+                {
+                    expected.push_back(static_cast<size_t>(row));
+                }
+            }
+            std::vector<size_t> visited;
+            reader.visit_rows(value, [&visited](size_t row)
+            {
+                visited.push_back(row);
+            });
+            CHECK(visited == expected);
+            CHECK(reader.count(value) == expected.size());
+
+            const dynamic_index_set column = reader.column(value);
+            CHECK(column.capacity() == 1000);
+            CHECK(std::vector<size_t>(column.begin(), column.end()) == expected);
+        }
+        CHECK(reader.count<7>() == reader.column<7>().size());
+        CHECK(reader.count(200) == 0);
+        CHECK(reader.column(-1).empty());
+    }
+}
+
+TEST_CASE("columnar writer flushes on destruction")
+{
+    std::ostringstream stream;
+    {
+        columnar_writer<color_set> writer(stream);
+        writer.write(color_set{color::green});
+        CHECK(stream.str().empty());
+    }
+    const auto bytes = bytes_of(stream);
+    const columnar_reader<color_set> reader(bytes.data(), bytes.size());
+    CHECK(reader.size() == 1);
+    CHECK(reader.row(0) == color_set{color::green});
+    CHECK(reader.count<color::green>() == 1);
+    CHECK(reader.count<color::red>() == 0);
+}
+
+TEST_CASE("columnar writer reports stream failures")
+{
+    std::ostringstream stream;
+    stream.setstate(std::ios_base::badbit);
+    columnar_writer<color_set> writer(stream, true, 2);
+    CHECK(writer.try_write(color_set{color::red}));
+    CHECK(!writer.try_write(color_set{color::blue}));
+    CHECK(!writer.try_flush());
+    CHECK(writer.size() == 2);
+    CHECK_THROWS_AS(writer.flush(), std::ios_base::failure);
+    CHECK_THROWS_AS(writer.write(color_set{}), std::ios_base::failure);
+
+    stream.clear();
+    CHECK(writer.try_flush());
+    CHECK(writer.size() == 3);
+    const auto bytes = bytes_of(stream);
+    const columnar_reader<color_set> reader(bytes.data(), bytes.size());
+    CHECK(reader.size() == 3);
+    CHECK(reader.row(1) == color_set{color::blue});
+}
+
+TEST_CASE("columnar reader of no bytes is empty")
+{
+    const columnar_reader<color_set> reader(nullptr, 0);
+    CHECK(reader.empty());
+    CHECK(reader.block_count() == 0);
+    CHECK(reader.count(color::red) == 0);
+}
+
+TEST_CASE("columnar projection ignores bitmap padding past the last row")
+{
+    using layout = columnar_layout<color_set>;
+    std::ostringstream stream;
+    {
+        columnar_writer<color_set> writer(stream, true);
+        writer.write(color_set{color::red});
+        writer.write(color_set{color::blue});
+        writer.write(color_set{color::red, color::green});
+    }
+    auto bytes = bytes_of(stream);
+    bytes[layout::header_size + layout::rows_size(3)] |= 0xF8;
+    const columnar_reader<color_set> reader(bytes.data(), bytes.size());
+    std::vector<size_t> visited;
+    reader.visit_rows(color::red, [&visited](size_t row)
+    {
+        visited.push_back(row);
+    });
+    CHECK(visited == std::vector<size_t>{0, 2});
+    const dynamic_index_set column = reader.column(color::red);
+    CHECK(std::vector<size_t>(column.begin(), column.end()) == std::vector<size_t>{0, 2});
+}
+
+TEST_CASE("columnar reader rejects foreign or damaged bytes")
+{
+    std::ostringstream stream;
+    {
+        columnar_writer<color_set> writer(stream);
+        writer.write(color_set{color::red});
+        writer.write(color_set{color::blue});
+    }
+    auto bytes = bytes_of(stream);
+    CHECK_THROWS_AS(columnar_reader<reordered_set>(bytes.data(), bytes.size()), std::out_of_range);
+    CHECK_THROWS_AS(columnar_reader<color_set>(bytes.data(), bytes.size() - 8), std::out_of_range);
+    CHECK_THROWS_AS(columnar_reader<color_set>(bytes.data(), 16), std::out_of_range);
+    bytes[0] ^= 1;
+    CHECK_THROWS_AS(columnar_reader<color_set>(bytes.data(), bytes.size()), std::out_of_range);
+    CHECK_THROWS_AS(columnar_writer<color_set>(stream, true, 0), std::out_of_range);
+}
+
+} // namespace enum_set
@@ -85,3 +85,12 @@ TEST_CASE("get_value throws an exception on out of range access")
     CHECK_THROWS((detail::get_value<int, 1, 2, 1>(3)));
     CHECK_THROWS((detail::get_value<size_t, 1, 2, 1>(3)));
 }
+
+TEST_CASE("value_table holds the values in order")
+{
+    STATIC_CHECK((detail::value_table<int, 1, 2, 1>::values[0] == 1), "Value at index 0");
+    STATIC_CHECK((detail::value_table<int, 1, 2, 1>::values[1] == 2), "Value at index 1");
+    STATIC_CHECK((detail::value_table<int, 1, 2, 1>::values[2] == 1), "Value at index 2");
+    STATIC_CHECK((sizeof(detail::value_table<int, 1, 2, 1>::values) == 3 * sizeof(int)),
+                 "Table holds one entry per value");
+}
@@ -0,0 +1,113 @@
+#include "testing.hpp"
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/copy_on_write.hpp>
+#include <enum_set/index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <utility>
+
+namespace enum_set
+{
+
+namespace
+{
+
+/// Index set of 16 KiB.
+using large_set = index_set<(1 << 17)>;
+using shared_set = copy_on_write<large_set>;
+
+} // namespace
+
+TEST_CASE("copying a copy on write set shares its storage")
+{
+    shared_set::reset_counters();
+    const shared_set x(large_set{1, 2, 3});
+    const shared_set y = x;
+    shared_set z{};
+    z = y;
+    CHECK(x.shares_with(y));
+    CHECK(z.shares_with(x));
+    CHECK(x.is_shared());
+    CHECK(z->size() == 3);
+    CHECK((*z).has(2));
+    CHECK(shared_set::counters().shares == 2);
+    CHECK(shared_set::counters().clones == 0);
+}
+
+TEST_CASE("modifying a shared copy on write set clones its storage once")
+{
+    shared_set::reset_counters();
+    const shared_set x(large_set{1, 2, 3});
+    shared_set y = x;
+    y.mutate().add(4);
+    y.mutate().add(5);
+    CHECK(!x.shares_with(y));
+    CHECK(!y.is_shared());
+    CHECK(x->size() == 3);
+    CHECK(y->size() == 5);
+    CHECK(shared_set::counters().clones == 1);
+
+    shared_set z(large_set{7});
+    z.mutate().remove(7);
+    CHECK(z->empty());
+    CHECK(shared_set::counters().clones == 1);
+}
+
+TEST_CASE("in place operators on copy on write sets clone only when needed")
+{
+    shared_set::reset_counters();
+    const shared_set x(large_set{1, 2, 3});
+    shared_set y = x;
+    y |= x;
+    y &= x;
+    CHECK(y.shares_with(x));
+    CHECK(shared_set::counters().clones == 0);
+    y /= x;
+    CHECK(y->empty());
+    CHECK(x->size() == 3);
+    CHECK(shared_set::counters().clones == 0);
+
+    y = x;
+    y ^= x;
+    CHECK(y->empty());
+    y = x;
+    y |= shared_set(large_set{4});
+    CHECK(y->size() == 4);
+    CHECK(x->size() == 3);
+    CHECK(shared_set::counters().clones == 1);
+    y &= shared_set(large_set{1, 4});
+    y ^= shared_set(large_set{1, 9});
+    y /= shared_set(large_set{9});
+    CHECK(*y == large_set{4});
+    CHECK(shared_set::counters().clones == 1);
+}
+
+TEST_CASE("set algebra on copy on write sets")
+{
+    const auto x = make_copy_on_write(large_set{1, 2, 3});
+    const auto y = make_copy_on_write(large_set{3, 4});
+    CHECK(*(x | y) == large_set{1, 2, 3, 4});
+    CHECK(*(x & y) == large_set{3});
+    CHECK(*(x / y) == large_set{1, 2});
+    CHECK(*(x ^ y) == large_set{1, 2, 4});
+    CHECK(x == x);
+    CHECK(x != y);
+    CHECK(x == make_copy_on_write(large_set{1, 2, 3}));
+}
+
+TEST_CASE("copy on write works with bit masks")
+{
+    using shared_mask = copy_on_write<bit_mask<1000>>;
+    shared_mask::reset_counters();
+    const shared_mask x(bit_mask<1000>{1, 999});
+    shared_mask copied = x;
+    shared_mask y = std::move(copied);
+    y.mutate().set(500);
+    CHECK(x->count() == 2);
+    CHECK(y->count() == 3);
+    CHECK(shared_mask::counters().shares == 1);
+    CHECK(shared_mask::counters().clones == 1);
+}
+
+} // namespace enum_set
@@ -0,0 +1,155 @@
+#include "testing.hpp"
+
+#include <enum_set/dynamic_index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+/// Returns the elements of a set in iteration order.
+std::vector<size_t> elements_of(dynamic_index_set const& set)
+{
+    return std::vector<size_t>(set.begin(), set.end());
+}
+
+} // namespace
+
+TEST_CASE("dynamic index set stores small capacities inline")
+{
+    STATIC_CHECK(dynamic_index_set::inline_capacity == 128, "Inline buffer holds 128 bits");
+    STATIC_CHECK(
+        sizeof(dynamic_index_set) == sizeof(size_t) + 16,
+        "Dynamic index set is the capacity and the inline buffer");
+    STATIC_CHECK(
+        std::is_nothrow_move_constructible<dynamic_index_set>::value
+        && std::is_nothrow_move_assignable<dynamic_index_set>::value,
+        "Moving a dynamic index set never allocates");
+    CHECK(dynamic_index_set(0).is_inline());
+    CHECK(dynamic_index_set(128).is_inline());
+    CHECK(!dynamic_index_set(129).is_inline());
+    CHECK(dynamic_index_set(129).capacity() == 129);
+    CHECK(dynamic_index_set{}.capacity() == 0);
+    CHECK(dynamic_index_set{}.empty());
+}
+
+TEST_CASE("dynamic index set has the interface of index_set")
+{
+    for (const size_t capacity : {100, 128, 1000})
+    {
+        dynamic_index_set x(capacity, {0, 63, 64, 99});
+        CHECK(x.size() == 4);
+        CHECK(x.count() == 4);
+        CHECK(x.has(63));
+        CHECK(!x.has(62));
+        CHECK(!x.has(capacity));
+        CHECK(x.front() == 0);
+        CHECK(x.back() == 99);
+        CHECK(x.rank(64) == 2);
+        CHECK(x.rank(capacity) == 4);
+        CHECK(x.select(2) == 64);
+        CHECK(elements_of(x) == std::vector<size_t>{0, 63, 64, 99});
+        CHECK(std::vector<size_t>(x.rbegin(), x.rend()) == std::vector<size_t>{99, 64, 63, 0});
+        std::vector<uint32_t> written(4);
+        CHECK(x.to_indices(written.data(), written.size()) == 4);
+        CHECK(written == std::vector<uint32_t>{0, 63, 64, 99});
+
+        x.remove(0);
+        CHECK(x.try_add(1));
+        CHECK(x.try_remove(63));
+        CHECK(!x.try_add(capacity));
+        CHECK(!x.try_remove(capacity));
+        CHECK(elements_of(x) == std::vector<size_t>{1, 64, 99});
+        CHECK_THROWS(x.add(capacity));
+        CHECK_THROWS(x.remove(capacity));
+        CHECK_THROWS(x.select(3));
+        CHECK_THROWS(*x.end());
+
+        CHECK((~x).size() == capacity - 3);
+        CHECK(!(~x).has(capacity));
+        x.clear();
+        CHECK(x.empty());
+        CHECK(x.begin() == x.end());
+        CHECK_THROWS(x.front());
+        CHECK_THROWS(x.back());
+    }
+}
+
+TEST_CASE("set algebra on dynamic index sets")
+{
+    for (const size_t capacity : {100, 1000})
+    {
+        const dynamic_index_set x(capacity, {0, 64, 99});
+        const dynamic_index_set y(capacity, {64, 70});
+        CHECK(elements_of(x | y) == std::vector<size_t>{0, 64, 70, 99});
+        CHECK(elements_of(x & y) == std::vector<size_t>{64});
+        CHECK(elements_of(x / y) == std::vector<size_t>{0, 99});
+        CHECK(elements_of(x ^ y) == std::vector<size_t>{0, 70, 99});
+        CHECK((x & y) <= x);
+        CHECK((x & y) < x);
+        CHECK(x >= (x & y));
+        CHECK(x > (x & y));
+        CHECK(!(x <= y));
+        CHECK(x == x);
+        CHECK(x != y);
+
+        dynamic_index_set z = x;
+        z |= y;
+        CHECK(z == (x | y));
+        z &= y;
+        CHECK(z == y);
+        z /= x;
+        CHECK(elements_of(z) == std::vector<size_t>{70});
+        z ^= x;
+        CHECK(elements_of(z) == std::vector<size_t>{0, 64, 70, 99});
+
+        const dynamic_index_set other(capacity + 1);
+        CHECK_THROWS(z |= other);
+        CHECK_THROWS(z == other);
+        CHECK_THROWS(z <= other);
+    }
+}
+
+TEST_CASE("moving a dynamic index set steals its storage")
+{
+    dynamic_index_set x(1000, {1, 999});
+    dynamic_index_set y = std::move(x);
+    CHECK(x.capacity() == 0);
+    CHECK(x.empty());
+    CHECK(y.capacity() == 1000);
+    CHECK(elements_of(y) == std::vector<size_t>{1, 999});
+
+    dynamic_index_set z(10, {3});
+    z = std::move(y);
+    CHECK(z.capacity() == 1000);
+    CHECK(elements_of(z) == std::vector<size_t>{1, 999});
+
+    dynamic_index_set inline_set(100, {42});
+    z = std::move(inline_set);
+    CHECK(z.is_inline());
+    CHECK(elements_of(z) == std::vector<size_t>{42});
+}
+
+TEST_CASE("copying a dynamic index set copies its storage")
+{
+    const dynamic_index_set x(1000, {1, 999});
+    dynamic_index_set y = x;
+    y.add(500);
+    CHECK(x.size() == 2);
+    CHECK(y.size() == 3);
+    dynamic_index_set z(1000);
+    z = x;
+    CHECK(z == x);
+    z = dynamic_index_set(50, {7});
+    CHECK(z.capacity() == 50);
+    z = y;
+    CHECK(z == y);
+}
+
+} // namespace enum_set
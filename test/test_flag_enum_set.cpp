@@ -0,0 +1,119 @@
+#include "testing.hpp"
+
+#include <enum_set/flag_enum_set.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace
+{
+
+enum class permission
+{
+    read = 1,
+    write = 2,
+    execute = 4,
+    remove = 8
+};
+
+enum wide_flag : int
+{
+    wide_first = 1,
+    wide_last = 1 << 31
+};
+
+enum class full_flag : uint64_t
+{
+    first = 1,
+    fifth = 1ULL << 5,
+    last = 1ULL << 63
+};
+
+enum class byte_flag : uint8_t
+{
+    low = 1,
+    high = 128
+};
+
+}  // namespace
+
+namespace enum_set
+{
+
+using permission_set = make_flag_enum_set<permission, permission::remove>;
+
+TEST_CASE("make_flag_enum_set builds the expected value_set")
+{
+    STATIC_CHECK(
+        (std::is_same<
+            permission_set,
+            value_set<
+                permission,
+                permission::read,
+                permission::write,
+                permission::execute,
+                permission::remove
+            >
+         >::value),
+        "make_flag_enum_set builds the expected value_set");
+    STATIC_CHECK((make_flag_enum_set<wide_flag, wide_last>::capacity() == 32),
+                 "The sign bit is a flag");
+    STATIC_CHECK((make_flag_enum_set<byte_flag, byte_flag::high>::capacity() == 8),
+                 "Eight flags fit a byte");
+    STATIC_CHECK((detail::value_lookup<permission, permission::read, permission::write>::strategy()
+                  == detail::lookup_strategy::flags),
+                 "Two flags are looked up as flags");
+}
+
+TEST_CASE("flag sets convert to and from flags")
+{
+    constexpr permission_set set{permission::read, permission::execute};
+    STATIC_CHECK(to_flags(set) == 5, "The flags are the bit mask");
+    STATIC_CHECK(from_flags<permission_set>(5) == set, "The bit mask is the flags");
+    STATIC_CHECK(to_flags(permission_set{}) == 0, "No flags");
+    STATIC_CHECK(to_flags(~permission_set{}) == 15, "All flags");
+
+    using wide_set = make_flag_enum_set<wide_flag, wide_last>;
+    const int flags = static_cast<int>(wide_last) | 1;
+    CHECK(to_flags(from_flags<wide_set>(flags)) == flags);
+    CHECK(from_flags<wide_set>(flags).has(wide_last));
+
+    using full_set = make_flag_enum_set<full_flag, full_flag::last>;
+    STATIC_CHECK(full_set::capacity() == 64, "All 64 bits are flags");
+    full_set full{full_flag::last};
+    CHECK(to_flags(full) == 1ULL << 63);
+    full.add(full_flag::fifth);
+    CHECK(to_flags(full) == ((1ULL << 63) | (1ULL << 5)));
+    CHECK(full.has(full_flag::fifth));
+    CHECK(!full.try_add(static_cast<full_flag>(0)));
+    CHECK(!full.try_add(static_cast<full_flag>(3)));
+    CHECK(to_flags(from_flags<full_set>(~0ULL)) == ~0ULL);
+
+    permission_set result{permission::write};
+    CHECK(!try_from_flags(16, result));
+    CHECK(!try_from_flags(-1, result));
+    CHECK(result == permission_set{permission::write});
+    CHECK(try_from_flags(8, result));
+    CHECK(result == permission_set{permission::remove});
+    CHECK_THROWS_AS(from_flags<permission_set>(17), std::out_of_range);
+}
+
+TEST_CASE("flag sets test membership of single flags")
+{
+    const permission_set set{permission::write, permission::remove};
+    CHECK(set.has(permission::write));
+    CHECK(!set.has(permission::read));
+    CHECK(!set.has(static_cast<permission>(0)));
+    CHECK(!set.has(static_cast<permission>(10)));
+    CHECK(!set.has(static_cast<permission>(16)));
+    CHECK(!set.has(static_cast<permission>(-8)));
+
+    permission_set added{};
+    CHECK(added.try_add(permission::execute));
+    CHECK(!added.try_add(static_cast<permission>(3)));
+    CHECK(!added.try_add(static_cast<permission>(0)));
+    CHECK(to_flags(added) == 4);
+    CHECK_THROWS_AS(added.add(static_cast<permission>(32)), std::out_of_range);
+}
+
+}  // namespace enum_set
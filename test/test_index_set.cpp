@@ -3,7 +3,10 @@
 #include <enum_set/index_set.hpp>
 #include <enum_set/standard_types.hpp>
 
+#include <iterator>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace enum_set
 {
@@ -28,7 +31,208 @@ TEST_CASE("size of index set of specified size is as expected")
     STATIC_CHECK(sizeof(make_index_set<8>) == 1,  "Index set of size 8 requires 1 byte");
     STATIC_CHECK(sizeof(make_index_set<9>) == 2,  "Index set of size 9 requires 2 bytes");
     STATIC_CHECK(sizeof(make_index_set<16>) == 2, "Index set of size 16 requires 2 bytes");
-    STATIC_CHECK(sizeof(make_index_set<17>) == 3, "Index set of size 17 requires 3 bytes");
+    STATIC_CHECK(sizeof(make_index_set<17>) == 4, "Index set of size 17 requires 4 bytes");
+    STATIC_CHECK(sizeof(make_index_set<32>) == 4, "Index set of size 32 requires 4 bytes");
+    STATIC_CHECK(sizeof(make_index_set<33>) == 8, "Index set of size 33 requires 8 bytes");
+    STATIC_CHECK(sizeof(make_index_set<64>) == 8, "Index set of size 64 requires 8 bytes");
+    STATIC_CHECK(sizeof(make_index_set<65>) == 16, "Index set of size 65 requires 16 bytes");
+}
+
+TEST_CASE("index sets are trivially copyable")
+{
+    STATIC_CHECK(std::is_trivially_copyable<make_index_set<64>>::value, "Single word index set");
+    STATIC_CHECK(std::is_trivially_copyable<make_index_set<65>>::value, "Multi word index set");
+}
+
+TEST_CASE("set algebra on large index sets works across word boundaries")
+{
+    using large_set = make_index_set<500>;
+    constexpr auto x = large_set::make<0>() | large_set::make<64>() | large_set::make<499>();
+    constexpr auto y = large_set::make<64>() | large_set::make<300>();
+    STATIC_CHECK((x | y).size() == 4, "Union of large index sets has the expected size");
+    STATIC_CHECK((x & y) == large_set::make<64>(), "Intersection of large index sets");
+    STATIC_CHECK((x / y).size() == 2, "Difference of large index sets has the expected size");
+    STATIC_CHECK((x ^ y).size() == 3, "Symmetric difference of large index sets");
+    STATIC_CHECK((~x).size() == 497, "Complement of large index set has the expected size");
+    STATIC_CHECK((x & y) <= x, "Intersection is a subset of its operands");
+    STATIC_CHECK(!(x <= y), "Set is not a subset of a set missing some of its elements");
+}
+
+TEST_CASE("values of large index sets are read in constant time")
+{
+    using large_set = make_index_set<500>;
+    STATIC_CHECK(large_set::value_at(0) == 0, "First value of a large index set");
+    STATIC_CHECK(large_set::value_at(499) == 499, "Last value of a large index set");
+    constexpr auto x = large_set::make<3>() | large_set::make<498>();
+    STATIC_CHECK(*(++x.begin()) == 498, "Dereferencing an iterator far into the set");
+    STATIC_CHECK(x.select(1) == 498, "Selecting an element far into the set");
+    CHECK_THROWS(large_set::value_at(500));
+}
+
+TEST_CASE("large index sets are built from ranges spanning several words")
+{
+    using large_set = make_index_set<500>;
+    const size_t indices[] = {499, 0, 64, 63, 300};
+    const auto x = large_set::from_range(indices);
+    CHECK(x.size() == 5);
+    CHECK(x.front() == 0);
+    CHECK(x.back() == 499);
+    const size_t invalid[] = {1, 500};
+    large_set y{};
+    CHECK(y.try_insert(std::begin(invalid), std::end(invalid)) == invalid + 1);
+    CHECK_THROWS(y.insert(invalid));
+    CHECK(y.empty());
+}
+
+TEST_CASE("large index sets are written out as indices and values")
+{
+    using large_set = make_index_set<500>;
+    large_set x{};
+    for (size_t index = 1; index < 500; index += 3)
+    {
+        x.add(index);
+    }
+    std::vector<uint32_t> indices(500);
+    std::vector<size_t> values(500);
+    CHECK(x.to_indices(indices.data(), indices.size()) == x.size());
+    CHECK(x.to_values(values.data(), values.size()) == x.size());
+    size_t k = 0;
+    for (size_t element : x)
+    {
+        CHECK(indices[k] == element);
+        CHECK(values[k] == element);
+        ++k;
+    }
+}
+
+TEST_CASE("index set is a plain bit mask of its capacity")
+{
+    STATIC_CHECK(sizeof(index_set<64>) == 8, "Index set of size 64 requires 8 bytes");
+    STATIC_CHECK(sizeof(index_set<65>) == 16, "Index set of size 65 requires 16 bytes");
+    STATIC_CHECK(sizeof(index_set<(1 << 20)>) == (1 << 17), "Index set of size 2^20 is 128 KiB");
+    STATIC_CHECK(std::is_trivially_copyable<index_set<500>>::value, "Index set is copyable");
+    STATIC_CHECK(index_set<(1 << 24)>::capacity() == (1 << 24), "Capacity of a huge index set");
+}
+
+TEST_CASE("index set mirrors the interface of make_index_set")
+{
+    using set = index_set<500>;
+    constexpr auto x = set::make<0>() | set::make<64>() | set::make<499>();
+    constexpr auto y = set{64, 300};
+    STATIC_CHECK(x.has<64>() && !x.has<63>(), "Compile time membership");
+    STATIC_CHECK(x.has(499) && !x.has(500), "Runtime membership, invalid indices are absent");
+    STATIC_CHECK((x | y).size() == 4, "Union of index sets has the expected size");
+    STATIC_CHECK((x & y) == set::make<64>(), "Intersection of index sets");
+    STATIC_CHECK((x / y).size() == 2, "Difference of index sets has the expected size");
+    STATIC_CHECK((x ^ y).size() == 3, "Symmetric difference of index sets");
+    STATIC_CHECK((~x).size() == 497, "Complement of index set has the expected size");
+    STATIC_CHECK((x & y) < x && x > (x & y), "Intersection is a strict subset of its operands");
+    STATIC_CHECK(!(x <= y) && x >= x && x != y, "Comparison of index sets");
+    STATIC_CHECK(x.front() == 0 && x.back() == 499, "Lowest and highest element");
+    STATIC_CHECK(x.select(1) == 64 && x.rank<300>() == 2, "Selecting and ranking elements");
+    STATIC_CHECK(set::value_at(42) == 42 && set::index<42>() == 42, "Values are indices");
+    STATIC_CHECK(set{}.empty() && set{}.count() == 0, "Default constructed index set is empty");
+
+    set z{};
+    z.add<3>();
+    z.add(100);
+    CHECK(z.try_add(499));
+    CHECK(!z.try_add(500));
+    CHECK(z.size() == 3);
+    z.remove<3>();
+    z.remove(100);
+    CHECK(z.try_remove(499));
+    CHECK(!z.try_remove(500));
+    CHECK(z.empty());
+    CHECK_THROWS(z.add(500));
+    CHECK_THROWS(z.remove(500));
+    CHECK_THROWS(z.front());
+    CHECK_THROWS(z.back());
+    CHECK_THROWS(z.select(0));
+    CHECK_THROWS(set::value_at(500));
+    CHECK_THROWS((set{1, 500}));
+}
+
+TEST_CASE("index set iterates in both directions")
+{
+    using set = index_set<500>;
+    constexpr auto x = set{3, 63, 64, 128, 499};
+    const std::vector<size_t> expected{3, 63, 64, 128, 499};
+    CHECK(std::vector<size_t>(x.begin(), x.end()) == expected);
+    CHECK(std::vector<size_t>(x.rbegin(), x.rend())
+          == std::vector<size_t>(expected.rbegin(), expected.rend()));
+    auto it = x.end();
+    CHECK(*(--it) == 499);
+    CHECK(*(it--) == 499);
+    CHECK(*it == 128);
+    CHECK(*(it++) == 128);
+    CHECK(*it == 499);
+    CHECK(++it == x.end());
+    CHECK_THROWS(*it);
+    CHECK(set{}.begin() == set{}.end());
+}
+
+TEST_CASE("index set visits its elements by runtime index")
+{
+    const index_set<200> x{7, 70, 170};
+    std::vector<size_t> visited;
+    visit([&visited](size_t index) { visited.push_back(index); }, x);
+    CHECK(visited == std::vector<size_t>{7, 70, 170});
+}
+
+TEST_CASE("index set is built from ranges and written out as indices")
+{
+    using set = index_set<500>;
+    const int indices[] = {499, 0, 64, 63, 300};
+    auto x = set::from_range(indices);
+    CHECK(x == set{0, 63, 64, 300, 499});
+    const long invalid[] = {1, 500};
+    CHECK(x.try_insert(std::begin(invalid), std::end(invalid)) == invalid + 1);
+    CHECK_THROWS(x.insert(invalid));
+    CHECK(x.size() == 5);
+    std::vector<uint32_t> written(5);
+    CHECK(x.to_indices(written.data(), written.size()) == 5);
+    CHECK(written == std::vector<uint32_t>{0, 63, 64, 300, 499});
+    x.clear();
+    CHECK(x.empty());
+}
+
+TEST_CASE("index set with millions of elements is usable on the heap")
+{
+    using huge_set = index_set<(1 << 24)>;
+    auto x = std::make_unique<huge_set>();
+    auto y = std::make_unique<huge_set>();
+    for (size_t index = 0; index < huge_set::capacity(); index += 4096)
+    {
+        x->add(index);
+    }
+    y->add(4096);
+    y->add(huge_set::capacity() - 1);
+    CHECK(x->size() == 4096);
+    CHECK(x->has(8192));
+    CHECK(!x->has(8193));
+    CHECK(x->back() == huge_set::capacity() - 4096);
+
+    *y &= *x;
+    CHECK(y->size() == 1);
+    CHECK(y->front() == 4096);
+    *y |= *x;
+    CHECK(*y == *x);
+    *y ^= *x;
+    CHECK(y->empty());
+    y->add(1);
+    *y /= *x;
+    CHECK(y->size() == 1);
+
+    size_t visited = 0;
+    size_t previous = 0;
+    for (size_t index : *x)
+    {
+        CHECK((visited == 0 || index == previous + 4096));
+        previous = index;
+        ++visited;
+    }
+    CHECK(visited == 4096);
 }
 
 } // namespace enum_set
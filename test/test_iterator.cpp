@@ -33,18 +33,6 @@ constexpr auto universe
 namespace enum_set
 {
 
-TEST_CASE("find returns the first set bit greater or equal to the offset")
-{
-    constexpr ::enum_set::bit_mask<5> x = {true, false, true, false, true};
-    STATIC_CHECK(detail::find(x, 0) == 0, "Finds bit at zero offset");
-    STATIC_CHECK(detail::find(x, 1) == 2, "Finds first bit after offset");
-    STATIC_CHECK(detail::find(x, 2) == 2, "Finds bit at non-zero offset");
-    STATIC_CHECK(detail::find(x, 3) == 4, "Finds last bit if there is no other bit before");
-    STATIC_CHECK(detail::find(x, 4) == 4, "Finds last bit if offset is at last bit");
-    STATIC_CHECK(detail::find(x, 5) == 5, "Returns size of bit_mask for offset beyond last bit");
-    STATIC_CHECK(detail::find(x, 6) == 5, "Returns size of bit_mask for offset beyond last bit");
-}
-
 TEST_CASE("iterator initially points to first element with id greater or equal to offset")
 {
     testset x = testset::make<1>();
@@ -105,6 +93,30 @@ TEST_CASE("iterators are not equal if they point to different type sets")
     CHECK(i != j);
 }
 
+TEST_CASE("iterator observes modifications of the value set after the current word")
+{
+    using large_set = make_index_set<300>;
+    large_set x = large_set::make<1>() | large_set::make<100>();
+    auto it = x.begin();
+    x.remove<100>();
+    x.add<200>();
+    CHECK(*it == 1);
+    CHECK(*(++it) == 200);
+    CHECK(++it == x.end());
+}
+
+TEST_CASE("range based for loop over a temporary value set does not dangle")
+{
+    const testset x = testset::make<1>() | testset::make<3>() | testset::make<5>();
+    const testset y = testset::make<3>() | testset::make<5>() | testset::make<7>();
+    std::vector<int> result;
+    for (auto value : x & y)
+    {
+        result.push_back(value);
+    }
+    CHECK(result == std::vector<int>{3, 5});
+}
+
 TEST_CASE("iterators are not equal if they point to different elements")
 {
     constexpr std::size_t pivot = 5;
@@ -174,4 +186,149 @@ TEST_CASE("copy from enum set to vector using std copy works as expected")
     CHECK(result.at(9) == 9);
 }
 
+TEST_CASE("iterator skips empty words in large value sets")
+{
+    using large_set = make_index_set<300>;
+    constexpr auto X
+        = large_set::make<0>()
+        | large_set::make<63>()
+        | large_set::make<64>()
+        | large_set::make<200>()
+        | large_set::make<299>()
+        ;
+    std::vector<size_t> result;
+    for (auto it = X.begin(); it != X.end(); it++)
+    {
+        result.push_back(*it);
+    }
+    CHECK(result == std::vector<size_t>{0, 63, 64, 200, 299});
+    constexpr large_set empty{};
+    CHECK(empty.begin() == empty.end());
+    CHECK(*large_set::iterator(&X, 65) == 200);
+    CHECK(large_set::iterator(&X, 300) == X.end());
+}
+
+TEST_CASE("iterator decrement operator decrements as expected")
+{
+    constexpr auto X
+        = testset::make<0>()
+        | testset::make<5>()
+        | testset::make<9>()
+        ;
+    auto it = X.end();
+    CHECK(*(--it) == 9);
+    CHECK(*(--it) == 5);
+    CHECK(*(--it) == 0);
+    CHECK(it == X.begin());
+    CHECK(*(--it) == 0);
+    CHECK(*(it--) == 0);
+    CHECK(it == X.begin());
+}
+
+TEST_CASE("iterator decrement on end of empty set has no effects")
+{
+    constexpr testset X;
+    auto it = X.end();
+    --it;
+    CHECK(it == X.end());
+}
+
+TEST_CASE("reverse iterator visits elements from last to first")
+{
+    constexpr auto X
+        = testset::make<0>()
+        | testset::make<5>()
+        | testset::make<9>()
+        ;
+    std::vector<int> result(X.rbegin(), X.rend());
+    CHECK(result == std::vector<int>{9, 5, 0});
+    constexpr testset empty{};
+    CHECK(empty.rbegin() == empty.rend());
+}
+
+TEST_CASE("reverse iteration over large value sets steps backwards over empty words")
+{
+    using large_set = make_index_set<300>;
+    constexpr auto X
+        = large_set::make<0>()
+        | large_set::make<63>()
+        | large_set::make<64>()
+        | large_set::make<200>()
+        | large_set::make<299>()
+        ;
+    std::vector<size_t> result(X.rbegin(), X.rend());
+    CHECK(result == std::vector<size_t>{299, 200, 64, 63, 0});
+}
+
+TEST_CASE("iterator satisfies the bidirectional iterator requirements used by std algorithms")
+{
+    std::vector<int> result;
+    std::reverse_copy(universe.begin(), universe.end(), std::back_inserter(result));
+    CHECK(result == std::vector<int>{9, 7, 5, 3, 1, 8, 6, 4, 2, 0});
+    CHECK(std::distance(universe.begin(), universe.end()) == 10);
+    CHECK(*std::prev(universe.end()) == 9);
+}
+
+TEST_CASE("iterator is a random access iterator")
+{
+    constexpr auto X
+        = testset::make<0>()
+        | testset::make<5>()
+        | testset::make<8>()
+        | testset::make<9>()
+        ;
+    const auto begin = X.begin();
+    const auto end = X.end();
+    CHECK(end - begin == 4);
+    CHECK(begin - end == -4);
+    CHECK(*(begin + 2) == 5);
+    CHECK(*(2 + begin) == 5);
+    CHECK(*(end - 1) == 9);
+    CHECK(begin[3] == 9);
+    CHECK(begin + 4 == end);
+    CHECK(begin + 10 == end);
+    CHECK(end - 10 == begin);
+    CHECK(begin < end);
+    CHECK(begin + 1 > begin);
+    CHECK(begin <= begin);
+    CHECK(end >= begin + 3);
+    auto it = begin;
+    it += 3;
+    CHECK(*it == 9);
+    it -= 2;
+    CHECK(*it == 8);
+    CHECK(it - begin == 1);
+    CHECK(end - it == 3);
+}
+
+TEST_CASE("iterator differences are kept consistent by increments and decrements")
+{
+    using large_set = make_index_set<300>;
+    constexpr auto X
+        = large_set::make<0>()
+        | large_set::make<63>()
+        | large_set::make<64>()
+        | large_set::make<200>()
+        | large_set::make<299>()
+        ;
+    auto it = X.begin();
+    ++it;
+    ++it;
+    CHECK(it - X.begin() == 2);
+    CHECK(*it == 64);
+    --it;
+    CHECK(it - X.begin() == 1);
+    CHECK(X.end() - it == 4);
+    CHECK(large_set::iterator(&X, 65) - X.begin() == 3);
+    CHECK(*(X.begin() + 3) == 200);
+    CHECK(std::distance(X.begin(), X.end()) == 5);
+}
+
+TEST_CASE("vector constructed from a value set range holds all elements")
+{
+    const std::vector<int> result(universe.begin(), universe.end());
+    CHECK(result.capacity() == 10);
+    CHECK(result == std::vector<int>{0, 2, 4, 6, 8, 1, 3, 5, 7, 9});
+}
+
 } // namespace enum_set
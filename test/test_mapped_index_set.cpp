@@ -0,0 +1,208 @@
+#include "testing.hpp"
+
+#include <enum_set/mapped_index_set.hpp>
+#include <enum_set/standard_types.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace enum_set
+{
+
+namespace
+{
+
+/// Temporary file path, removing the file on destruction.
+struct temporary_file
+{
+    std::string path;
+
+    temporary_file()
+        : path{"/tmp/enum_set_mapped_XXXXXX"}
+    {
+        const int handle = ::mkstemp(&path[0]);
+        REQUIRE(handle >= 0);
+        ::close(handle);
+    }
+
+    ~temporary_file()
+    {
+        std::remove(path.c_str());
+    }
+};
+
+/// Returns the elements of a set in iteration order.
+std::vector<size_t> elements_of(mapped_index_set const& set)
+{
+    return std::vector<size_t>(set.begin(), set.end());
+}
+
+} // namespace
+
+TEST_CASE("mapped index set has the runtime interface of index_set")
+{
+    const temporary_file file;
+    auto x = mapped_index_set::create(file.path, 1000);
+    CHECK(x.capacity() == 1024);
+    CHECK(x.is_writable());
+    CHECK(x.empty());
+    x.add(0);
+    x.add(63);
+    x.add(64);
+    x.add(1023);
+    CHECK(x.size() == 4);
+    CHECK(x.count() == 4);
+    CHECK(x.has(63));
+    CHECK(!x.has(62));
+    CHECK(!x.has(1024));
+    CHECK(x.front() == 0);
+    CHECK(x.back() == 1023);
+    CHECK(elements_of(x) == std::vector<size_t>{0, 63, 64, 1023});
+    CHECK(std::vector<size_t>(x.rbegin(), x.rend()) == std::vector<size_t>{1023, 64, 63, 0});
+    std::vector<uint32_t> written(4);
+    CHECK(x.to_indices(written.data(), written.size()) == 4);
+    CHECK(written == std::vector<uint32_t>{0, 63, 64, 1023});
+    x.remove(0);
+    CHECK(x.try_add(1));
+    CHECK(x.try_remove(63));
+    CHECK(!x.try_add(1024));
+    CHECK(!x.try_remove(1024));
+    CHECK(elements_of(x) == std::vector<size_t>{1, 64, 1023});
+    CHECK_THROWS_AS(x.add(1024), std::out_of_range);
+    CHECK_THROWS_AS(x.remove(1024), std::out_of_range);
+    x.advise(map_access::sequential);
+    x.advise(map_access::random);
+    x.advise(map_access::will_need);
+    x.advise(map_access::normal);
+    x.clear();
+    CHECK(x.empty());
+    CHECK_THROWS(x.front());
+    CHECK_THROWS(x.back());
+}
+
+TEST_CASE("mapped index set persists modifications in its file")
+{
+    const temporary_file file;
+    {
+        auto x = mapped_index_set::create(file.path, 200);
+        x.add(7);
+        x.add(199);
+        x.sync();
+    }
+    const auto y = mapped_index_set::open(file.path);
+    CHECK(!y.is_writable());
+    CHECK(y.capacity() == 256);
+    CHECK(elements_of(y) == std::vector<size_t>{7, 199});
+
+    auto z = mapped_index_set::open(file.path, map_mode::read_write);
+    z.add(100);
+    CHECK(y.has(100));
+}
+
+TEST_CASE("read only mapped index set rejects modifications")
+{
+    const temporary_file file;
+    mapped_index_set::create(file.path, 64);
+    auto x = mapped_index_set::open(file.path);
+    CHECK_THROWS_AS(x.add(1), std::logic_error);
+    CHECK_THROWS_AS(x.remove(1), std::logic_error);
+    CHECK(!x.try_add(1));
+    CHECK(!x.try_remove(1));
+    STATIC_CHECK(noexcept(x.try_add(1)), "try_add never throws");
+    STATIC_CHECK(noexcept(x.try_remove(1)), "try_remove never throws");
+    CHECK_THROWS_AS(x.clear(), std::logic_error);
+    x.sync();
+}
+
+TEST_CASE("mapped index set reports invalid files")
+{
+    const temporary_file file;
+    CHECK_THROWS_AS(mapped_index_set::open(file.path), std::invalid_argument);
+    CHECK_THROWS_AS(mapped_index_set::create(file.path, 0), std::invalid_argument);
+    CHECK_THROWS_AS(
+        mapped_index_set::open("/nonexistent/enum_set_mapped"), std::system_error);
+}
+
+TEST_CASE("mapped index set reports errors without throwing")
+{
+    const temporary_file file;
+    std::error_code error;
+    auto x = mapped_index_set::try_open(file.path, map_mode::read_only, error);
+    CHECK(error == std::errc::invalid_argument);
+    CHECK(x.capacity() == 0);
+    CHECK(x.empty());
+    x = mapped_index_set::try_create(file.path, 0, error);
+    CHECK(error == std::errc::invalid_argument);
+    x = mapped_index_set::try_open("/nonexistent/enum_set_mapped", map_mode::read_only, error);
+    CHECK(error == std::errc::no_such_file_or_directory);
+    CHECK(x.capacity() == 0);
+
+    x = mapped_index_set::try_create(file.path, 64, error);
+    CHECK(!error);
+    CHECK(x.capacity() == 64);
+    CHECK(x.try_add(3));
+    x.advise(map_access::sequential, error);
+    CHECK(!error);
+    x.sync(error);
+    CHECK(!error);
+    const auto y = mapped_index_set::try_open(file.path, map_mode::read_only, error);
+    CHECK(!error);
+    CHECK(y.has(3));
+}
+
+TEST_CASE("moving a mapped index set moves its mapping")
+{
+    const temporary_file file;
+    auto x = mapped_index_set::create(file.path, 128);
+    x.add(5);
+    mapped_index_set y = std::move(x);
+    CHECK(x.capacity() == 0);
+    CHECK(y.has(5));
+    const temporary_file other;
+    auto z = mapped_index_set::create(other.path, 64);
+    z = std::move(y);
+    CHECK(z.capacity() == 128);
+    CHECK(z.has(5));
+}
+
+TEST_CASE("mapped index set over 2^32 indices opens without loading")
+{
+    const temporary_file file;
+    const size_t capacity = size_t{1} << 32;
+    {
+        auto x = mapped_index_set::create(file.path, capacity);
+        x.add(5);
+        x.add(capacity - 1);
+    }
+    const auto y = mapped_index_set::open(file.path);
+    CHECK(y.capacity() == capacity);
+    CHECK(y.has(5));
+    CHECK(y.has(capacity - 1));
+    CHECK(!y.has(capacity / 2));
+    CHECK(y.front() == 5);
+    CHECK(y.back() == capacity - 1);
+}
+
+TEST_CASE("clearing a sparse mapped index set keeps its file sparse")
+{
+    const temporary_file file;
+    const size_t capacity = size_t{1} << 32;
+    auto x = mapped_index_set::create(file.path, capacity);
+    x.add(5);
+    x.add(capacity - 1);
+    x.clear();
+    x.sync();
+    CHECK(x.empty());
+    struct stat status{};
+    REQUIRE(::stat(file.path.c_str(), &status) == 0);
+    CHECK(static_cast<size_t>(status.st_blocks) * 512 < capacity / 8 / 64);
+}
+
+} // namespace enum_set
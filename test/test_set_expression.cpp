@@ -0,0 +1,142 @@
+#include "testing.hpp"
+
+#include <enum_set/index_set.hpp>
+#include <enum_set/set_expression.hpp>
+#include <enum_set/type_set.hpp>
+#include <enum_set/value_set.hpp>
+
+#include <iterator>
+#include <vector>
+
+using namespace ::enum_set;
+
+namespace
+{
+
+using small_set = make_index_set<10>;
+using large_set = make_index_set<300>;
+
+struct A {};
+struct B {};
+struct C {};
+
+using types = type_set<A, B, C>;
+
+using values = value_set<int, 2, 3, 5, 7>;
+
+/// Returns a large set with every `step`:th index set, starting at `offset`.
+large_set every(size_t step, size_t offset)
+{
+    large_set result{};
+    for (size_t index = offset; index < large_set::capacity(); index += step)
+    {
+        result.add(index);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("set expressions evaluate to the same sets as the eager operators")
+{
+    const large_set a = every(2, 0);
+    const large_set b = every(3, 1);
+    const large_set c = every(5, 2);
+    const large_set d = every(7, 299 % 7);
+
+    CHECK((lazy(a) | b).evaluate() == (a | b));
+    CHECK((lazy(a) & b).evaluate() == (a & b));
+    CHECK((lazy(a) ^ b).evaluate() == (a ^ b));
+    CHECK((lazy(a) / b).evaluate() == (a / b));
+    CHECK((~lazy(a)).evaluate() == ~a);
+    CHECK(((lazy(a) | b) & ~lazy(c) / d).evaluate() == ((a | b) & ~c / d));
+    CHECK((a ^ (lazy(b) & c) ^ d).evaluate() == (a ^ (b & c) ^ d));
+    CHECK((~(lazy(a) | b | c | d)).evaluate() == ~(a | b | c | d));
+
+    large_set assigned = lazy(a) & b;
+    CHECK(assigned == (a & b));
+    assigned = lazy(assigned) | c;
+    CHECK(assigned == ((a & b) | c));
+}
+
+TEST_CASE("set expressions direct initialize sets")
+{
+    const large_set a = every(2, 0);
+    const large_set b = every(3, 1);
+    const large_set parenthesized(lazy(a) & b);
+    const large_set braced{lazy(a) & b};
+    CHECK(parenthesized == (a & b));
+    CHECK(braced == (a & b));
+
+    const values x{2, 3, 5};
+    const values y{3, 5, 7};
+    const values value_parenthesized(lazy(x) & y);
+    const values value_braced{lazy(x) | y};
+    CHECK(value_parenthesized == values{3, 5});
+    CHECK(value_braced == values{2, 3, 5, 7});
+
+    constexpr types ab = types::make<A>() | types::make<B>();
+    constexpr types type_braced{~lazy(ab)};
+    STATIC_CHECK(type_braced == types::make<C>(), "Direct initialized type set");
+}
+
+TEST_CASE("set expressions count and test emptiness without materializing")
+{
+    const large_set a = every(2, 0);
+    const large_set b = every(2, 1);
+    CHECK((lazy(a) | b).size() == 300);
+    CHECK((lazy(a) & b).size() == 0);
+    CHECK((lazy(a) & b).empty());
+    CHECK(!(lazy(a) | b).empty());
+    CHECK((~(lazy(a) | b)).empty());
+    CHECK((~lazy(a)).size() == 150);
+}
+
+TEST_CASE("set expressions test subsets against sets and expressions")
+{
+    const large_set a = every(2, 0);
+    const large_set b = every(4, 0);
+    CHECK((lazy(b) & a).is_subset_of(a));
+    CHECK(lazy(b).is_subset_of(a));
+    CHECK(!lazy(a).is_subset_of(b));
+    CHECK((lazy(a) / b).is_subset_of(lazy(a) | b));
+    CHECK(!(~lazy(a)).is_subset_of(a));
+}
+
+TEST_CASE("set expressions can be iterated over")
+{
+    const large_set a{1, 100, 299};
+    const large_set b{100, 200};
+    std::vector<size_t> elements;
+    for (auto element : lazy(a) ^ b)
+    {
+        elements.push_back(element);
+    }
+    CHECK(elements == std::vector<size_t>{1, 200, 299});
+    const auto expression = lazy(a) ^ b;
+    CHECK(std::distance(expression.begin(), expression.end()) == 3);
+    CHECK(std::vector<size_t>(expression.begin(), expression.end()) == elements);
+    CHECK(std::next((lazy(a) & b).begin()) == (lazy(a) & b).end());
+    CHECK(*(lazy(a) & b).begin() == 100);
+    CHECK((lazy(a) / a).begin() == (lazy(a) / a).end());
+}
+
+TEST_CASE("set expressions are constexpr")
+{
+    constexpr small_set x{1, 2, 3};
+    constexpr small_set y{3, 4};
+    constexpr small_set z = (lazy(x) | y) / small_set{1};
+    STATIC_CHECK((z == small_set{2, 3, 4}), "Constexpr evaluation");
+    STATIC_CHECK((lazy(x) & y).size() == 1, "Constexpr count");
+    STATIC_CHECK((~lazy(x) | x).size() == 10, "Complement keeps the tail bits clear");
+    STATIC_CHECK(!(lazy(x) / x).size(), "Constexpr empty difference");
+}
+
+TEST_CASE("set expressions work with type sets")
+{
+    constexpr types ab = types::make<A>() | types::make<B>();
+    constexpr types bc = types::make<B>() | types::make<C>();
+    constexpr types b = lazy(ab) & bc;
+    STATIC_CHECK(b == types::make<B>(), "Lazy intersection of type sets");
+    STATIC_CHECK((~lazy(ab)).size() == 1, "Lazy complement of type sets");
+}
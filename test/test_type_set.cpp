@@ -416,6 +416,16 @@ TEST_CASE("type_set clear method works as expected")
     CHECK(X.empty());
 }
 
+TEST_CASE_FIXTURE(test_fixture, "type set to indices writes the indices of all elements")
+{
+    size_t indices[4] = {};
+    CHECK(DCA.to_indices(indices, 4) == 3);
+    CHECK(indices[0] == test_set::index<code::A>());
+    CHECK(indices[1] == test_set::index<code::C>());
+    CHECK(indices[2] == test_set::index<code::D>());
+    CHECK(empty.to_indices(indices, 4) == 0);
+}
+
 TEST_CASE_FIXTURE(test_fixture, "type set visit visits the expected types")
 {
     std::vector<size_t> indices;
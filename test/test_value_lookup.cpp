@@ -0,0 +1,180 @@
+#include "testing.hpp"
+
+#include <enum_set/common.hpp>
+#include <enum_set/value_lookup.hpp>
+
+#include <utility>
+
+using namespace ::enum_set;
+
+namespace
+{
+
+enum class color : short
+{
+    red = -3,
+    green = 0,
+    blue = 4
+};
+
+enum plain
+{
+    first = 10,
+    second = 11,
+    third = 12
+};
+
+using detail::lookup_strategy;
+
+template <typename Type, Type... Values>
+constexpr lookup_strategy strategy()
+{
+    return detail::value_lookup<Type, Values...>::strategy();
+}
+
+template <typename Type, Type... Values>
+constexpr bool same_as_linear(long long first, long long last)
+{
+    for (long long key = first; key <= last; ++key)
+    {
+        const Type value = static_cast<Type>(key);
+        if (detail::value_lookup<Type, Values...>::index(value)
+            != detail::index_of_value<Type, Values...>(value))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Sequence>
+struct universe;
+
+/// Universe of the cubes of the indices of `Sequence`.
+template <long long... Indices>
+struct universe<std::integer_sequence<long long, Indices...>>
+{
+    using lookup = detail::value_lookup<long long, Indices * Indices * Indices...>;
+};
+
+}  // namespace
+
+TEST_CASE("value lookup picks dense lookup for consecutive values")
+{
+    STATIC_CHECK((strategy<int, 0, 1, 2, 3>() == lookup_strategy::dense),
+                 "Consecutive values starting at zero are dense");
+    STATIC_CHECK((strategy<int, -2, -1, 0>() == lookup_strategy::dense),
+                 "Consecutive negative values are dense");
+    STATIC_CHECK((strategy<plain, first, second, third>() == lookup_strategy::dense),
+                 "Consecutive enum values are dense");
+    STATIC_CHECK((strategy<int, 5>() == lookup_strategy::dense), "A single value is dense");
+    STATIC_CHECK((same_as_linear<int, -2, -1, 0>(-10, 10)), "Dense lookup agrees with linear");
+    STATIC_CHECK((same_as_linear<plain, first, second, third>(0, 20)),
+                 "Dense enum lookup agrees with linear lookup");
+}
+
+TEST_CASE("value lookup picks flags lookup for powers of two")
+{
+    STATIC_CHECK((strategy<int, 1, 2, 4, 8>() == lookup_strategy::flags),
+                 "Powers of two from one are flags");
+    STATIC_CHECK((strategy<int, 1, 2>() == lookup_strategy::flags),
+                 "Flags are picked over dense values");
+    STATIC_CHECK((strategy<int, 2, 4, 8>() != lookup_strategy::flags),
+                 "Powers of two from two are not flags");
+    STATIC_CHECK((strategy<unsigned long long, 1, 2, 4, 8, 16, 32, 64, 128>()
+                  == lookup_strategy::flags),
+                 "Unsigned powers of two are flags");
+    STATIC_CHECK((same_as_linear<int, 1, 2, 4, 8>(-20, 20)),
+                 "Flags lookup agrees with linear lookup");
+    STATIC_CHECK((same_as_linear<signed char, 1, 2, 4, 8, 16, 32, 64, -128>(-128, 127)),
+                 "Flags lookup handles the sign bit");
+    STATIC_CHECK((strategy<bool, false, true>() == lookup_strategy::dense),
+                 "Booleans are never flags");
+}
+
+TEST_CASE("value lookup picks table lookup for values in a small range")
+{
+    STATIC_CHECK((strategy<int, 0, 2, 1>() == lookup_strategy::table),
+                 "Unordered values in a small range use a table");
+    STATIC_CHECK((strategy<color, color::red, color::green, color::blue>()
+                  == lookup_strategy::table),
+                 "Enum values with gaps use a table");
+    STATIC_CHECK((same_as_linear<int, 0, 2, 1>(-5, 5)), "Table lookup agrees with linear lookup");
+    STATIC_CHECK((same_as_linear<color, color::red, color::green, color::blue>(-10, 10)),
+                 "Table lookup of enum with negative values agrees with linear lookup");
+    STATIC_CHECK((same_as_linear<int, 7, 3, 7, 1>(-5, 10)),
+                 "Table lookup finds the first occurence of duplicates");
+}
+
+TEST_CASE("value lookup picks hash for sparse values")
+{
+    using far_apart = detail::value_lookup<long long, 1LL << 62, -(1LL << 62), 0>;
+    STATIC_CHECK((strategy<int, 1000, -1000, 0>() == lookup_strategy::hash),
+                 "Sparse values are hashed");
+    STATIC_CHECK((strategy<long, 1, 7, 200, 4096, 70000>() == lookup_strategy::hash),
+                 "Protocol values with large gaps are hashed");
+    STATIC_CHECK(far_apart::index(0) == 2, "Hash handles keys far apart");
+    STATIC_CHECK(far_apart::index(-(1LL << 62)) == 1, "Hash handles negative keys");
+    STATIC_CHECK(far_apart::index(1) == 3, "Hash handles missing keys");
+    STATIC_CHECK((same_as_linear<int, 1000, -1000, 0>(-1010, 1010)),
+                 "Hash lookup agrees with linear lookup");
+    STATIC_CHECK((same_as_linear<int, 500, 100, 500, -200, 100>(-300, 600)),
+                 "Hash lookup finds the first occurence of duplicates");
+    STATIC_CHECK((same_as_linear<unsigned, 0xFFFFFFFF, 0, 0x80000000, 1000>(0, 1100)),
+                 "Hash lookup agrees with linear lookup for unsigned keys");
+}
+
+TEST_CASE("value lookup hash does not grow with the gaps")
+{
+    using narrow = detail::value_lookup_strategy<lookup_strategy::hash, long long,
+                                                 0, 1000, 2000, 3000, 4000>;
+    using wide = detail::value_lookup_strategy<lookup_strategy::hash, long long,
+                                               0, 1LL << 40, 2LL << 40, 3LL << 40, 4LL << 40>;
+    STATIC_CHECK(narrow::table.complete && wide::table.complete, "Seeds are found");
+    STATIC_CHECK(sizeof(narrow::table) == sizeof(wide::table),
+                 "The table size depends on the number of values only");
+    STATIC_CHECK(wide::index(3LL << 40) == 3, "Wide values are found");
+    STATIC_CHECK(wide::index(3LL << 39) == 5, "Missing wide values are not found");
+}
+
+TEST_CASE("value lookup hash places many values")
+{
+    using cubes = universe<std::make_integer_sequence<long long, 300>>;
+    STATIC_CHECK(cubes::lookup::strategy() == lookup_strategy::hash, "Cubes are hashed");
+    for (long long index = 0; index < 300; ++index)
+    {
+        const long long cube = index * index * index;
+        CHECK(cubes::lookup::index(cube) == static_cast<size_t>(index));
+        CHECK(cubes::lookup::index(cube + 1) == ((index == 0) ? 1 : 300));
+    }
+}
+
+TEST_CASE("hash seed search places the first of equal hashes")
+{
+    using table_type = detail::lookup_hash_table<int, uint8_t, 4>;
+    constexpr uint64_t hashes[] = {
+        table_type::hash(7), table_type::hash(-3), table_type::hash(7), table_type::hash(90)
+    };
+    constexpr auto found = detail::search_hash_seeds<table_type, 4>(hashes);
+    STATIC_CHECK(found.complete, "Seeds are found");
+    STATIC_CHECK(found.distinct == 3, "The second 7 is left out");
+    for (size_t key : {size_t{0}, size_t{1}, size_t{3}})
+    {
+        const uint64_t hash = hashes[key];
+        CHECK(found.slots[table_type::slot(hash, found.seeds[table_type::bucket(hash)])] == key);
+    }
+}
+
+TEST_CASE("value lookup search finds values in a sorted table")
+{
+    using far_apart = detail::value_lookup_strategy<lookup_strategy::search, long long,
+                                                    1LL << 62, -(1LL << 62), 0>;
+    using duplicates = detail::value_lookup_strategy<lookup_strategy::search, int,
+                                                     500, 100, 500, -200, 100>;
+    STATIC_CHECK(far_apart::index(0) == 2, "Search handles keys far apart");
+    STATIC_CHECK(far_apart::index(-(1LL << 62)) == 1, "Search handles negative keys");
+    STATIC_CHECK(far_apart::index(1) == 3, "Search handles missing keys");
+    STATIC_CHECK(duplicates::index(100) == 1, "Search finds the first occurence of duplicates");
+    STATIC_CHECK(duplicates::index(-200) == 3, "Search finds the last key");
+    STATIC_CHECK(duplicates::index(0) == 5, "Search does not find missing keys");
+}
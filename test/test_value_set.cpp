@@ -112,6 +112,105 @@ TEST_CASE("variadic constructor throws exception for invalid value")
     CHECK_THROWS(test_set{3});
 }
 
+TEST_CASE("value at returns the value at an index")
+{
+    STATIC_CHECK(test_set::value_at(0) == 0, "First value");
+    STATIC_CHECK(test_set::value_at(1) == 2, "Second value");
+    STATIC_CHECK(test_set::value_at(2) == 1, "Third value");
+    STATIC_CHECK(test_set::value_at(test_set::index<2>()) == 2, "Inverse of index");
+    CHECK_THROWS(test_set::value_at(3));
+}
+
+TEST_CASE("runtime has, add and remove look up values")
+{
+    test_set x{};
+    x.add(2);
+    x.add(1);
+    CHECK(x.has(2));
+    CHECK(x.has(1));
+    CHECK(!x.has(0));
+    CHECK(!x.has(3));
+    x.remove(2);
+    CHECK(!x.has(2));
+    CHECK(x == test_set{1});
+    CHECK_THROWS(x.add(3));
+    CHECK_THROWS(x.remove(-1));
+    STATIC_CHECK((test_set{0, 1}.has(1)), "Runtime has is constexpr");
+}
+
+TEST_CASE("runtime has and add look up boolean values")
+{
+    using bool_set = value_set<bool, false, true>;
+    bool_set x{};
+    x.add(true);
+    CHECK(x.has(true));
+    CHECK(!x.has(false));
+    CHECK(x.try_add(false));
+    CHECK(x == bool_set{false, true});
+    STATIC_CHECK((bool_set{true}.has(true)), "Runtime has of booleans is constexpr");
+}
+
+TEST_CASE("try add and try remove report invalid values instead of throwing")
+{
+    test_set x{};
+    CHECK(x.try_add(2));
+    CHECK(!x.try_add(3));
+    CHECK(x == test_set{2});
+    CHECK(!x.try_remove(3));
+    CHECK(x.try_remove(2));
+    CHECK(x.empty());
+}
+
+TEST_CASE("value sets are built from ranges of runtime values")
+{
+    const std::vector<int> values{2, 0, 2};
+    CHECK(test_set::from_range(values.begin(), values.end()) == test_set{0, 2});
+    CHECK(test_set::from_range(values) == test_set{0, 2});
+    CHECK(test_set::from_range(values.begin(), values.begin()).empty());
+    CHECK_THROWS(test_set::from_range(std::vector<int>{1, 3}));
+
+    constexpr int array[] = {1, 2};
+    STATIC_CHECK(test_set::from_range(array) == (test_fixture::x1 | test_fixture::x2),
+                 "Built from a range at compile time");
+}
+
+TEST_CASE("value set insert adds ranges of values or nothing")
+{
+    test_set x{0};
+    x.insert(std::vector<int>{1});
+    CHECK(x == test_set{0, 1});
+    const std::vector<int> invalid{2, -1};
+    CHECK_THROWS(x.insert(invalid.begin(), invalid.end()));
+    CHECK(x == test_set{0, 1});
+}
+
+TEST_CASE("value set try_insert reports the first invalid value")
+{
+    test_set x{};
+    const std::vector<int> valid{2, 1};
+    CHECK(x.try_insert(valid.begin(), valid.end()) == valid.end());
+    CHECK(x == test_set{1, 2});
+
+    test_set y{};
+    const std::vector<int> invalid{0, 5, 1, 7};
+    CHECK(y.try_insert(invalid.begin(), invalid.end()) == invalid.begin() + 1);
+    CHECK(y.empty());
+}
+
+TEST_CASE_FIXTURE(test_fixture, "value set to values writes the elements in index order")
+{
+    int values[3] = {-1, -1, -1};
+    CHECK(all.to_values(values, 3) == 3);
+    CHECK(values[0] == 0);
+    CHECK(values[1] == 2);
+    CHECK(values[2] == 1);
+    int truncated[3] = {-1, -1, -1};
+    CHECK((x1 | x2).to_values(truncated, 1) == 1);
+    CHECK(truncated[0] == 2);
+    CHECK(truncated[1] == -1);
+    CHECK(empty.to_values(values, 3) == 0);
+}
+
 TEST_CASE("size of value set_of specified size is as expected")
 {
     STATIC_CHECK(sizeof(value_set<int, 0>) == 1,
@@ -122,6 +221,14 @@ TEST_CASE("size of value set_of specified size is as expected")
                   "Typeset of size 9 requires 2 bytes");
 }
 
+TEST_CASE("value sets of small universes are trivially copyable single words")
+{
+    STATIC_CHECK(std::is_trivially_copyable<test_set>::value,
+                 "Value set is trivially copyable");
+    STATIC_CHECK(alignof(value_set<int, 0, 1, 2, 3, 4, 5, 6, 7, 8>) == 2,
+                 "Value set of size 9 is aligned as a 16-bit word");
+}
+
 TEST_CASE_FIXTURE(test_fixture, "value set has the expected elements")
 {
     STATIC_CHECK(!empty.has<0>(), "Empty value set does not contain anything");
@@ -266,6 +373,42 @@ TEST_CASE_FIXTURE(test_fixture, "value set iterator increments as expected")
     CHECK_THROWS(*it);
 }
 
+TEST_CASE_FIXTURE(test_fixture, "value set front and back return the lowest and highest element")
+{
+    STATIC_CHECK(all.front() == 0, "First element of all is the first value");
+    STATIC_CHECK(all.back() == 1, "Last element of all is the last value");
+    STATIC_CHECK(x2.front() == 2, "First element of singleton is its element");
+    STATIC_CHECK(x2.back() == 2, "Last element of singleton is its element");
+    STATIC_CHECK((x1 | x2).front() == 2, "First element follows the order of the values");
+    CHECK_THROWS(empty.front());
+    CHECK_THROWS(empty.back());
+}
+
+TEST_CASE_FIXTURE(test_fixture, "value set rank counts the elements before a value")
+{
+    STATIC_CHECK(all.rank<0>() == 0, "Nothing comes before the first value");
+    STATIC_CHECK(all.rank<2>() == 1, "Ranks follow the order of the values");
+    STATIC_CHECK(all.rank<1>() == 2, "Ranks follow the order of the values");
+    STATIC_CHECK((x0 | x1).rank<1>() == 1, "Only elements in the set are counted");
+    STATIC_CHECK(x1.rank<2>() == 0, "Rank of a value not in the set is where it would be");
+}
+
+TEST_CASE_FIXTURE(test_fixture, "value set select returns the k:th element")
+{
+    STATIC_CHECK(all.select(0) == 0, "First element");
+    STATIC_CHECK(all.select(1) == 2, "Second element");
+    STATIC_CHECK(all.select(2) == 1, "Third element");
+    STATIC_CHECK((x0 | x1).select(1) == 1, "Only elements in the set are selected");
+    CHECK_THROWS(all.select(3));
+    CHECK_THROWS(empty.select(0));
+}
+
+TEST_CASE_FIXTURE(test_fixture, "value set reverse iterator visits elements in reverse order")
+{
+    std::vector<int> result(all.rbegin(), all.rend());
+    CHECK(result == std::vector<int>{1, 2, 0});
+}
+
 TEST_CASE_FIXTURE(test_fixture, "value set visit visits the expected types")
 {
     std::vector<std::pair<int, size_t>> result;
@@ -0,0 +1,109 @@
+#include "testing.hpp"
+
+#include <enum_set/enum_set.hpp>
+#include <enum_set/integer_set.hpp>
+#include <enum_set/standard_types.hpp>
+#include <enum_set/value_set.hpp>
+#include <enum_set/value_set_view.hpp>
+
+#include <vector>
+
+namespace enum_set
+{
+
+namespace
+{
+
+enum class color : int8_t { red, green, blue, alpha };
+
+using color_set = value_set<color, color::red, color::green, color::blue, color::alpha>;
+using reordered_set = value_set<color, color::green, color::red, color::blue, color::alpha>;
+using smaller_set = value_set<color, color::red, color::green, color::blue>;
+using wider_set = value_set<int, 0, 1, 2, 3>;
+using large_set = make_integer_set<int, 200>;
+
+} // namespace
+
+TEST_CASE("fingerprint depends on the values, their order and their type")
+{
+    STATIC_CHECK(
+        set_layout<color_set>::fingerprint == set_layout<color_set::base_type>::fingerprint,
+        "Value set and its type set base have the same layout");
+    STATIC_CHECK(
+        set_layout<color_set>::fingerprint != set_layout<reordered_set>::fingerprint,
+        "Reordering values changes the fingerprint");
+    STATIC_CHECK(
+        set_layout<color_set>::fingerprint != set_layout<smaller_set>::fingerprint,
+        "Removing values changes the fingerprint");
+    STATIC_CHECK(
+        set_layout<color_set>::fingerprint != set_layout<wider_set>::fingerprint,
+        "Changing the type of values changes the fingerprint");
+    STATIC_CHECK(set_layout<color_set>::size == 9, "Header and one byte of elements");
+    STATIC_CHECK(set_layout<large_set>::size == 8 + 25, "Header and 25 bytes of elements");
+}
+
+TEST_CASE("serialized layout is stable")
+{
+    const color_set x{color::red, color::blue};
+    unsigned char bytes[set_layout<color_set>::size] = {};
+    CHECK(serialize(x, bytes, sizeof(bytes)) == sizeof(bytes));
+    const uint64_t fingerprint = set_layout<color_set>::fingerprint;
+    for (size_t byte = 0; byte < 8; ++byte)
+    {
+        CHECK(bytes[byte] == static_cast<unsigned char>(fingerprint >> (8 * byte)));
+    }
+    CHECK(bytes[8] == 0x05);
+    CHECK_THROWS(serialize(x, bytes, sizeof(bytes) - 1));
+}
+
+TEST_CASE("value set view reads the elements in place")
+{
+    large_set x{};
+    x.add(0);
+    x.add(63);
+    x.add(64);
+    x.add(199);
+    std::vector<unsigned char> bytes(set_layout<large_set>::size);
+    serialize(x, bytes.data(), bytes.size());
+    const value_set_view<large_set> view(bytes.data(), bytes.size());
+    CHECK(view.has<63>());
+    CHECK(!view.has<62>());
+    CHECK(view.has(199));
+    CHECK(!view.has(200));
+    CHECK(!view.has(-1));
+    CHECK(view.size() == 4);
+    CHECK(!view.empty());
+    CHECK(view.to_set() == x);
+    const large_set y = view;
+    CHECK(y == x);
+    CHECK(std::vector<int>(view.begin(), view.end()) == std::vector<int>{0, 63, 64, 199});
+
+    bytes[8] = 0;
+    CHECK(!view.has(0));
+    CHECK(view.size() == 3);
+}
+
+TEST_CASE("value set view ignores unused bits of the last byte")
+{
+    std::vector<unsigned char> bytes(set_layout<color_set>::size);
+    serialize(color_set{}, bytes.data(), bytes.size());
+    bytes[8] = 0xF2;
+    const value_set_view<color_set> view(bytes.data(), bytes.size());
+    CHECK(view.size() == 1);
+    CHECK(view.has(color::green));
+    CHECK(view.to_set() == color_set{color::green});
+}
+
+TEST_CASE("value set view rejects another universe")
+{
+    std::vector<unsigned char> bytes(set_layout<color_set>::size);
+    serialize(color_set{color::red}, bytes.data(), bytes.size());
+    CHECK(value_set_view<color_set>::accepts(bytes.data(), bytes.size()));
+    CHECK(!value_set_view<color_set>::accepts(bytes.data(), bytes.size() - 1));
+    CHECK(!value_set_view<reordered_set>::accepts(bytes.data(), bytes.size()));
+    CHECK(!value_set_view<smaller_set>::accepts(bytes.data(), bytes.size()));
+    CHECK_THROWS(value_set_view<reordered_set>(bytes.data(), bytes.size()));
+    CHECK_THROWS(value_set_view<color_set>(bytes.data(), bytes.size() + 1));
+}
+
+} // namespace enum_set
@@ -0,0 +1,189 @@
+#include "testing.hpp"
+
+#include <enum_set/bit_mask.hpp>
+#include <enum_set/word_kernels.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace ::enum_set;
+
+namespace
+{
+
+/// Deterministic pseudo random words (xorshift), sparse every fourth word to exercise zero words.
+std::vector<uint64_t> random_words(size_t count, uint64_t seed)
+{
+    std::vector<uint64_t> words(count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        words[index] = (index % 4 == 3) ? (seed & (seed >> 32) & 0x0101010101010101) : seed;
+    }
+    return words;
+}
+
+/// Word counts around every vector width, so that both whole vectors and remainders are covered.
+const size_t word_counts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 129};
+
+}  // namespace
+
+TEST_CASE("scalar kernels are constexpr")
+{
+    constexpr uint8_t lhs[] = {0x0F, 0xF0, 0x00};
+    constexpr uint8_t rhs[] = {0x0F, 0xFF, 0x00};
+    STATIC_CHECK(detail::scalar_kernels::popcount(lhs, 3) == 8, "Counts bits in all words");
+    STATIC_CHECK(detail::scalar_kernels::subset(lhs, rhs, 3), "Subset word by word");
+    STATIC_CHECK(!detail::scalar_kernels::subset(rhs, lhs, 3), "Not a subset in second word");
+    STATIC_CHECK(!detail::scalar_kernels::equal(lhs, rhs, 3), "Different in second word");
+    STATIC_CHECK(detail::scalar_kernels::equal(lhs, rhs, 1), "Equal in first word");
+}
+
+TEST_CASE("dispatched kernels agree with scalar kernels")
+{
+    for (size_t count : word_counts)
+    {
+        const std::vector<uint64_t> lhs = random_words(count, 0x9E3779B97F4A7C15 + count);
+        const std::vector<uint64_t> rhs = random_words(count, 0xD1B54A32D192ED03 + count);
+
+        std::vector<uint64_t> expected = lhs;
+        std::vector<uint64_t> actual = lhs;
+        detail::scalar_kernels::bitwise_or(expected.data(), rhs.data(), count);
+        detail::word_kernels::bitwise_or(actual.data(), rhs.data(), count);
+        CHECK(actual == expected);
+
+        expected = lhs;
+        actual = lhs;
+        detail::scalar_kernels::bitwise_and(expected.data(), rhs.data(), count);
+        detail::word_kernels::bitwise_and(actual.data(), rhs.data(), count);
+        CHECK(actual == expected);
+
+        expected = lhs;
+        actual = lhs;
+        detail::scalar_kernels::bitwise_xor(expected.data(), rhs.data(), count);
+        detail::word_kernels::bitwise_xor(actual.data(), rhs.data(), count);
+        CHECK(actual == expected);
+
+        expected = lhs;
+        actual = lhs;
+        detail::scalar_kernels::bitwise_and_not(expected.data(), rhs.data(), count);
+        detail::word_kernels::bitwise_and_not(actual.data(), rhs.data(), count);
+        CHECK(actual == expected);
+
+        CHECK(detail::word_kernels::popcount(lhs.data(), count)
+              == detail::scalar_kernels::popcount(lhs.data(), count));
+        CHECK(detail::word_kernels::equal(lhs.data(), rhs.data(), count)
+              == detail::scalar_kernels::equal(lhs.data(), rhs.data(), count));
+        CHECK(detail::word_kernels::equal(lhs.data(), lhs.data(), count));
+        CHECK(detail::word_kernels::subset(lhs.data(), rhs.data(), count)
+              == detail::scalar_kernels::subset(lhs.data(), rhs.data(), count));
+        CHECK(detail::word_kernels::subset(expected.data(), lhs.data(), count));
+    }
+}
+
+TEST_CASE("dispatched kernels detect a difference in any single word")
+{
+    for (size_t count : word_counts)
+    {
+        const std::vector<uint64_t> lhs = random_words(count, 0x2545F4914F6CDD1D + count);
+        for (size_t index = 0; index < count; ++index)
+        {
+            std::vector<uint64_t> rhs = lhs;
+            rhs[index] ^= uint64_t{1} << (index % 64);
+            CHECK(!detail::word_kernels::equal(lhs.data(), rhs.data(), count));
+            const bool removed = (lhs[index] & (uint64_t{1} << (index % 64))) != 0;
+            CHECK(detail::word_kernels::subset(rhs.data(), lhs.data(), count) == removed);
+        }
+    }
+}
+
+namespace
+{
+
+/// Returns the positions of the set bits in `words`, one bit at a time.
+std::vector<size_t> set_positions(std::vector<uint64_t> const& words)
+{
+    std::vector<size_t> positions;
+    for (size_t bit = 0; bit < 64 * words.size(); ++bit)
+    {
+        if ((words[bit / 64] >> (bit % 64)) & 1)
+        {
+            positions.push_back(bit);
+        }
+    }
+    return positions;
+}
+
+/// Checks that extracting into indices of type `Index` with every capacity up to the number of
+/// set bits writes the expected prefix of positions.
+template <typename Index>
+void check_extract(std::vector<uint64_t> const& words)
+{
+    const std::vector<size_t> expected = set_positions(words);
+    for (size_t capacity = 0; capacity <= expected.size(); capacity += 1 + capacity / 4)
+    {
+        std::vector<Index> output(capacity);
+        const size_t written =
+            detail::word_kernels::extract(words.data(), words.size(), output.data(), capacity);
+        CHECK(written == capacity);
+        CHECK(std::equal(output.begin(), output.end(), expected.begin()));
+    }
+    std::vector<Index> output(64 * words.size());
+    const size_t written = detail::word_kernels::extract(
+        words.data(), words.size(), output.data(), output.size());
+    CHECK(written == expected.size());
+    CHECK(std::equal(output.begin(), output.begin() + written, expected.begin()));
+}
+
+}  // namespace
+
+TEST_CASE("dispatched extraction writes the positions of all set bits")
+{
+    for (size_t count : word_counts)
+    {
+        const std::vector<uint64_t> words = random_words(count, 0x853C49E6748FEA9B + count);
+        check_extract<uint16_t>(words);
+        check_extract<uint32_t>(words);
+        check_extract<int32_t>(words);
+        check_extract<uint64_t>(words);
+    }
+}
+
+namespace
+{
+
+constexpr bool extracts_at_compile_time()
+{
+    const uint8_t words[] = {0x81, 0x00, 0x06};
+    size_t output[24]{};
+    return detail::scalar_kernels::extract(words, 3, output, 24, 100) == 4
+        && output[0] == 100 && output[1] == 107 && output[2] == 117 && output[3] == 118;
+}
+
+}  // namespace
+
+TEST_CASE("scalar extraction is constexpr")
+{
+    STATIC_CHECK(extracts_at_compile_time(), "Positions offset by 100");
+}
+
+TEST_CASE("bit mask bulk operations work across vector boundaries")
+{
+    using mask = bit_mask<1000>;
+    mask evens{};
+    mask odds{};
+    for (size_t index = 0; index < 1000; ++index)
+    {
+        (index % 2 == 0) ? evens.set(index) : odds.set(index);
+    }
+    CHECK(evens.count() == 500);
+    CHECK((evens | odds).all());
+    CHECK((evens & odds).none());
+    CHECK((evens ^ odds) == ~mask{});
+    CHECK((evens / odds) == evens);
+    CHECK(evens.is_subset_of(evens | odds));
+    CHECK(!(evens | odds).is_subset_of(evens));
+    CHECK(evens != odds);
+}